@@ -0,0 +1,132 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <vector>
+
+#include "stringview.h"
+
+namespace idogaf
+{
+/** Bump allocator
+
+    Hands out memory from large blocks by moving a cursor forward.
+    Single allocations are never freed, the whole arena is cleared or
+    destroyed at once instead, which frees only a handful of blocks.
+    Clear() keeps the blocks, so filling the arena again allocates nothing.
+    Blocks grow from the initial block size up to kMaxBlockSize.
+*/
+class Arena
+{
+public:
+    /** Default size of the first block */
+    static const size_t kDefaultBlockSize = 16 * 1024;
+    /** Maximum size of a block, larger allocations get a block of their own */
+    static const size_t kMaxBlockSize = 1024 * 1024;
+
+    /** Block size constructor
+
+        No memory is allocated until the first allocation.
+
+        @param blockSize Size of the first block in bytes.
+    */
+    Arena(size_t blockSize = kDefaultBlockSize);
+    /** Default destructor
+
+        Frees all blocks.
+    */
+    ~Arena();
+    Arena(const Arena& other) = delete;
+    Arena& operator=(const Arena& other) = delete;
+
+    //Getters
+    /** Get used size
+        @return Number of bytes allocated from the arena since it was
+        last cleared.
+    */
+    size_t      GetSize() const;
+    /** Get capacity
+        @return Total size of all blocks in bytes.
+    */
+    size_t      GetCapacity() const;
+    /** Get number of blocks
+        @return Number of blocks allocated from the system.
+    */
+    size_t      GetBlockCount() const;
+
+    //Other
+    /** Allocate memory
+
+        @param size Number of bytes to allocate.
+        @param alignment Alignment of the memory, a power of two.
+        @return Pointer to the allocated memory, valid until the arena
+        is cleared or destroyed.
+    */
+    void*       Allocate(size_t size, size_t alignment = alignof(double));
+    /** Copy string into the arena
+
+        @param str String to copy.
+        @return View of the copy.
+    */
+    StringView  Store(const StringView& str);
+    /** Append to a string stored in the arena
+
+        A string allocated last is extended in place if its block has room,
+        otherwise both parts are copied to a new place.
+
+        @param str View returned by Store() or Append(), may be empty.
+        @param more String to append.
+        @return View of the joined string.
+    */
+    StringView  Append(const StringView& str, const StringView& more);
+    /** Check if memory belongs to the arena
+        @param ptr Pointer to check.
+        @return True if ptr points into one of the blocks.
+    */
+    bool        Contains(const char* ptr) const;
+    /** Clear the arena
+
+        Invalidates everything allocated so far, but keeps the blocks
+        to be filled again.
+    */
+    void        Clear();
+    /** Free all blocks */
+    void        Release();
+    /** Swap contents with another arena
+        @param other Arena to swap with.
+    */
+    void        Swap(Arena& other);
+
+protected:
+    struct Block
+    {
+        char*   data;
+        size_t  size;
+    };
+
+    std::vector<Block>  blocks_;
+    /** Index of the block allocated from */
+    size_t      current_;
+    char*       cursor_;
+    char*       end_;
+    size_t      blockSize_;
+    /** Bytes used in blocks before the current one */
+    size_t      usedBefore_;
+
+    /** Move to a block which can hold an allocation
+
+        Tries the blocks left after Clear() first, allocates a new block
+        if none of them is large enough.
+
+        @param size Number of bytes to fit, including alignment padding.
+    */
+    void        NextBlock(size_t size);
+
+private:
+};
+}
+
+#endif // ARENA_H
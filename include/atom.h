@@ -0,0 +1,412 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef ATOM_H
+#define ATOM_H
+
+#include <stddef.h>
+
+#include "stringview.h"
+
+namespace idogaf
+{
+/** Interned name
+
+    Number standing for one of the standard html tag or attribute names,
+    so names can be compared as integers. Names which aren't in the atom
+    table get kNoAtom and have to be compared as strings.
+*/
+typedef unsigned short Atom;
+
+/** Atoms of standard html tag and attribute names, in alphabetical order */
+enum : Atom
+{
+    kNoAtom = 0,
+    kAtomA,
+    kAtomAbbr,
+    kAtomAccept,
+    kAtomAcceptCharset,
+    kAtomAccesskey,
+    kAtomAcronym,
+    kAtomAction,
+    kAtomAddress,
+    kAtomAlign,
+    kAtomAlink,
+    kAtomAllow,
+    kAtomAllowfullscreen,
+    kAtomAlt,
+    kAtomApplet,
+    kAtomArchive,
+    kAtomArea,
+    kAtomArticle,
+    kAtomAside,
+    kAtomAsync,
+    kAtomAudio,
+    kAtomAutocapitalize,
+    kAtomAutocomplete,
+    kAtomAutofocus,
+    kAtomAutoplay,
+    kAtomB,
+    kAtomBackground,
+    kAtomBase,
+    kAtomBasefont,
+    kAtomBdi,
+    kAtomBdo,
+    kAtomBgcolor,
+    kAtomBgsound,
+    kAtomBig,
+    kAtomBlink,
+    kAtomBlockquote,
+    kAtomBody,
+    kAtomBorder,
+    kAtomBr,
+    kAtomButton,
+    kAtomCanvas,
+    kAtomCaption,
+    kAtomCenter,
+    kAtomCharset,
+    kAtomChecked,
+    kAtomCite,
+    kAtomClass,
+    kAtomClassid,
+    kAtomClear,
+    kAtomCode,
+    kAtomCodebase,
+    kAtomCol,
+    kAtomColgroup,
+    kAtomColor,
+    kAtomCols,
+    kAtomColspan,
+    kAtomCommand,
+    kAtomContent,
+    kAtomContenteditable,
+    kAtomControls,
+    kAtomCoords,
+    kAtomCrossorigin,
+    kAtomData,
+    kAtomDatalist,
+    kAtomDatetime,
+    kAtomDd,
+    kAtomDeclare,
+    kAtomDecoding,
+    kAtomDefault,
+    kAtomDefer,
+    kAtomDel,
+    kAtomDetails,
+    kAtomDfn,
+    kAtomDialog,
+    kAtomDir,
+    kAtomDirname,
+    kAtomDisabled,
+    kAtomDiv,
+    kAtomDl,
+    kAtomDownload,
+    kAtomDraggable,
+    kAtomDt,
+    kAtomEm,
+    kAtomEmbed,
+    kAtomEnctype,
+    kAtomEnterkeyhint,
+    kAtomFace,
+    kAtomFieldset,
+    kAtomFigcaption,
+    kAtomFigure,
+    kAtomFont,
+    kAtomFooter,
+    kAtomFor,
+    kAtomForm,
+    kAtomFormaction,
+    kAtomFormenctype,
+    kAtomFormmethod,
+    kAtomFormnovalidate,
+    kAtomFormtarget,
+    kAtomFrame,
+    kAtomFrameborder,
+    kAtomFrameset,
+    kAtomH1,
+    kAtomH2,
+    kAtomH3,
+    kAtomH4,
+    kAtomH5,
+    kAtomH6,
+    kAtomHead,
+    kAtomHeader,
+    kAtomHeaders,
+    kAtomHeight,
+    kAtomHgroup,
+    kAtomHidden,
+    kAtomHigh,
+    kAtomHr,
+    kAtomHref,
+    kAtomHreflang,
+    kAtomHspace,
+    kAtomHtml,
+    kAtomHttpEquiv,
+    kAtomI,
+    kAtomId,
+    kAtomIframe,
+    kAtomImage,
+    kAtomImg,
+    kAtomInert,
+    kAtomInput,
+    kAtomInputmode,
+    kAtomIns,
+    kAtomIntegrity,
+    kAtomIs,
+    kAtomIsindex,
+    kAtomIsmap,
+    kAtomItemid,
+    kAtomItemprop,
+    kAtomItemref,
+    kAtomItemscope,
+    kAtomItemtype,
+    kAtomKbd,
+    kAtomKeygen,
+    kAtomKind,
+    kAtomLabel,
+    kAtomLang,
+    kAtomLanguage,
+    kAtomLegend,
+    kAtomLi,
+    kAtomLink,
+    kAtomList,
+    kAtomListing,
+    kAtomLoading,
+    kAtomLongdesc,
+    kAtomLoop,
+    kAtomLow,
+    kAtomMain,
+    kAtomMap,
+    kAtomMarginheight,
+    kAtomMarginwidth,
+    kAtomMark,
+    kAtomMarquee,
+    kAtomMath,
+    kAtomMax,
+    kAtomMaxlength,
+    kAtomMedia,
+    kAtomMenu,
+    kAtomMenuitem,
+    kAtomMeta,
+    kAtomMeter,
+    kAtomMethod,
+    kAtomMin,
+    kAtomMinlength,
+    kAtomMultiple,
+    kAtomMuted,
+    kAtomName,
+    kAtomNav,
+    kAtomNobr,
+    kAtomNoembed,
+    kAtomNoframes,
+    kAtomNomodule,
+    kAtomNonce,
+    kAtomNoscript,
+    kAtomNoshade,
+    kAtomNovalidate,
+    kAtomNowrap,
+    kAtomObject,
+    kAtomOl,
+    kAtomOnblur,
+    kAtomOnchange,
+    kAtomOnclick,
+    kAtomOnerror,
+    kAtomOnfocus,
+    kAtomOninput,
+    kAtomOnkeydown,
+    kAtomOnkeyup,
+    kAtomOnload,
+    kAtomOnmousedown,
+    kAtomOnmouseout,
+    kAtomOnmouseover,
+    kAtomOnmouseup,
+    kAtomOnsubmit,
+    kAtomOpen,
+    kAtomOptgroup,
+    kAtomOptimum,
+    kAtomOption,
+    kAtomOutput,
+    kAtomP,
+    kAtomParam,
+    kAtomPattern,
+    kAtomPicture,
+    kAtomPing,
+    kAtomPlaceholder,
+    kAtomPlaintext,
+    kAtomPlaysinline,
+    kAtomPopover,
+    kAtomPoster,
+    kAtomPre,
+    kAtomPreload,
+    kAtomProgress,
+    kAtomProperty,
+    kAtomQ,
+    kAtomRb,
+    kAtomReadonly,
+    kAtomReferrerpolicy,
+    kAtomRel,
+    kAtomRequired,
+    kAtomRev,
+    kAtomReversed,
+    kAtomRole,
+    kAtomRows,
+    kAtomRowspan,
+    kAtomRp,
+    kAtomRt,
+    kAtomRtc,
+    kAtomRuby,
+    kAtomRules,
+    kAtomS,
+    kAtomSamp,
+    kAtomSandbox,
+    kAtomScope,
+    kAtomScript,
+    kAtomScrolling,
+    kAtomSearch,
+    kAtomSection,
+    kAtomSelect,
+    kAtomSelected,
+    kAtomShape,
+    kAtomSize,
+    kAtomSizes,
+    kAtomSlot,
+    kAtomSmall,
+    kAtomSource,
+    kAtomSpacer,
+    kAtomSpan,
+    kAtomSpellcheck,
+    kAtomSrc,
+    kAtomSrcdoc,
+    kAtomSrclang,
+    kAtomSrcset,
+    kAtomStart,
+    kAtomStep,
+    kAtomStrike,
+    kAtomStrong,
+    kAtomStyle,
+    kAtomSub,
+    kAtomSummary,
+    kAtomSup,
+    kAtomSvg,
+    kAtomTabindex,
+    kAtomTable,
+    kAtomTarget,
+    kAtomTbody,
+    kAtomTd,
+    kAtomTemplate,
+    kAtomText,
+    kAtomTextarea,
+    kAtomTfoot,
+    kAtomTh,
+    kAtomThead,
+    kAtomTime,
+    kAtomTitle,
+    kAtomTr,
+    kAtomTrack,
+    kAtomTranslate,
+    kAtomTt,
+    kAtomType,
+    kAtomU,
+    kAtomUl,
+    kAtomUsemap,
+    kAtomValign,
+    kAtomValue,
+    kAtomValuetype,
+    kAtomVar,
+    kAtomVersion,
+    kAtomVideo,
+    kAtomVlink,
+    kAtomVspace,
+    kAtomWbr,
+    kAtomWidth,
+    kAtomWrap,
+    kAtomXmlns,
+    kAtomXmp,
+    kAtomCount
+};
+
+/** Properties of standard html tags, returned by AtomTable::GetProperties() */
+enum : unsigned int
+{
+    kTagElement     = 1 << 0,   ///< Name is a html tag name
+    kTagVoid        = 1 << 1,   ///< Element can't have content (<br>)
+    kTagRawText     = 1 << 2,   ///< Content is not parsed (<script>, <style>,
+                                ///< <textarea>, <title> and <xmp>)
+    kTagOptionalEnd = 1 << 3,   ///< Closing tag can be omitted, if the parent
+                                ///< has no more content
+    kTagClosesP     = 1 << 4,   ///< Start tag closes an open <p>
+    //Groups of tags closing each other
+    kTagLi          = 1 << 5,
+    kTagOptgroup    = 1 << 6,
+    kTagTr          = 1 << 7,
+    kTagDtDd        = 1 << 8,
+    kTagRuby        = 1 << 9,   ///< <rb>, <rt>, <rtc> and <rp>
+    kTagOption      = 1 << 10,
+    kTagTbody       = 1 << 11,
+    kTagTfoot       = 1 << 12,
+    kTagCell        = 1 << 13   ///< <td> and <th>
+};
+
+/** Bits of tag properties holding groups of tags closing the tag
+
+    Closing tag of an element can be omitted, if it's immediately followed
+    by an element with any of the groups in
+    (GetProperties(atom) >> kTagClosedByShift).
+*/
+const unsigned int kTagClosedByShift = 16;
+
+/** Table of standard html tag and attribute names
+
+    The table is built at compile time and never changes, so it can be
+    used from any number of threads. Names are case sensitive. Atoms are
+    numbered in alphabetical order of their names, tests/atom_test.cpp
+    checks that Find() returns every atom of the table.
+*/
+class AtomTable
+{
+public:
+    //Other
+    /** Find atom of a name
+
+        @param name Name to look up.
+        Lookup is a switch over the length and the first character of
+        the name, followed by at most a few comparisons.
+
+        @return Atom of the name or kNoAtom if it's not a standard name.
+    */
+    static Atom         Find(const StringView& name);
+    /** Get name of an atom
+
+        @param atom Atom to get name of.
+        @return View of the name or an empty view for kNoAtom and invalid
+        atoms. The view stays valid forever.
+    */
+    static StringView   GetName(Atom atom);
+    /** Get properties of an atom
+
+        @param atom Atom to get properties of.
+        @return Bitmask of kTag* properties, 0 for kNoAtom, invalid atoms
+        and attribute-only names.
+    */
+    static unsigned int GetProperties(Atom atom);
+    /** Compare names
+
+        Compares atoms, strings are compared only if both names aren't
+        standard ones.
+
+        @param atom Atom of the first name.
+        @param name First name.
+        @param otherAtom Atom of the second name.
+        @param otherName Second name.
+        @return True if both names are equal, false otherwise.
+    */
+    static bool         Equal(Atom atom, const StringView& name,
+                              Atom otherAtom, const StringView& otherName);
+
+protected:
+
+private:
+};
+}
+
+#endif // ATOM_H
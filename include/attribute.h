@@ -7,6 +7,10 @@
 #include <string>
 #include <vector>
 
+#include "arena.h"
+#include "atom.h"
+#include "stringview.h"
+
 namespace idogaf
 {
 
@@ -45,15 +49,40 @@ public:
     ~Attribute() = default;
     /** Copy constructor
 
+        Name and value kept as spans are copied into the new object,
+        so it doesn't depend on the arena or input they point into.
+
         @param other Object to copy from.
      */
     Attribute(const Attribute& other);
+    /** Arena copy constructor
+
+        Copies an attribute keeping its spans as spans, stored in a given
+        arena. Used to copy documents built in an arena.
+
+        @param other Object to copy from.
+        @param arena Arena to store the spans in.
+     */
+    Attribute(const Attribute& other, Arena& arena);
     /** Assignment operator
 
+        Like the copy constructor, spans are copied into this object.
+
         @param other Object to assign from.
         @return A reference to this.
      */
     Attribute& operator=(const Attribute& other);
+    /** Move constructor
+
+        @param other Object to move from, left empty.
+     */
+    Attribute(Attribute&& other) noexcept;
+    /** Move assignment operator
+
+        @param other Object to move from, left empty.
+        @return A reference to this.
+     */
+    Attribute& operator=(Attribute&& other) noexcept;
 
     //Getters
     /** Returns the name of the attribute
@@ -62,11 +91,63 @@ public:
         an empty string if no name has been set.
     */
     std::string GetName() const;
+    /** Returns view of the name of the attribute
+
+        @return View of the name, valid as long as the attribute
+        isn't renamed or destroyed.
+    */
+    StringView  GetNameView() const;
+    /** Returns atom of the attribute's name
+
+        @return Atom of the name or kNoAtom if it's not a standard
+        attribute name.
+    */
+    Atom        GetAtom() const;
     /** Returns the value of the attribute
 
         @return Data stored in attribute.
     */
     std::string GetValue() const;
+    /** Returns view of the value of the attribute
+
+        Unlike GetValue(), doesn't copy the value, whether it's held
+        as a string or as a span.
+
+        @return View of the value, valid as long as the attribute
+        isn't changed or destroyed.
+    */
+    StringView  GetValueView() const;
+    /** Returns the value with character references decoded
+
+        References (i.e. &amp; or &#x27;) are decoded at every call,
+        nothing is cached in the attribute, so concurrent reads of a shared
+        document are safe. Values without references (see HasReferences())
+        are only copied.
+
+        @return Decoded copy of the value of the attribute.
+    */
+    std::string GetDecodedValue() const;
+    /** Returns the value with character references decoded without copying
+
+        @param buffer Buffer for the decoded value, used only if the value
+        contains references.
+        @return View of the raw value if it has no references, otherwise
+        view of the decoded value in the buffer.
+    */
+    StringView  GetDecodedValue(std::string& buffer) const;
+    /** Check if the value contains character references
+
+        Set whenever the value is set. Parsed values are checked by the
+        tag lexer while it looks for the end of the value.
+
+        @return True if the value contains '&', false otherwise.
+    */
+    bool        HasReferences() const;
+    /** Returns view of the value set by SetValueSpan()
+        @return View of the value or an empty view if the value is held
+        as a string.
+    */
+    StringView  GetValueSpan() const;
 
     //Setters
     /** Sets the name of the attribute
@@ -74,15 +155,71 @@ public:
         @param name Name to set.
     */
     void        SetName(const std::string& name);
+    /** Sets the name of the attribute without copying it
+
+        Standard names are kept as atoms, of other names the attribute
+        keeps only a view, so the viewed memory (i.e. the arena of
+        a Document) has to outlive the attribute and its copies.
+
+        @param name View of the name to set.
+    */
+    void        SetNameSpan(const StringView& name);
     /** Sets the value of the attribute
 
         @param content Value to set.
     */
     void        SetValue(const std::string& value);
+    /** Sets the value of the attribute
+
+        @param value Value to set.
+        @param references True if the value contains '&'.
+    */
+    void        SetValue(const std::string& value, bool references);
+    /** Sets the value of the attribute without copying it
+
+        The attribute keeps only a view of the value, so the viewed memory
+        (i.e. the arena of a Document) has to outlive the attribute and its
+        copies. GetValue() still returns a copy of the value.
+
+        @param value View of the value to set.
+    */
+    void        SetValueSpan(const StringView& value);
+    /** Sets the value of the attribute without copying it
+
+        @param value View of the value to set.
+        @param references True if the value contains '&'.
+    */
+    void        SetValueSpan(const StringView& value, bool references);
+
+    //Other
+    /** Check name of the attribute
+
+        @param name Name to compare with.
+        @return True if the attribute has a given name, false otherwise.
+    */
+    bool        HasName(const std::string& name) const;
+    /** Check name of the attribute
+
+        Faster version for checking many attributes against the same name.
+
+        @param atom Atom of the name, as returned by AtomTable::Find(name).
+        @param name Name to compare with.
+        @return True if the attribute has a given name, false otherwise.
+    */
+    bool        HasName(Atom atom, const std::string& name) const;
 
 protected:
+    /** Atom of the name, kNoAtom for non-standard names */
+    Atom        atom_;
+    /** Name, set only for non-standard names */
     std::string name_;
+    /** Name kept by SetNameSpan(), replaces name_ if not empty */
+    StringView  nameSpan_;
     std::string value_;
+    /** Value kept by SetValueSpan(), replaces value_ if not empty */
+    StringView  valueSpan_;
+    /** True if the value contains '&' */
+    bool        references_;
 
 private:
 };
@@ -0,0 +1,62 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef ATTRIBUTEITERATOR_H
+#define ATTRIBUTEITERATOR_H
+
+#include <stddef.h>
+
+#include "attribute.h"
+
+namespace idogaf
+{
+
+class Element;
+
+/** Iterator over attributes of an element
+
+    Walks the attributes stored in an element in place, without copying
+    them: id, class and style first (if set), then the rest in the order
+    they were added, the same order as Element::GetAttributes() returns.
+    Use Element::AttributesBegin() and Element::AttributesEnd() to get
+    iterators. Iterators are invalidated by adding or removing attributes.
+*/
+class AttributeIterator
+{
+public:
+    /** Default constructor
+
+        Constructs an iterator which points nowhere.
+    */
+    AttributeIterator();
+    /** Position constructor
+
+        @param element Element to iterate over.
+        @param position Position to start at, moved forward to the first
+        attribute which is set.
+    */
+    AttributeIterator(const Element* element, size_t position);
+    /** Default destructor */
+    ~AttributeIterator() = default;
+
+    //Other
+    const Attribute&    operator*() const;
+    const Attribute*    operator->() const;
+    AttributeIterator&  operator++();
+    AttributeIterator   operator++(int);
+    bool                operator==(const AttributeIterator& other) const;
+    bool                operator!=(const AttributeIterator& other) const;
+
+protected:
+    const Element*  element_;
+    /** 0 - id, 1 - class, 2 - style, above - other attributes */
+    size_t          position_;
+
+    /** Skip id, class and style if they are not set */
+    void            SkipUnset();
+
+private:
+};
+}
+
+#endif // ATTRIBUTEITERATOR_H
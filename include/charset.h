@@ -0,0 +1,198 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef CHARSET_H
+#define CHARSET_H
+
+#include <stddef.h>
+#include <string>
+
+#include "stringview.h"
+
+namespace idogaf
+{
+
+/** Character encoding of a document */
+enum class Encoding : unsigned char
+{
+    kUnknown,       ///< Not known (yet)
+    kUtf8,
+    kUtf16Le,
+    kUtf16Be,
+    kWindows1252,   ///< Also used for iso-8859-1 and us-ascii, as browsers do
+    kIso8859_2,
+    kIso8859_3,
+    kIso8859_4,
+    kIso8859_5,
+    kIso8859_6,
+    kIso8859_7,
+    kIso8859_8,
+    kIso8859_10,
+    kIso8859_13,
+    kIso8859_14,
+    kIso8859_15,
+    kIso8859_16,
+    kShiftJis
+};
+
+/** Encoding detection and transcoding to UTF-8
+
+    The parser works on UTF-8 (or ASCII compatible bytes in general),
+    documents in other encodings are transcoded first. The encoding is
+    detected from a byte order mark, a hint given by the caller (i.e. from
+    an HTTP header) or a <meta charset> or <meta http-equiv> tag in the
+    first 1024 bytes, in that order, the way browsers do.
+
+    ASCII runs, which make up most of a typical document, are checked and
+    copied 16 bytes at a time (SSE2), so validating a clean UTF-8 document
+    costs a single fast pass and transcoding a mostly ASCII one little more
+    than a copy.
+*/
+class Charset
+{
+public:
+    /** Number of bytes searched for a <meta> tag declaring the encoding */
+    static const size_t kPrescanLength = 1024;
+
+    //Other
+    /** Detect encoding of a document
+
+        @param data Pointer to the first character of the document.
+        @param length Length of the document in bytes.
+        @param hint Encoding known from elsewhere, used if the document
+        doesn't start with a byte order mark.
+        @return Detected encoding, Encoding::kUnknown if neither the byte
+        order mark, the hint nor a <meta> tag gave it.
+    */
+    static Encoding     Detect(const char* data, size_t length,
+                               Encoding hint = Encoding::kUnknown);
+    /** Detect encoding from a byte order mark
+
+        @param data Pointer to the first character of the document.
+        @param length Length of the document in bytes.
+        @param bomLengthOut Output parameter, set to the length of the byte
+        order mark, 0 if there is none.
+        @return Encoding given by the byte order mark, Encoding::kUnknown
+        if there is none.
+    */
+    static Encoding     DetectBom(const char* data, size_t length,
+                                  size_t& bomLengthOut);
+    /** Detect encoding from a <meta> tag
+
+        Looks for <meta charset> or <meta http-equiv="content-type">
+        in the first kPrescanLength bytes, skipping comments and other tags.
+
+        @param data Pointer to the first character of the document.
+        @param length Length of the document in bytes.
+        @return Declared encoding, Encoding::kUnknown if there is no
+        declaration or it names an unsupported encoding.
+    */
+    static Encoding     Prescan(const char* data, size_t length);
+    /** Get encoding by its label
+
+        @param label Encoding label, i.e. "utf-8", "latin1" or "sjis",
+        letter case and surrounding whitespaces are ignored.
+        @return Encoding, Encoding::kUnknown for unsupported labels.
+    */
+    static Encoding     FromLabel(const StringView& label);
+    /** Get name of an encoding
+
+        @param encoding Encoding to name.
+        @return Canonical label of the encoding, i.e. "windows-1252".
+    */
+    static const char*  GetName(Encoding encoding);
+    /** Find first byte which is not a part of valid UTF-8
+
+        Overlong forms, surrogates and code points above U+10FFFF
+        are invalid.
+
+        @param begin Pointer to the first character of the range.
+        @param end Pointer one past the last character of the range.
+        @return Pointer to the first invalid byte, end if the whole range
+        is valid.
+    */
+    static const char*  FindInvalidUtf8(const char* begin, const char* end);
+    /** Find first non-ASCII byte
+
+        @param begin Pointer to the first character of the range.
+        @param end Pointer one past the last character of the range.
+        @return Pointer to the first byte above 0x7F, end if there is none.
+    */
+    static const char*  FindNonAscii(const char* begin, const char* end);
+    /** Find the last character boundary in a prefix of a document
+
+        Used to cut a document without splitting a multibyte character.
+
+        @param data Pointer to the first character of the document.
+        @param length Length of the prefix in bytes.
+        @param encoding Encoding of the document, Encoding::kUnknown is
+        treated as UTF-8.
+        @return Length of the longest part of the prefix which doesn't end
+        inside a character, at most 3 bytes shorter than length.
+    */
+    static size_t       FindCharacterBoundary(const char* data, size_t length,
+                                              Encoding encoding);
+    /** Transcode a document to UTF-8
+
+        Byte order marks are dropped. Invalid sequences are replaced
+        with U+FFFD.
+
+        @param data Pointer to the first character of the document.
+        @param length Length of the document in bytes.
+        @param encoding Encoding of the document, Encoding::kUnknown is
+        treated as UTF-8.
+        @param out Output parameter, replaced with the transcoded document.
+        @param dropBom Use false for parts of a document other than
+        the first one, so U+FEFF at their beginning is kept.
+    */
+    static void         ToUtf8(const char* data, size_t length,
+                               Encoding encoding, std::string& out,
+                               bool dropBom = true);
+
+protected:
+    /** Transcode UTF-8, replacing invalid sequences
+        @return Pointer one past the last written character.
+    */
+    static char*        FromUtf8(const unsigned char* begin,
+                                 const unsigned char* end, char* out);
+    /** Transcode UTF-16
+        @return Pointer one past the last written character.
+    */
+    static char*        FromUtf16(const unsigned char* begin,
+                                  const unsigned char* end,
+                                  bool bigEndian, char* out);
+    /** Transcode a single-byte encoding
+        @return Pointer one past the last written character.
+    */
+    static char*        FromSingleByte(const unsigned char* begin,
+                                       const unsigned char* end,
+                                       const unsigned short* table, char* out);
+    /** Transcode Shift_JIS
+        @return Pointer one past the last written character.
+    */
+    static char*        FromShiftJis(const unsigned char* begin,
+                                     const unsigned char* end, char* out);
+    /** Get length of a valid UTF-8 sequence
+
+        @param begin Pointer to the first byte of the sequence.
+        @param end Pointer one past the last byte of the input.
+        @param invalidLengthOut Output parameter, set to the number of
+        bytes to replace with U+FFFD if the sequence is invalid.
+        @return Length of the sequence, 0 if it's invalid.
+    */
+    static size_t       GetSequenceLength(const unsigned char* begin,
+                                          const unsigned char* end,
+                                          size_t& invalidLengthOut);
+    /** Find charset in a content attribute value
+
+        @param value Value of the content attribute of a <meta> tag,
+        i.e. "text/html; charset=utf-8".
+        @return View of the charset label, empty if there is none.
+    */
+    static StringView   FindContentCharset(const StringView& value);
+
+private:
+};
+}
+
+#endif // CHARSET_H
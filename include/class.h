@@ -24,7 +24,8 @@ public:
         given attributes value into class names
         (which should be separated by white spaces).
         Example: Attribute with value "c1 c2 c3" will result in
-        Class object with classes c1, c2, and c3.
+        Class object with classes c1, c2, and c3. The value is split
+        only when needed, a value kept as a span stays a span.
 
         @param attribute Attribute to copy name and value/classes from.
     */
@@ -40,6 +41,15 @@ public:
         @return A reference to this
      */
     Class& operator=(const Class& other);
+    /** Move constructor
+        @param other Object to move from, left empty
+     */
+    Class(Class&& other) noexcept;
+    /** Move assignment operator
+        @param other Object to move from, left empty
+        @return A reference to this
+     */
+    Class& operator=(Class&& other) noexcept;
 
     //Getters
     /** Get every class contained by this attribute in form of vector
@@ -66,10 +76,19 @@ public:
         @return True if any class contained by this attribute matches
         given name. False otherwise.
     */
-    bool Matches(const std::string& className);
+    bool Matches(const std::string& className) const;
 
 protected:
-    std::vector<std::string> classes_;
+    /** Find next class name in a value
+
+        @param cursor Pointer to the character to start at, moved past
+        the found name.
+        @param end Pointer one past the last character of the value.
+        @param classNameOut Output parameter, set to the found name.
+        @return True if a name was found, false if the value ended.
+    */
+    static bool NextClass(const char*& cursor, const char* end,
+                          StringView& classNameOut);
 
 private:
 };
@@ -0,0 +1,179 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef DECOMPRESSOR_H
+#define DECOMPRESSOR_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "mappedfile.h"
+#include "pushparser.h"
+
+namespace idogaf
+{
+
+/** Compression format of an input */
+enum class Compression
+{
+    kNone,  ///< Not compressed, passed through as it is
+    kGzip,  ///< gzip or zlib stream, requires zlib
+    kZstd   ///< Zstandard frames, requires libzstd
+};
+
+/** Streaming decompressor feeding a PushParser
+
+    Parses compressed documents without ever holding the whole decompressed
+    document in memory. Compressed input is decompressed in blocks of
+    kBlockSize bytes, each fed to a PushParser right away, so decompression
+    and tokenizing work on the same small block while it's still in cache.
+    The format is recognized by its magic bytes, uncompressed input passes
+    straight through.
+
+    Decompression is available only if the library was built with zlib
+    (gzip) or libzstd (zstd), see Supported(). Decompressing stops as soon
+    as the parser finished, i.e. after the root element was closed.
+    Decompressed documents in other encodings than UTF-8 are transcoded
+    block by block by the PushParser, see PushParser::Transcode(bool).
+*/
+class Decompressor
+{
+public:
+    /** Size of a decompressed block fed to the parser at once */
+    static const size_t kBlockSize = 64 * 1024;
+
+    /** Default constructor */
+    Decompressor();
+    /** Default destructor */
+    ~Decompressor();
+    Decompressor(const Decompressor& other) = delete;
+    Decompressor& operator=(const Decompressor& other) = delete;
+
+    //Getters
+    /** Get compression format of the current input
+        @return Format recognized by the first Feed(), Compression::kNone
+        before that.
+    */
+    Compression GetCompression() const;
+    /** Get number of decompressed bytes
+        @return Number of bytes fed to the parser since the last Reset().
+    */
+    size_t      GetDecompressedSize() const;
+    bool        Silent() const;
+
+    //Setters
+    /** Set silent mode
+
+        @see Parser::Silent(bool)
+    */
+    void        Silent(bool silent = false);
+
+    //Other
+    /** Check if a compression format is supported
+        @param compression Format to check.
+        @return True if the library was built with support of the format.
+    */
+    static bool         Supported(Compression compression);
+    /** Detect compression format by magic bytes
+
+        @param data Pointer to the first byte of the input.
+        @param length Length of the input in bytes, at least 4 bytes
+        are needed to recognize every format.
+        @return Compression format, Compression::kNone if not recognized.
+    */
+    static Compression  Detect(const char* data, size_t length);
+    /** Prepare for another input
+
+        Memory of the decompression stream and the block is kept.
+    */
+    void        Reset();
+    /** Parse compressed document from file
+
+        The file is memory-mapped and decompressed into a given parser,
+        which is finished afterwards. The parser is not reset first.
+
+        @param filename Name of the file to parse.
+        @param parser Push parser to feed.
+        @return True on success, false if the file can't be opened,
+        it's corrupted or the document turned out to be ill formed.
+    */
+    bool        Parse(const std::string& filename, PushParser& parser);
+    /** Parse compressed document from memory
+
+        @see Parse(const std::string&, PushParser&)
+
+        @param data Pointer to the first byte of the compressed document.
+        @param length Length of the compressed document in bytes.
+        @param parser Push parser to feed.
+        @return True on success, false otherwise.
+    */
+    bool        Parse(const char* data, size_t length, PushParser& parser);
+    /** Feed next part of compressed input
+
+        @param data Pointer to the first byte of the part. It has to stay
+        valid only during this call.
+        @param length Length of the part in bytes.
+        @param parser Push parser to feed with decompressed data.
+        @return False if the input is corrupted, its format is not supported
+        or the document turned out to be ill formed, true otherwise.
+    */
+    bool        Feed(const char* data, size_t length, PushParser& parser);
+    /** Finish input
+
+        Checks that the compressed input is complete and finishes the parser.
+
+        @param parser Push parser fed so far.
+        @return False if the input is corrupted or truncated or the document
+        turned out to be ill formed, true otherwise.
+    */
+    bool        Finish(PushParser& parser);
+
+protected:
+    bool        silent_;
+    bool        failed_;
+    /** True if the format is known, the first bytes were seen */
+    bool        started_;
+    /** True if the last compressed stream or frame is complete */
+    bool        streamEnd_;
+    Compression compression_;
+    size_t      decompressedSize_;
+    /** Decompression stream, z_stream or ZSTD_DStream, allocated lazily */
+    void*       gzipStream_;
+    void*       zstdStream_;
+    /** First bytes kept until the format can be recognized */
+    std::string header_;
+    std::vector<char>   block_;
+    MappedFile  file_;
+
+    /** Start decompressing in the detected format
+        @return False if the format is not supported.
+    */
+    bool        Start();
+    /** Decompress data and feed the parser
+
+        @param data Pointer to the first byte of the compressed data.
+        @param length Length of the compressed data in bytes.
+        @param parser Push parser to feed.
+        @return False on error.
+    */
+    bool        Decompress(const char* data, size_t length, PushParser& parser);
+    bool        InflateGzip(const char* data, size_t length, PushParser& parser);
+    bool        DecompressZstd(const char* data, size_t length,
+                               PushParser& parser);
+    /** Release decompression streams */
+    void        FreeStreams();
+    /** End with decompression error
+
+        Prints error message, if decompressor doesn't run in silent mode.
+
+        @param message Description of the error.
+        @return Always false.
+    */
+    bool        DecompressError(const char* message);
+
+private:
+};
+}
+
+#endif // DECOMPRESSOR_H
@@ -6,6 +6,7 @@
 
 #include <string>
 
+#include "arena.h"
 #include "element.h"
 
 namespace idogaf
@@ -16,6 +17,10 @@ public:
     /** Default constructor */
     Document();
     /** Copy constructor
+
+        Text and attribute values held in the arena of the other document
+        are copied into the arena of this one.
+
         @param other Object to copy from
      */
     Document(const Document& other);
@@ -26,6 +31,19 @@ public:
         @return A reference to this
      */
     Document& operator=(const Document& other);
+    /** Move constructor
+
+        Takes over the tree and the arena of the other document,
+        nothing is copied.
+
+        @param other Object to move from, left empty
+     */
+    Document(Document&& other) noexcept;
+    /** Move assignment operator
+        @param other Object to move from, left empty
+        @return A reference to this
+     */
+    Document& operator=(Document&& other) noexcept;
 
     //Getters
     /** Get doctype of this document
@@ -56,6 +74,16 @@ public:
         @return True if root and doctype were not set, False otherwise.
         */
     bool        Empty() const;
+    /** Get arena of this document
+
+        Parsers using an arena (see Parser::UseArena(bool)) store text
+        and attribute values of the document in it, elements keep only
+        views of them. Copies of elements own copies of their text and
+        attributes, copies of the document store them in their own arena.
+
+        @return Reference to the arena.
+    */
+    Arena&      GetArena();
 
     //Setters
     /** Set the root element of this document
@@ -65,16 +93,34 @@ public:
 
         @param root Pointer to the element to be set as root.
     */
-    void        SetRoot(Element root);
+    void        SetRoot(const Element& root);
+    /** Set the root element of this document
+
+        Moves a given element in, so its subtree is not copied.
+
+        @param root Element to be set as root.
+    */
+    void        SetRoot(Element&& root);
     /** Set doctype of this document
 
         @param doctype Doctype to set.
     */
     void        SetDoctype(std::string doctype);
 
+    //Other
+    /** Swap contents with another document
+
+        Nothing is copied, so this is the cheap way to hand a parsed
+        document over, i.e. with Parser::TakeDocument().
+
+        @param other Document to swap with.
+    */
+    void        Swap(Document& other);
+
 protected:
     Element     root_;
     std::string doctype_;
+    Arena       arena_;
 
 private:
 };
@@ -0,0 +1,124 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef DOMBUILDER_H
+#define DOMBUILDER_H
+
+#include <vector>
+
+#include "document.h"
+#include "element.h"
+#include "handler.h"
+
+namespace idogaf
+{
+/** Way of storing bodies of raw text elements (i.e. <script>) */
+enum class RawTextMode
+{
+    kCopy,  ///< Copy the body into the element text (default)
+    kSpan,  ///< Keep a view of the body in the input, see
+            ///< Element::SetTextSpan()
+    kDrop   ///< Don't store the body at all
+};
+
+/** Handler building a Document object
+
+    This is the handler used by Parser::Parse(). Comments and doctypes
+    are not stored in the tree, but each adds a newline to the text
+    of the current element.
+*/
+class DomBuilder : public Handler
+{
+public:
+    /** Document constructor
+
+        @param document Document to build. The root element is replaced
+        when the first start tag event arrives.
+    */
+    DomBuilder(Document& document);
+    /** Default destructor */
+    ~DomBuilder() = default;
+
+    //Getters
+    RawTextMode GetRawTextMode() const;
+    bool        GetReuse() const;
+    bool        GetUseArena() const;
+
+    //Setters
+    /** Set way of storing raw text element bodies
+
+        @param mode Mode to use, RawTextMode::kSpan requires the parsed
+        input to outlive the document.
+    */
+    void        SetRawTextMode(RawTextMode mode);
+    /** Reuse the tree already held by the document
+
+        Instead of replacing the root element, the builder fills elements
+        of the current tree of the document over again, keeping memory of
+        their strings and vectors. Elements which are left unused are
+        removed by the end tag events or by Finish(). Building many
+        documents into the same Document this way allocates little more
+        than the first one did.
+
+        @param value Use true to enable this option and false to disable.
+    */
+    void        SetReuse(bool value);
+    /** Build the document in its arena
+
+        Text, raw text element bodies and attribute values are copied into
+        the arena of the document (see Document::GetArena()) instead of
+        strings of their own, which saves a heap allocation for nearly
+        every element and attribute. The arena is cleared by Reset().
+
+        @param value Use true to enable this option and false to disable.
+    */
+    void        SetUseArena(bool value);
+
+    //Other
+    /** Prepare for building another document
+
+        Keeps memory of the internal stacks. When using the arena, clears
+        it and, unless reusing the tree, the root element referring to it.
+    */
+    void        Reset();
+    /** Finish building the document
+
+        Should be called after the last event when reusing the tree.
+        Removes elements left from the reused tree in elements which are
+        still open (when events ended before every element was closed) or
+        the whole tree, if no element was started at all.
+    */
+    void        Finish();
+
+    bool OnStartTag(const StringView& name, Atom atom,
+                    TagLexer& attributes) override;
+    bool OnEndTag(const StringView& name) override;
+    bool OnText(const StringView& text) override;
+    bool OnRawText(const StringView& text) override;
+    bool OnComment(const StringView& text) override;
+    bool OnDoctype(const StringView& doctype) override;
+
+protected:
+    Document*               document_;
+    Element*                current_;
+    std::vector<Element*>   stack_;
+    /** Number of children built so far, for each element of stack_
+        and the current element */
+    std::vector<unsigned int>   built_;
+    RawTextMode             rawTextMode_;
+    bool                    reuse_;
+    bool                    useArena_;
+    /** True if the root element was started */
+    bool                    started_;
+
+    /** Add text to the current element
+        @param text Text to add.
+        @param references True if the text contains '&'.
+    */
+    void                    AddText(const StringView& text, bool references);
+
+private:
+};
+}
+
+#endif // DOMBUILDER_H
@@ -8,9 +8,13 @@
 #include <string>
 #include <vector>
 
+#include "arena.h"
+#include "atom.h"
 #include "attribute.h"
+#include "attributeiterator.h"
 #include "class.h"
 #include "id.h"
+#include "stringview.h"
 #include "style.h"
 
 namespace idogaf
@@ -87,20 +91,55 @@ public:
 
         Creates a copy of a given element including copies of the children
         elements, but not the parent element (this copy will have no parent).
+        Text and attributes kept as spans (see Parser::UseArena(bool) and
+        RawTextMode::kSpan) are copied as well, so the copy stays valid
+        after the document it was taken from is gone.
 
         @param other Object to copy from
      */
     Element(const Element& other);
+    /** Arena copy constructor
+
+        Copies an element like the copy constructor, but keeps spans
+        of the element and its descendants as spans, stored in a given
+        arena. Used to copy documents built in an arena.
+
+        @param other Object to copy from
+        @param arena Arena to store the spans in
+     */
+    Element(const Element& other, Arena& arena);
     /** Assignment operator
 
         Copies values of given elements member variables including copies of
         the children elements, but not the parent element
-        (this will have no parent).
+        (this will have no parent). Spans are copied like in the copy
+        constructor.
 
         @param other Object to assign from
         @return A reference to this
      */
     Element& operator=(const Element& other);
+    /** Move constructor
+
+        Takes over the children of a given element without copying them,
+        they only get pointers to their new parent. Like the copy, this
+        element has no parent, so children vectors move their elements
+        when they grow instead of copying whole subtrees and the parent
+        adopts them again. The moved-from element is left empty.
+
+        @param other Object to move from
+     */
+    Element(Element&& other) noexcept;
+    /** Move assignment operator
+
+        Takes over everything but the parent pointer, so this element
+        stays where it is in its tree. Children are not copied, they only
+        get pointers to this element as their parent.
+
+        @param other Object to move from, left empty
+        @return A reference to this
+     */
+    Element& operator=(Element&& other) noexcept;
     /** Default destructor */
     ~Element() = default;
 
@@ -121,11 +160,79 @@ public:
         or an empty string if name has not been set.
     */
     std::string GetName() const;
+    /** Get view of tag name of this element
+        @return View of the tag name, valid as long as the element
+        isn't renamed or destroyed.
+    */
+    StringView  GetNameView() const;
+    /** Get atom of this elements tag name
+        @return Atom of the tag name or kNoAtom if the name is not
+        a standard html tag name.
+    */
+    Atom        GetAtom() const;
     /** Get text contained by this element.
         @return Text contained by this element
         or an empty string if the text has not been set.
     */
     std::string GetText() const;
+    /** Get view of text contained by this element
+
+        Unlike GetText(), doesn't copy the text, whether it's held
+        in a string or as a span.
+
+        @return View of the text, valid as long as the text
+        isn't changed or the element destroyed.
+    */
+    StringView  GetTextView() const;
+    /** Get text with character references decoded
+
+        References (i.e. &amp; or &#169;) are decoded at every call,
+        nothing is cached in the element, so concurrent reads of a shared
+        document are safe. Text without references (see HasReferences())
+        is only copied.
+
+        @return Decoded copy of the text contained by this element.
+    */
+    std::string GetDecodedText() const;
+    /** Get text with character references decoded without copying
+
+        @param buffer Buffer for the decoded text, used only if the text
+        contains references.
+        @return View of the raw text if it has no references, otherwise
+        view of the decoded text in the buffer.
+    */
+    StringView  GetDecodedText(std::string& buffer) const;
+    /** Check if text contains character references
+
+        Set whenever the text is set. Parsed text is checked by the
+        tokenizer while it looks for the end of the text.
+
+        @return True if the text contains '&', false otherwise.
+    */
+    bool        HasReferences() const;
+    /** Get text span of this element
+
+        @return View of the text set by SetTextSpan(), or an empty view
+        if the text is held in a string.
+    */
+    StringView  GetTextSpan() const;
+    /** Get beginning of this element in the source
+        @return Offset of the '<' starting the opening tag from the beginning
+        of the parsed document, 0 if the element was not parsed.
+    */
+    size_t      GetSourceBegin() const;
+    /** Get end of the opening tag of this element in the source
+        @return Offset one past the '>' ending the opening tag.
+    */
+    size_t      GetOpenTagEnd() const;
+    /** Get end of this element in the source
+
+        Use LineIndex to turn offsets into lines and columns.
+
+        @return Offset one past the '>' ending the closing tag. If the
+        closing tag was omitted, offset of whatever made it implied.
+    */
+    size_t      GetSourceEnd() const;
     /** Get pointer to the parent of this element
         @return A pointer to the parent
         or nullptr if the parent has not been set.
@@ -136,25 +243,27 @@ public:
         Get Class object of this element. If class for this element
         has not been set, returns an empty Class object (with no value).
 
-        @return Class object matching this elements css class.
+        @return Reference to the Class object matching this elements
+        css class.
     */
-    Class       GetClass() const;
+    const Class&    GetClass() const;
     /** Get 'id' attribute of this element
 
         Get Id object of this element. If id for this element
         has not been set, returns an empty Id object (with no value).
 
-        @return Id object matching this elements id.
+        @return Reference to the Id object matching this elements id.
     */
-    Id          GetId() const;
+    const Id&   GetId() const;
     /** Get 'style' attribute of this element
 
         Get Style object of this element. If style for this element
         has not been set, returns an empty Style object (with no value).
 
-        @return Style object matching this elements css style.
+        @return Reference to the Style object matching this elements
+        css style.
     */
-    Style       GetStyle() const;
+    const Style&    GetStyle() const;
     /** Get children of this element
         @return Vector containing copies of all children of this element
         or an empty vector if this element has no children.
@@ -292,12 +401,55 @@ public:
         has no attributes.
     */
     Vector_A    GetAttributes() const;
+    /** Get number of attributes of this element
+        @return Number of attributes (class, id and style included).
+    */
+    size_t      GetAttributeCount() const;
+    /** Get iterator to the first attribute of this element
+
+        Walks the attributes in place, without copying them, in the order
+        of GetAttributes().
+
+        @return Iterator to the first attribute.
+    */
+    AttributeIterator   AttributesBegin() const;
+    /** Get iterator past the last attribute of this element
+        @return Iterator past the last attribute.
+    */
+    AttributeIterator   AttributesEnd() const;
     /** Get this elements attribute by name
         @return An Attribute object containing attribute matching
         given name or an empty attribute if a matching attribute
         has not been found.
     */
     Attribute   GetAttributeByName(const std::string& name);
+    /** Get pointer to this elements attribute by name
+
+        @param name Name of the attribute.
+        @return Pointer to the attribute matching given name, nullptr if
+        a matching attribute has not been found. Valid until attributes
+        of this element change.
+    */
+    const Attribute*    GetAttributePtrByName(const std::string& name) const;
+    /** Get pointer to this elements attribute by name
+
+        Faster version for looking up the same name in many elements.
+
+        @param atom Atom of the name, as returned by AtomTable::Find(name).
+        @param name Name of the attribute.
+        @return Pointer to the attribute or nullptr.
+    */
+    const Attribute*    GetAttributePtrByName(Atom atom,
+                                              const std::string& name) const;
+    /** Get position of this element among its siblings
+
+        Every element knows its position in the children vector of its
+        parent, so moving between siblings takes constant time.
+
+        @return Zero-based position in the parent's children vector,
+        0 if this element has no parent.
+    */
+    unsigned int    GetPosition() const;
     /** Check if this element has brother on the right
         @return True if it has right brother, false otherwise.
     */
@@ -308,6 +460,16 @@ public:
         brother on the right side.
     */
     Element*    GetRightBrotherPtr();
+    /** Check if this element has brother on the left
+        @return True if it has left brother, false otherwise.
+    */
+    bool        HasLeftBrother() const;
+    /** Get this elements left brother
+
+        @return Pointer to it's left brother or nullptr if it has no
+        brother on the left side.
+    */
+    Element*    GetLeftBrotherPtr();
 
     //Setters
 
@@ -315,10 +477,18 @@ public:
         @param name New name for this element.
     */
     void        SetName(const std::string& name);
+    /** Set this elements name
+        @param atom Atom of the new name.
+    */
+    void        SetName(Atom atom);
     /** Set text contained by this element
         @param text Text to set.
     */
     void        SetText(const std::string& text);
+    /** Set text contained by this element
+        @param text Text to move in.
+    */
+    void        SetText(std::string&& text);
     /** Add text contained by this element
 
         Adds new text at the end of already existing text.
@@ -326,6 +496,35 @@ public:
         @param text Text to add.
     */
     void        AddText(const std::string& text);
+    /** Add text contained by this element
+
+        @param text Text to add.
+        @param references True if the text contains '&'.
+    */
+    void        AddText(const std::string& text, bool references);
+    /** Set text contained by this element without copying it
+
+        The element keeps only a view of the text, so the viewed memory
+        (i.e. the parsed input) has to outlive the element. Copies of the
+        element and GetText() still copy the text. Setting or adding text
+        later turns the span into a string.
+
+        @param text View of the text to set.
+    */
+    void        SetTextSpan(const StringView& text);
+    /** Set text contained by this element without copying it
+
+        @param text View of the text to set.
+        @param references True if the text contains '&'.
+    */
+    void        SetTextSpan(const StringView& text, bool references);
+    /** Set source range of this element
+
+        @param begin Offset of the '<' starting the opening tag.
+        @param openTagEnd Offset one past the '>' ending the opening tag.
+        @param end Offset one past the '>' ending the closing tag.
+    */
+    void        SetSourceRange(size_t begin, size_t openTagEnd, size_t end);
     /** Set new css class attribute for this element
         @param newClass Class attribute to set.
     */
@@ -353,6 +552,14 @@ public:
         Indexing is zero-based.
     */
     void        RemoveChildAt(unsigned int position);
+    /** Remove children from a given position to the end
+
+        If given position is greater or equal to the number of children
+        nothing happens.
+
+        @param position Position of the first child to remove.
+    */
+    void        RemoveChildrenFrom(unsigned int position);
     /** Add child element to this element
 
         Adds child at the end of this elements children vector.
@@ -360,7 +567,14 @@ public:
 
         @param child Child element to add.
     */
-    void        AddChild(Element child);
+    void        AddChild(const Element& child);
+    /** Add child element to this element
+
+        Moves the child in, so its subtree is not copied.
+
+        @param child Child element to add.
+    */
+    void        AddChild(Element&& child);
     /** Add child to this element at a given position
 
         Adds child before an element at a given position in this
@@ -374,7 +588,15 @@ public:
         vector. This corresponds with top to bottom order in html code.
         Indexing is zero-based.
     */
-    void        AddChildAt(Element child, unsigned int position);
+    void        AddChildAt(const Element& child, unsigned int position);
+    /** Add child to this element at a given position
+
+        @see AddChildAt(const Element&, unsigned int)
+
+        @param child Child element to move in.
+        @param position Position to add a child at.
+    */
+    void        AddChildAt(Element&& child, unsigned int position);
     /** Add children from a given vector
 
         Adds children from a given vector to the end of this elements
@@ -383,7 +605,15 @@ public:
 
         @param children Vector of the Element objects to add as children.
     */
-    void        AddChildren(Vector_E children);
+    void        AddChildren(const Vector_E& children);
+    /** Add children from a given vector
+
+        Moves the children in, so their subtrees are not copied.
+
+        @param children Vector of the Element objects to move in,
+        left with moved-from elements.
+    */
+    void        AddChildren(Vector_E&& children);
 
     /** Remove all attributes from this element */
     void        RemoveAttributes();
@@ -400,9 +630,48 @@ public:
 
         @param attribute Attribute to add
     */
-    void        AddAtrribute(Attribute attribute);
+    void        AddAtrribute(const Attribute& attribute);
+    /** Add an attribute to this element
+
+        @see AddAtrribute(const Attribute&)
+
+        @param attribute Attribute to move in.
+    */
+    void        AddAtrribute(Attribute&& attribute);
 
     //Other
+    /** Check tag name of this element
+
+        @param name Name to compare with.
+        @return True if this element has a given tag name, false otherwise.
+    */
+    bool        HasName(const std::string& name) const;
+    /** Check tag name of this element
+
+        Faster version for checking many elements against the same name.
+
+        @param atom Atom of the name, as returned by AtomTable::Find(name).
+        @param name Name to compare with.
+        @return True if this element has a given tag name, false otherwise.
+    */
+    bool        HasName(Atom atom, const std::string& name) const;
+    /** Swap contents with another element
+
+        Swaps everything but the parent pointers, so both elements stay
+        where they are in their trees. Children are not copied, they only
+        get pointers to their new parents.
+
+        @param other Element to swap with.
+    */
+    void        Swap(Element& other);
+    /** Prepare this element for reuse
+
+        Clears name, text, attributes and source range, but keeps memory
+        of the strings and vectors holding them, so filling the element
+        again allocates little or nothing. Children are kept to be reused
+        the same way, remove the ones left unused with RemoveChildrenFrom().
+    */
+    void        Recycle();
     /** Find elements in a tree starting from this element.
 
         This function uses CSS selectors to search for elements
@@ -428,9 +697,6 @@ public:
         execution the tree is modified (possibly resulting in the
         invalidation of some pointers), the result of the function is
         undefined and possibility of a segmentation fault exists.
-        Warning: Currently this will also search in this elements right
-        siblings and it's ancestors right siblings and their children.
-        Use Find() for stable results.
 
         @param query CSS selector query.
         @return Vector containg pointers to the elements matching given query.
@@ -439,10 +705,25 @@ public:
 
 
 protected:
+    friend class AttributeIterator;
+
+    /** Atom of the tag name, kNoAtom for non-standard names */
+    Atom        atom_;
+    /** Tag name, set only for non-standard names */
     std::string name_;
     std::string text_;
+    /** Text kept by SetTextSpan(), replaces text_ if not empty */
+    StringView  textSpan_;
+    /** True if the text contains '&' */
+    bool        textReferences_;
+    /** Byte offsets in the parsed document */
+    size_t      sourceBegin_;
+    size_t      openTagEnd_;
+    size_t      sourceEnd_;
     Vector_E    children_;
     Element*    parent_;
+    /** Position in the children vector of the parent */
+    unsigned int    position_;
     Vector_A    attributes_;
     Class       class_;
     Id          id_;
@@ -451,16 +732,29 @@ protected:
     /** Initializes member variables and sets them to default values
 
         Default values for variables:
+        atom_       -   kNoAtom
         name_       -   empty string
         text_       -   empty string
+        textSpan_   -   empty view
+        textReferences_ -   false
+        sourceBegin_, openTagEnd_, sourceEnd_ - 0
         children_   -   empty vector
         parent_     -   nullptr
+        position_   -   0
         attributes_ -   empty vector
         class_      -   empty class
         id_         -   empty id
         style_      -   empty style
     */
     void        SetDefaultValues();
+    /** Give children their parent pointer and position
+
+        Called whenever children are added, removed or moved between
+        vectors, so brother lookups stay valid.
+
+        @param from Position of the first child to update.
+    */
+    void        AdoptChildren(size_t from = 0);
 };
 }
 
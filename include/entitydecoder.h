@@ -0,0 +1,94 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef ENTITYDECODER_H
+#define ENTITYDECODER_H
+
+#include <stddef.h>
+#include <string>
+
+namespace idogaf
+{
+
+/** Html character reference decoder
+
+    Decodes numeric (&#39; and &#x27;) and named (&amp;) character
+    references into UTF-8. All 2125 html5 named references are supported,
+    including the legacy ones allowed without the trailing semicolon.
+    Text between references is copied in whole runs, found with memchr.
+*/
+class EntityDecoder
+{
+public:
+    //Other
+    /** Check if text contains references
+
+        @param text Text to check.
+        @return True if the text contains the '&' character, false otherwise.
+    */
+    static bool         HasReferences(const std::string& text);
+    /** Check if text contains references
+
+        @param begin Pointer to the first character of the text.
+        @param end Pointer one past the last character of the text.
+        @return True if the text contains the '&' character, false otherwise.
+    */
+    static bool         HasReferences(const char* begin, const char* end);
+    /** Decode references
+
+        @param begin Pointer to the first character of the text.
+        @param end Pointer one past the last character of the text.
+        @param out Output parameter, decoded text is appended to it.
+        @param attribute Use true for attribute values. Legacy references
+        without semicolon followed by '=' or an alphanumeric character
+        are not decoded inside attribute values.
+    */
+    static void         Decode(const char* begin, const char* end,
+                               std::string& out, bool attribute = false);
+    /** Decode references
+
+        @param text Text to decode.
+        @param attribute Use true for attribute values.
+        @return Decoded text.
+    */
+    static std::string  Decode(const std::string& text, bool attribute = false);
+
+protected:
+    /** Decode a single reference
+
+        @param begin Pointer to the '&' character.
+        @param end Pointer one past the last character of the text.
+        @param out Output parameter, decoded character or '&' is appended
+        to it.
+        @param attribute True for attribute values.
+        @return Pointer to the first character after the reference.
+    */
+    static const char*  DecodeReference(const char* begin, const char* end,
+                                        std::string& out, bool attribute);
+    /** Find named reference
+
+        @param name Pointer to the first character of the name.
+        @param length Length of the name, without '&' and ';'.
+        @param legacyOnly Use true to find only references allowed
+        without semicolon.
+        @param codePointsOut Output parameter, set to the one or two
+        code points of the reference (second is 0 if there is one).
+        @return True if the reference was found, false otherwise.
+    */
+    static bool         FindNamed(const char* name, size_t length,
+                                  bool legacyOnly, unsigned int* codePointsOut);
+    /** Append code point encoded in UTF-8
+
+        Invalid code points are replaced with U+FFFD and C1 controls with
+        their windows-1252 characters, as browsers do.
+
+        @param codePoint Code point to append.
+        @param out Output parameter, string to append to.
+    */
+    static void         AppendCodePoint(unsigned int codePoint, std::string& out);
+
+private:
+};
+}
+
+#endif // ENTITYDECODER_H
@@ -0,0 +1,69 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef FLATBUILDER_H
+#define FLATBUILDER_H
+
+#include <vector>
+
+#include "dombuilder.h"
+#include "flatdocument.h"
+#include "handler.h"
+
+namespace idogaf
+{
+/** Handler building a FlatDocument object
+
+    The counterpart of DomBuilder for FlatDocument, used by
+    Parser::Parse(const char*, size_t, FlatDocument&). Comments and doctypes
+    are not stored, but each adds a newline to the text of the current
+    element, same as in a Document.
+*/
+class FlatBuilder : public Handler
+{
+public:
+    /** Document constructor
+
+        @param document Document to build, elements are appended to it.
+    */
+    FlatBuilder(FlatDocument& document);
+    /** Default destructor */
+    ~FlatBuilder() = default;
+
+    //Getters
+    RawTextMode GetRawTextMode() const;
+
+    //Setters
+    /** Set way of storing raw text element bodies
+
+        @param mode Mode to use, RawTextMode::kSpan requires the parsed
+        input to outlive the document.
+    */
+    void        SetRawTextMode(RawTextMode mode);
+
+    //Other
+    /** Prepare for building another document
+
+        Clears the document, keeping its memory.
+    */
+    void        Reset();
+
+    bool OnStartTag(const StringView& name, Atom atom,
+                    TagLexer& attributes) override;
+    bool OnEndTag(const StringView& name) override;
+    bool OnText(const StringView& text) override;
+    bool OnRawText(const StringView& text) override;
+    bool OnComment(const StringView& text) override;
+    bool OnDoctype(const StringView& doctype) override;
+
+protected:
+    FlatDocument*               document_;
+    /** Indices of the open elements, the current one last */
+    std::vector<unsigned int>   stack_;
+    RawTextMode                 rawTextMode_;
+
+private:
+};
+}
+
+#endif // FLATBUILDER_H
@@ -0,0 +1,384 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef FLATDOCUMENT_H
+#define FLATDOCUMENT_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "arena.h"
+#include "atom.h"
+#include "attribute.h"
+#include "class.h"
+#include "id.h"
+#include "search.h"
+#include "stringview.h"
+
+namespace idogaf
+{
+
+class FlatDocument;
+class FlatElement;
+
+typedef std::vector<FlatElement>    Vector_F;
+
+/** Handle of an element of a FlatDocument
+
+    A document index and a pointer, cheap to copy and pass by value.
+    Offers the reading part of the Element interface. A handle is valid
+    as long as the document isn't cleared, parsed into again or destroyed.
+*/
+class FlatElement
+{
+public:
+    /** Default constructor
+
+        Constructs an invalid handle.
+    */
+    FlatElement();
+    /** Index constructor
+
+        @param document Document holding the element.
+        @param index Index of the element in the document.
+    */
+    FlatElement(const FlatDocument* document, unsigned int index);
+    /** Default destructor */
+    ~FlatElement() = default;
+
+    //Getters
+    /** Check if the handle refers to an element
+        @return True if the handle refers to an element, false if it's
+        the result of asking for a missing parent, child or brother.
+    */
+    bool        Valid() const;
+    /** Get index of the element
+        @return Index of the element in preorder.
+    */
+    unsigned int    GetIndex() const;
+    std::string GetName() const;
+    /** Get view of the tag name
+        @return View of the tag name, valid as long as the document.
+    */
+    StringView  GetNameView() const;
+    Atom        GetAtom() const;
+    std::string GetText() const;
+    /** Get text with character references decoded
+        @return Decoded copy of the text.
+    */
+    std::string GetDecodedText() const;
+    /** Get text with character references decoded without copying
+
+        @param buffer Buffer for the decoded text, used only if the text
+        contains references.
+        @return View of the raw text if it has no references, otherwise
+        view of the decoded text in the buffer.
+    */
+    StringView  GetDecodedText(std::string& buffer) const;
+    /** Check if the text contains character references
+        @return True if the text contains '&', false otherwise.
+    */
+    bool        HasReferences() const;
+    /** Get view of the text
+        @return View of the text, valid as long as the document.
+    */
+    StringView  GetTextSpan() const;
+    size_t      GetSourceBegin() const;
+    size_t      GetOpenTagEnd() const;
+    size_t      GetSourceEnd() const;
+    /** Get parent of the element
+        @return Handle of the parent, invalid for the root element.
+    */
+    FlatElement GetParent() const;
+    FlatElement GetFirstChild() const;
+    FlatElement GetLastChild() const;
+    /** Get child at a position
+        @param position Position of the child, walks position siblings.
+        @return Handle of the child, invalid if there are not that many.
+    */
+    FlatElement GetChildAt(unsigned int position) const;
+    /** Get number of children
+        @return Number of children, counted by walking them.
+    */
+    size_t      GetChildrenCount() const;
+    Vector_F    GetChildren() const;
+    bool        HasRightBrother() const;
+    /** Get right brother of the element
+        @return Handle of the next sibling, invalid if there is none.
+    */
+    FlatElement GetRightBrother() const;
+    /** Get number of attributes
+        @return Number of attributes, including class, id and style.
+    */
+    size_t      GetAttributeCount() const;
+    /** Get name of an attribute
+        @param position Position of the attribute, below GetAttributeCount().
+        @return View of the name.
+    */
+    StringView  GetAttributeName(size_t position) const;
+    /** Get value of an attribute
+        @param position Position of the attribute, below GetAttributeCount().
+        @return View of the value.
+    */
+    StringView  GetAttributeValue(size_t position) const;
+    /** Get value of an attribute by its name
+        @param name Name of the attribute.
+        @return View of the value, empty if there is no such attribute.
+    */
+    StringView  GetAttributeValue(const std::string& name) const;
+    /** Get all attributes of the element
+        @return Copies of the attributes, in the order they were written.
+    */
+    Vector_A    GetAttributes() const;
+    /** Get attribute by its name
+        @param name Name of the attribute.
+        @return Copy of the attribute, empty if there is no such attribute.
+    */
+    Attribute   GetAttributeByName(const std::string& name) const;
+    Class       GetClass() const;
+    Id          GetId() const;
+
+    //Other
+    bool        HasName(const std::string& name) const;
+    /** Find elements in the subtree of this element
+
+        @see FlatDocument::Find()
+
+        @param query CSS selector query.
+        @return Matching elements in document order, this one included.
+    */
+    Vector_F    Find(const std::string& query) const;
+    bool        operator==(const FlatElement& other) const;
+    bool        operator!=(const FlatElement& other) const;
+
+protected:
+    const FlatDocument* document_;
+    unsigned int        index_;
+
+private:
+};
+
+/** Read-optimized document
+
+    An alternative to Document, holding elements in parallel arrays
+    in preorder (struct of arrays) instead of a tree of Element objects.
+    Each element takes a few dozen bytes: its name atom, indices of its
+    parent, first child and next sibling, a range of attributes and views
+    of its name and text. Names, attribute values and text live in the
+    document's arena. Walking the tree, searching it and writing it out
+    read the arrays front to back, which keeps the caches warm even on
+    documents with hundreds of thousands of elements. Tearing a document
+    down frees just the arrays and arena blocks.
+
+    Use FlatElement handles to read elements and FlatBuilder (i.e. through
+    Parser::Parse(const char*, size_t, FlatDocument&)) to build documents.
+    Clear() keeps the memory, so building many documents into the same
+    object allocates almost nothing after the first one.
+*/
+class FlatDocument
+{
+public:
+    /** Index of a missing element */
+    static const unsigned int kNoNode = 0xFFFFFFFFu;
+
+    /** Default constructor */
+    FlatDocument();
+    /** Default destructor */
+    ~FlatDocument() = default;
+    FlatDocument(const FlatDocument& other) = delete;
+    FlatDocument& operator=(const FlatDocument& other) = delete;
+
+    //Getters
+    /** Get number of elements
+        @return Number of elements in the document.
+    */
+    size_t      GetSize() const;
+    /** Check if document is empty
+        @return True if there are no elements and no doctype.
+    */
+    bool        Empty() const;
+    /** Get the root element
+        @return Handle of the first element, invalid if there is none.
+    */
+    FlatElement GetRoot() const;
+    /** Get element by its index
+        @param index Index in preorder, below GetSize().
+        @return Handle of the element.
+    */
+    FlatElement GetElement(unsigned int index) const;
+    const std::string&  GetDoctype() const;
+    Arena&      GetArena();
+
+    //Setters
+    void        SetDoctype(const std::string& doctype);
+
+    //Other
+    /** Remove everything
+
+        Keeps memory of the arrays and the arena.
+    */
+    void        Clear();
+    /** Add element
+
+        Adds an element as the last child of a given parent. Elements have
+        to be added in preorder, so the parent must be the last added
+        element or one of its ancestors.
+
+        @param parent Index of the parent or kNoNode for a top-level element.
+        @param atom Atom of the name.
+        @param name Name, copied into the arena unless it's a standard name.
+        @return Index of the added element.
+    */
+    unsigned int    AddElement(unsigned int parent, Atom atom,
+                               const StringView& name);
+    /** Add attribute to the last added element
+
+        An attribute with the same name replaces the earlier one.
+
+        @param name Name of the attribute, copied into the arena unless
+        it's a standard name.
+        @param value Value of the attribute, copied into the arena.
+    */
+    void        AddAttribute(const StringView& name, const StringView& value);
+    /** Add text to an element
+
+        @param index Index of the element.
+        @param text Text to add, copied into the arena.
+    */
+    void        AddText(unsigned int index, const StringView& text);
+    /** Add text to an element
+
+        @param index Index of the element.
+        @param text Text to add, copied into the arena.
+        @param references True if the text contains '&'.
+    */
+    void        AddText(unsigned int index, const StringView& text,
+                        bool references);
+    /** Set text of an element without copying it
+
+        @param index Index of the element.
+        @param text View of the text, has to outlive the document.
+    */
+    void        SetTextSpan(unsigned int index, const StringView& text);
+    /** Set text of an element without copying it
+
+        @param index Index of the element.
+        @param text View of the text, has to outlive the document.
+        @param references True if the text contains '&'.
+    */
+    void        SetTextSpan(unsigned int index, const StringView& text,
+                            bool references);
+    /** Set source range of an element
+
+        @see Element::SetSourceRange()
+    */
+    void        SetSourceRange(unsigned int index, size_t begin,
+                               size_t openTagEnd, size_t end);
+    /** Find elements
+
+        Parses the query like Element::Find() and finds the same elements:
+        type, class, id, attribute selectors and the descendant, child (>),
+        adjacent (+) and sibling (~) combinators, in comma-separated lists.
+        Its quirks are kept too: "a ~ b" finds b elements preceding an a
+        element and '*' stands for any class, id, attribute name or value
+        (".*", "#*", "[*=value]", "[name=*]"), but not for any tag name.
+        Selectors are matched right to left against every element in turn.
+
+        @param query CSS selector query.
+        @return Matching elements in document order, without duplicates.
+    */
+    Vector_F    Find(const std::string& query) const;
+    /** Write the document to stream
+
+        Writes the same output as Parser::WriteToStream() for the same
+        document, straight from the arrays.
+
+        @param stream Output stream to write to.
+        @return True on success, false if the document is empty.
+    */
+    bool        WriteToStream(std::ostream& stream) const;
+
+protected:
+    friend class FlatElement;
+
+    std::vector<Atom>           atoms_;
+    std::vector<StringView>     names_;
+    std::vector<unsigned int>   parents_;
+    std::vector<unsigned int>   firstChildren_;
+    /** Last child of each element, used while adding elements */
+    std::vector<unsigned int>   lastChildren_;
+    std::vector<unsigned int>   nextSiblings_;
+    /** Index of the first attribute of each element, the attributes
+        of an element end where the ones of the next element begin */
+    std::vector<unsigned int>   attributeBegins_;
+    std::vector<StringView>     texts_;
+    /** True for texts containing '&' */
+    std::vector<bool>           textReferences_;
+    std::vector<size_t>         sourceBegins_;
+    std::vector<size_t>         openTagEnds_;
+    std::vector<size_t>         sourceEnds_;
+    std::vector<Atom>           attributeAtoms_;
+    std::vector<StringView>     attributeNames_;
+    std::vector<StringView>     attributeValues_;
+    std::string                 doctype_;
+    Arena                       arena_;
+
+    /** Get end of the attributes of an element */
+    unsigned int    GetAttributeEnd(unsigned int index) const;
+    /** Get end of the subtree of an element
+        @return Index one past the last descendant of the element.
+    */
+    unsigned int    GetSubtreeEnd(unsigned int index) const;
+    /** Find elements in a range of indices
+        @param query CSS selector query.
+        @param begin Index of the first element, the root of the scope.
+        @param end Index one past the last element of the scope.
+    */
+    Vector_F    Find(const std::string& query, unsigned int begin,
+                     unsigned int end) const;
+    /** Write opening tag of an element to stream
+
+        @see Parser::WriteOpeningTag()
+    */
+    void        WriteOpeningTag(unsigned int index, std::ostream& stream,
+                                unsigned int indent) const;
+    /** Write closing tag of an element to stream */
+    void        WriteClosingTag(unsigned int index, std::ostream& stream,
+                                unsigned int indent) const;
+    /** Get value of a class, id or style attribute
+        @return View of the value, empty if there is no such attribute.
+    */
+    StringView  GetAttributeValue(unsigned int index, Atom atom) const;
+    /** Check element against a simple selector, like Search does */
+    bool        CheckSelector(const Search::Selector& selector,
+                              unsigned int index) const;
+    /** Check if element passes a step of a complex selector, right to left
+
+        @param complex Complex selector.
+        @param position Position of the step to check the element with.
+        @param index Index of the element.
+        @param scope Index of the root of the searched subtree.
+        @param scopeEnd Index one past the last element of the subtree.
+        @return True if the element is among the elements selected by
+        the steps up to position, before the separator of the step.
+    */
+    bool        MatchesStep(const Search::Complex& complex, size_t position,
+                            unsigned int index, unsigned int scope,
+                            unsigned int scopeEnd) const;
+    /** Check if element is reached by the separator of a step
+
+        @see MatchesStep()
+
+        @return True if the element is among the elements selected by
+        the steps up to position, after the separator of the step.
+    */
+    bool        IsReached(const Search::Complex& complex, size_t position,
+                          unsigned int index, unsigned int scope,
+                          unsigned int scopeEnd) const;
+
+private:
+};
+}
+
+#endif // FLATDOCUMENT_H
@@ -0,0 +1,132 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef HANDLER_H
+#define HANDLER_H
+
+#include <stddef.h>
+
+#include "atom.h"
+#include "stringview.h"
+#include "taglexer.h"
+
+namespace idogaf
+{
+/** Receiver of parsing events
+
+    Derive from this class and pass it to Parser::ParseEvents() to process
+    a document without building a Document object. Events follow the same
+    rules as the Document builder, so an end tag event is sent for every
+    start tag event, including elements which closing tags were omitted
+    and empty elements. Text before the root element and after it is not
+    reported. Every view passed to a handler is valid only during the call.
+    Default implementations ignore the event. Byte offsets of the source
+    of the current event are available through GetSourceBegin() and
+    GetSourceEnd().
+*/
+class Handler
+{
+public:
+    /** Default constructor */
+    Handler() = default;
+    /** Default destructor */
+    virtual ~Handler() = default;
+
+    //Getters
+    /** Get beginning of the current event in the source
+
+        @return Offset of the first character of the current event
+        (i.e. '<' of a start tag) from the beginning of the document.
+    */
+    size_t  GetSourceBegin() const;
+    /** Get end of the current event in the source
+
+        Closing tags implied by the parser have an empty range, placed
+        at the beginning of whatever made them implied.
+
+        @return Offset one past the last character of the current event
+        from the beginning of the document.
+    */
+    size_t  GetSourceEnd() const;
+    /** Check if text of the current event contains character references
+
+        Valid during OnText() and OnRawText(). Set from the tokenizer scan,
+        so it costs nothing to check.
+
+        @return True if the text contains '&', false if decoding it would
+        not change it.
+    */
+    bool    HasReferences() const;
+
+    //Setters
+    /** Set source range of the next event
+
+        Called by the TreeBuilder before every event.
+
+        @param begin Offset of the first character of the event.
+        @param end Offset one past the last character of the event.
+    */
+    void    SetSource(size_t begin, size_t end);
+    /** Set if text of the next event contains character references
+
+        Called by the TreeBuilder before every text and raw text event.
+
+        @param value True if the text contains '&'.
+    */
+    void    SetReferences(bool value);
+
+    //Other
+
+    /** Start tag event
+
+        @param name Tag name of the element.
+        @param atom Atom of the tag name, kNoAtom for non-standard names.
+        @param attributes Lexer positioned at the first attribute of the
+        element, use TagLexer::NextAttribute() to read them.
+        @return True to continue parsing, false to stop.
+    */
+    virtual bool OnStartTag(const StringView& name, Atom atom,
+                            TagLexer& attributes);
+    /** End tag event
+
+        @param name Tag name of the element.
+        @return True to continue parsing, false to stop.
+    */
+    virtual bool OnEndTag(const StringView& name);
+    /** Text event
+
+        @param text Trimmed text inside the current element.
+        @return True to continue parsing, false to stop.
+    */
+    virtual bool OnText(const StringView& text);
+    /** Raw text event
+
+        Sent with the body of a raw text element (script, style, textarea,
+        title and xmp), right after its start tag event. The default
+        implementation forwards the body to OnText().
+
+        @param text Trimmed body of the current element.
+        @return True to continue parsing, false to stop.
+    */
+    virtual bool OnRawText(const StringView& text);
+    /** Comment event
+
+        @param text Text between "<!--" and "-->".
+        @return True to continue parsing, false to stop.
+    */
+    virtual bool OnComment(const StringView& text);
+    /** Doctype event
+
+        @param doctype Trimmed text between "<!DOCTYPE" and '>'.
+        @return True to continue parsing, false to stop.
+    */
+    virtual bool OnDoctype(const StringView& doctype);
+
+protected:
+    size_t  sourceBegin_ = 0;
+    size_t  sourceEnd_ = 0;
+    bool    references_ = false;
+};
+}
+
+#endif // HANDLER_H
@@ -35,6 +35,15 @@ public:
         @return A reference to this.
      */
     Id& operator=(const Id& other);
+    /** Move constructor
+        @param other Object to move from, left empty.
+     */
+    Id(Id&& other) noexcept;
+    /** Move assignment operator
+        @param other Object to move from, left empty.
+        @return A reference to this.
+     */
+    Id& operator=(Id&& other) noexcept;
 
     //Getters
     static std::string GetStaticName();
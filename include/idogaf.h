@@ -4,14 +4,37 @@
 #ifndef IDOGAF_H_INCLUDED
 #define IDOGAF_H_INCLUDED
 
+#include "arena.h"
+#include "atom.h"
 #include "attribute.h"
+#include "attributeiterator.h"
+#include "charset.h"
 #include "class.h"
+#include "decompressor.h"
 #include "document.h"
+#include "dombuilder.h"
 #include "element.h"
+#include "entitydecoder.h"
+#include "flatbuilder.h"
+#include "flatdocument.h"
+#include "handler.h"
 #include "id.h"
+#include "lineindex.h"
+#include "mappedfile.h"
 #include "misc.h"
+#include "paralleltokenizer.h"
+#include "parselimits.h"
 #include "parser.h"
+#include "parserpool.h"
+#include "pushparser.h"
+#include "scanner.h"
 #include "search.h"
+#include "selectorrule.h"
+#include "stringview.h"
 #include "style.h"
+#include "taglexer.h"
+#include "tokenizer.h"
+#include "tokenreader.h"
+#include "treebuilder.h"
 
 #endif // IDOGAF_H_INCLUDED
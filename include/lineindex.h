@@ -0,0 +1,76 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef LINEINDEX_H
+#define LINEINDEX_H
+
+#include <stddef.h>
+#include <vector>
+
+namespace idogaf
+{
+/** Translation of byte offsets into lines and columns
+
+    Parsing keeps only byte offsets of tokens and elements. This index
+    turns them into line and column numbers when they are needed,
+    i.e. for a diagnostic. Offsets of all '\n' characters are collected
+    at the first query, every query is then a binary search.
+    The indexed memory has to outlive the index.
+*/
+class LineIndex
+{
+public:
+    /** Default constructor
+
+        Constructs an index of an empty input.
+    */
+    LineIndex();
+    /** Range constructor
+
+        @param data Pointer to the first character of the input.
+        @param length Length of the input in bytes.
+    */
+    LineIndex(const char* data, size_t length);
+    /** Default destructor */
+    ~LineIndex() = default;
+
+    //Getters
+    /** Get line of an offset
+
+        @param offset Offset from the beginning of the input in bytes.
+        @return Number of the line containing the offset, starting from 1.
+    */
+    size_t      GetLine(size_t offset) const;
+    /** Get column of an offset
+
+        @param offset Offset from the beginning of the input in bytes.
+        @return Number of bytes from the beginning of the line up to
+        the offset, starting from 1.
+    */
+    size_t      GetColumn(size_t offset) const;
+
+    //Setters
+    /** Set new input
+
+        Drops the index built for the previous input.
+
+        @param data Pointer to the first character of the input.
+        @param length Length of the input in bytes.
+    */
+    void        SetInput(const char* data, size_t length);
+
+protected:
+    const char*                 data_;
+    size_t                      length_;
+    /** Offsets of '\n' characters, filled at the first query */
+    mutable std::vector<size_t> newlines_;
+    mutable bool                built_;
+
+    /** Collect offsets of '\n' characters, if not done yet */
+    void        Build() const;
+
+private:
+};
+}
+
+#endif // LINEINDEX_H
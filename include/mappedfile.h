@@ -0,0 +1,77 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <stddef.h>
+#include <string>
+
+namespace idogaf
+{
+/** Read-only view of a whole file in memory
+
+    On POSIX systems regular files are memory-mapped, so their contents
+    are served straight from the kernel page cache without read calls or
+    copies. Files that can't be mapped (pipes, character devices, files
+    of unknown size) and all files on other systems are read into
+    a buffer owned by this object.
+*/
+class MappedFile
+{
+public:
+    /** Default constructor */
+    MappedFile();
+    /** Default destructor
+
+        Unmaps the file if one is open.
+    */
+    ~MappedFile();
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    //Getters
+    /** Get contents of the file
+        @return Pointer to the first byte of the file or nullptr if no
+        file is open or the file is empty.
+    */
+    const char* GetData() const;
+    /** Get size of the file
+        @return Size of the file in bytes.
+    */
+    size_t      GetSize() const;
+    /** Check if a file is open
+        @return True if a file is open, false otherwise.
+    */
+    bool        IsOpen() const;
+
+    //Other
+    /** Open file
+
+        Maps a given file read-only into memory, or reads it if it can't
+        be mapped. Any previously opened file is closed first. The kernel
+        is advised that a mapped file will be read sequentially.
+
+        @param filename Name of the file to open.
+        @return True on success, False otherwise.
+    */
+    bool        Open(const std::string& filename);
+    /** Close file
+
+        Unmaps the currently opened file. Any pointers returned by GetData()
+        are invalidated.
+    */
+    void        Close();
+
+protected:
+    const char* data_;
+    size_t      size_;
+    bool        open_;
+    bool        mapped_;
+    std::string buffer_;
+
+private:
+};
+}
+
+#endif // MAPPEDFILE_H
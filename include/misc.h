@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include "atom.h"
+
 namespace idogaf
 {
 
@@ -16,6 +18,17 @@ namespace idogaf
 */
 std::string trim(const std::string& str);
 
+/** Trim character range from both sides
+
+    Moves begin forward and end backward past any whitespaces,
+    so that [begin, end) no longer starts or ends with one.
+    Nothing is copied.
+
+    @param begin Pointer to the first character of the range.
+    @param end Pointer one past the last character of the range.
+*/
+void trim(const char*& begin, const char*& end);
+
 /** Count '\n' characters in string
 
     @param str String to use.
@@ -23,6 +36,54 @@ std::string trim(const std::string& str);
 */
 size_t countLines(const std::string& str);
 
+/** Count '\n' characters in character range
+
+    @param begin Pointer to the first character of the range.
+    @param end Pointer one past the last character of the range.
+    @return Number of '\n' characters.
+*/
+size_t countLines(const char* begin, const char* end);
+
+/** Check if character range starts with a given prefix
+
+    @param begin Pointer to the first character of the range.
+    @param end Pointer one past the last character of the range.
+    @param prefix Null-terminated prefix to look for.
+    @return True if the range starts with prefix, false otherwise.
+*/
+bool startsWith(const char* begin, const char* end, const char* prefix);
+
+/** Check if character range starts with a given prefix, ignoring case
+
+    @param begin Pointer to the first character of the range.
+    @param end Pointer one past the last character of the range.
+    @param prefix Pointer to the lowercase prefix to look for.
+    @param length Length of the prefix.
+    @return True if the range starts with prefix in any letter case,
+    false otherwise.
+*/
+bool startsWithIgnoreCase(const char* begin, const char* end,
+                          const char* prefix, size_t length);
+
+/** Check if character range ends with a given suffix
+
+    @param begin Pointer to the first character of the range.
+    @param end Pointer one past the last character of the range.
+    @param suffix Null-terminated suffix to look for.
+    @return True if the range ends with suffix, false otherwise.
+*/
+bool endsWith(const char* begin, const char* end, const char* suffix);
+
+/** Find substring in character range
+
+    @param begin Pointer to the first character of the range.
+    @param end Pointer one past the last character of the range.
+    @param str Null-terminated string to search for.
+    @return Pointer to the first occurrence of str inside the range
+    or nullptr if it was not found.
+*/
+const char* findStr(const char* begin, const char* end, const char* str);
+
 /** Check for string in vector
 
     @param str String to search for.
@@ -32,6 +93,14 @@ size_t countLines(const std::string& str);
 */
 bool strInVector(const std::string& str, const std::vector<std::string>& strVec);
 
+
+/** Check if tag is a singleton tag
+
+    @param tag Atom of the tag name.
+    @return True if the tag can't have content, false otherwise.
+*/
+bool isSingletonTag(Atom tag);
+
 /** Check if closing tag can be omitted
 
     Checks if closing tag can be omitted if it is immediately followed by
@@ -43,6 +112,17 @@ bool strInVector(const std::string& str, const std::vector<std::string>& strVec)
 */
 bool omittClosingTag(const std::string& tag, const std::string& nextTag);
 
+/** Check if closing tag can be omitted
+
+    Same as omittClosingTag(const std::string&, const std::string&),
+    but compares atoms.
+
+    @param tag Atom of the tag to check.
+    @param nextTag Atom of the next tag.
+    @return True if the closing tag of the 'tag' can be omitted, false otherwise.
+*/
+bool omittClosingTag(Atom tag, Atom nextTag);
+
 /** Check if closing tag can be omitted
 
     Checks if closing tag can be omitted if there is no more content
@@ -54,17 +134,35 @@ bool omittClosingTag(const std::string& tag, const std::string& nextTag);
 */
 bool omittClosingTagNMC(const std::string& tag, const std::string& parent);
 
+/** Check if closing tag can be omitted
 
-const std::vector<std::string> kSingletonTags = {
-    "area", "base", "br", "col", "command", "embed", "hr", "img", "input",
-    "keygen", "link", "meta", "param", "source", "track", "wbr" };
-const std::vector<std::string> kpElementOptVec = {
-    "address", "article", "aside", "blockquote", "dic", "dl", "fieldset",
-    "footer", "form", "h1", "h2", "h3", "h4", "h5", "h6", "header", "hgroup",
-    "hr", "main", "nav", "ol", "p", "pre", "section", "table", "ul" };
-const std::vector<std::string> kOptCTagNMC = {
-    "li", "dd", "rb", "rt", "rtc", "rp", "optgroup", "option", "tbody", "tfoot",
-    "tr", "td", "th" };
+    Same as omittClosingTagNMC(const std::string&, const std::string&),
+    but compares atoms.
+
+    @param tag Atom of the tag to check.
+    @param parent Atom of the parent tag.
+    @return True if the closing tag of the 'tag' can be omitted, false otherwise.
+*/
+bool omittClosingTagNMC(Atom tag, Atom parent);
+
+/** Names of singleton tags
+
+    @deprecated Use isSingletonTag(Atom) or the kTagVoid property
+    of AtomTable::GetProperties(). Not used by the parser any more.
+*/
+extern const std::vector<std::string> kSingletonTags;
+/** Names of tags closing an open p element
+
+    @deprecated Use omittClosingTag(Atom, Atom) or the kTagClosesP property
+    of AtomTable::GetProperties(). Not used by the parser any more.
+*/
+extern const std::vector<std::string> kpElementOptVec;
+/** Names of tags which closing tags can be omitted at the end of the parent
+
+    @deprecated Use omittClosingTagNMC(Atom, Atom) or the kTagOptionalEnd
+    property of AtomTable::GetProperties(). Not used by the parser any more.
+*/
+extern const std::vector<std::string> kOptCTagNMC;
 }
 
 #endif // MISC_H_INCLUDED
@@ -0,0 +1,160 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef PARALLELTOKENIZER_H
+#define PARALLELTOKENIZER_H
+
+#include <stddef.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tokenizer.h"
+
+namespace idogaf
+{
+/** Multi-threaded html tokenizer
+
+    Returns exactly the same tokens as Tokenizer, but tokenizes a large
+    document on several threads. The input is split into chunks starting
+    at '<' characters and every chunk is tokenized speculatively, as if it
+    started at a token boundary. Tokens are returned in order by the
+    calling thread, which checks where the previous chunk really ended
+    (a comment, raw text body or attribute value may run over the chunk
+    boundary) and re-tokenizes the beginning of a chunk until it meets a token
+    boundary found by the speculative pass.
+
+    Only a limited number of chunks is tokenized ahead of the consumer,
+    so memory used for tokens doesn't grow with the input size.
+
+    Threads are started on the first Next() and kept until the tokenizer
+    is destroyed, so one tokenizer can go through many inputs (see
+    SetInput()) without starting threads again.
+*/
+class ParallelTokenizer
+{
+public:
+    /** Default size of a chunk in bytes */
+    static const size_t kDefaultChunkSize = 1024 * 1024;
+
+    /** Threads constructor
+
+        Constructs a tokenizer without input, use SetInput() to give it one.
+
+        @param threads Number of tokenizing threads.
+    */
+    ParallelTokenizer(size_t threads);
+    /** Range constructor
+
+        @param data Pointer to the first character of the input.
+        @param length Length of the input in bytes.
+        @param threads Number of tokenizing threads.
+    */
+    ParallelTokenizer(const char* data, size_t length, size_t threads);
+    /** Destructor
+
+        Stops and joins tokenizing threads.
+    */
+    ~ParallelTokenizer();
+    ParallelTokenizer(const ParallelTokenizer& other) = delete;
+    ParallelTokenizer& operator=(const ParallelTokenizer& other) = delete;
+
+    //Getters
+    size_t      GetThreads() const;
+    size_t      GetChunkSize() const;
+    bool        AllowMistypedCommentTags() const;
+
+    //Setters
+    /** Set new input
+
+        Drops what is left of the previous input, waiting for chunks
+        being tokenized to finish. Threads are kept.
+
+        @param data Pointer to the first character of the input.
+        @param length Length of the input in bytes.
+    */
+    void        SetInput(const char* data, size_t length);
+    /** Set size of a chunk
+
+        Has to be set before the first Next() of an input.
+
+        @param size Approximate number of bytes tokenized at once
+        by a single thread.
+    */
+    void        SetChunkSize(size_t size);
+    /** Allow mistyped comment tags
+
+        Has to be set before the first Next() of an input.
+
+        @see Tokenizer::AllowMistypedCommentTags(bool)
+    */
+    void        AllowMistypedCommentTags(bool value);
+
+    //Other
+    /** Read next token
+
+        Starts tokenizing threads at the first call for the first input.
+
+        @param tokenOut Output parameter, set to the next token.
+        @return True if a token was read, false if the input ended.
+    */
+    bool        Next(Token& tokenOut);
+
+protected:
+    /** Speculatively tokenized part of the input */
+    struct Chunk
+    {
+        const char*         begin = nullptr;
+        const char*         end = nullptr;
+        std::vector<Token>  tokens;
+        /** Position of the tokenizer after the last token */
+        const char*         position = nullptr;
+        bool                ready = false;
+    };
+
+    const char*                 data_;
+    const char*                 end_;
+    size_t                      threads_;
+    size_t                      chunkSize_;
+    bool                        allowMistypedCommentTags_;
+    bool                        started_;
+    bool                        stop_;
+    std::vector<Chunk>          chunks_;
+    size_t                      nextChunk_;
+    size_t                      currentChunk_;
+    /** Number of threads tokenizing a chunk right now */
+    size_t                      busy_;
+    std::vector<std::thread>    workers_;
+    std::mutex                  mutex_;
+    std::condition_variable     readyCondition_;
+    std::condition_variable     windowCondition_;
+    /** Tokenizer resolving chunk boundaries */
+    Tokenizer                   tokenizer_;
+    /** Real position in the input, where the current chunk is resolved from */
+    const char*                 position_;
+    /** Tokens re-tokenized at the beginning of the current chunk */
+    std::vector<Token>          resolved_;
+    size_t                      resolvedIndex_;
+    /** Next speculative token of the current chunk to return */
+    size_t                      tokenIndex_;
+
+    /** Split the input into chunks and start tokenizing threads,
+        unless they are already running */
+    void        Start();
+    /** Tokenizing thread body */
+    void        Work();
+    /** Tokenize a chunk speculatively
+        @param chunk Chunk to tokenize.
+    */
+    void        TokenizeChunk(Chunk& chunk) const;
+    /** Wait for the current chunk and find its real tokens */
+    void        ResolveChunk();
+    /** Release the current chunk and let threads tokenize further */
+    void        ReleaseChunk();
+
+private:
+};
+}
+
+#endif // PARALLELTOKENIZER_H
@@ -0,0 +1,59 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef PARSELIMITS_H
+#define PARSELIMITS_H
+
+#include <stddef.h>
+
+namespace idogaf
+{
+/** Resource limit of a parse */
+enum class Limit
+{
+    kNone,              ///< No limit was exceeded
+    kDepth,             ///< ParseLimits::maxDepth
+    kNodes,             ///< ParseLimits::maxNodes
+    kAttributes,        ///< ParseLimits::maxAttributes
+    kAttributeLength,   ///< ParseLimits::maxAttributeLength
+    kTextLength,        ///< ParseLimits::maxTextLength
+    kInputLength        ///< ParseLimits::maxInputLength
+};
+
+/** Resource limits of a parse
+
+    Bound the time and memory a single document can take, no matter how
+    broken or hostile it is. Every limit is off when set to 0 (default).
+    A document exceeding a limit makes the parse fail, unless truncate
+    is set. Then the document simply ends before the token which exceeded
+    the limit, every element still open is closed there.
+*/
+struct ParseLimits
+{
+    /** Maximum number of nested elements */
+    size_t      maxDepth = 0;
+    /** Maximum number of elements in the document */
+    size_t      maxNodes = 0;
+    /** Maximum number of attributes of one element */
+    size_t      maxAttributes = 0;
+    /** Maximum length of one attribute value in bytes */
+    size_t      maxAttributeLength = 0;
+    /** Maximum length of all text, comments and raw text element bodies
+        together in bytes */
+    size_t      maxTextLength = 0;
+    /** Maximum length of the input in bytes, a truncated input ends
+        before a multibyte character which doesn't fit */
+    size_t      maxInputLength = 0;
+    /** Truncate the document at an exceeded limit instead of failing */
+    bool        truncate = false;
+};
+
+/** Get description of a limit
+
+    @param limit Limit to describe.
+    @return Null-terminated description, i.e. "nesting depth".
+*/
+const char* getLimitName(Limit limit);
+}
+
+#endif // PARSELIMITS_H
@@ -5,12 +5,25 @@
 #define PARSER_H
 
 #include <istream>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include "attribute.h"
+#include "charset.h"
 #include "document.h"
+#include "dombuilder.h"
 #include "element.h"
+#include "flatbuilder.h"
+#include "flatdocument.h"
+#include "handler.h"
+#include "lineindex.h"
+#include "mappedfile.h"
+#include "paralleltokenizer.h"
+#include "parselimits.h"
+#include "selectorrule.h"
+#include "treebuilder.h"
 
 namespace idogaf
 {
@@ -40,9 +53,64 @@ public:
         @return Pointer to the parsed document.
     */
     Document*   GetDocumentPtr();
+    /** Take parsed document
+
+        Swaps the parsed document with a given one, nothing is copied.
+        When reusing (see Reuse(bool)), pass a document you are done with,
+        so its memory is reused by the next parse.
+
+        @param documentOut Document to swap with the parsed one.
+    */
+    void        TakeDocument(Document& documentOut);
+    /** Take parsed document
+
+        The parser is left with an empty document.
+
+        @return Parsed document.
+    */
+    Document    TakeDocument();
     bool        Silent() const;
     bool        SkipUnnecessaryClosingTags() const;
     bool        AllowMistypedCommentTags() const;
+    size_t      Threads() const;
+    size_t      ChunkSize() const;
+    RawTextMode RawText() const;
+    bool        Reuse() const;
+    bool        UseArena() const;
+    const std::vector<SelectorRule>&   GetPruneRules() const;
+    /** Check if the last parse stopped early
+        @return True if the last parse ended, because all stop conditions
+        were met, false otherwise.
+    */
+    bool        Stopped() const;
+    /** Get offset at which the last parse stopped
+        @return Offset one past the end of the element which met the last
+        stop condition, 0 if the last parse didn't stop early.
+    */
+    size_t      GetStopOffset() const;
+    const ParseLimits&  Limits() const;
+    /** Get limit exceeded by the last parse
+        @return Limit which made the last parse fail or truncate
+        the document, Limit::kNone if no limit was exceeded.
+    */
+    Limit       GetExceededLimit() const;
+    /** Get line index of the document parsed last
+
+        Turns source offsets of elements into lines and columns.
+        The index is built at the first query and it's valid only as long
+        as the input: the file or stream parsed last by this parser or
+        the memory passed to Parse(const char*, size_t).
+
+        @return Reference to the line index.
+    */
+    const LineIndex&    GetLineIndex() const;
+    Encoding    EncodingHint() const;
+    bool        Transcode() const;
+    /** Get encoding of the document parsed last
+        @return Encoding the document was read in, Encoding::kUtf8 for
+        documents which didn't declare any, but were valid UTF-8 (or ASCII).
+    */
+    Encoding    GetEncoding() const;
 
     //Setters
     /** Set parsers silent mode
@@ -70,12 +138,159 @@ public:
         @param value Use true to enable this option and false to disable.
     */
     void        AllowMistypedCommentTags(bool value);
+    /** Set number of tokenizing threads
+
+        Using more than one thread splits documents parsed from memory
+        (including mapped files, streams and strings) into chunks tokenized
+        in parallel, while the tree is still built by the calling thread.
+        The result is exactly the same as with one thread. This pays off
+        only for very large documents, megabytes in size. Only documents
+        larger than a single chunk (see ChunkSize(size_t)) are split.
+        The threads are started by the first such document and kept for
+        the next ones until the parser is destroyed.
+
+        @param threads Number of threads, 1 (default) disables parallel
+        tokenizing.
+    */
+    void        Threads(size_t threads);
+    /** Set size of chunks tokenized in parallel
+
+        Smaller chunks spread shorter documents over more threads, but
+        every chunk boundary costs some re-tokenizing.
+
+        @param size Approximate size of a chunk in bytes,
+        ParallelTokenizer::kDefaultChunkSize (1 MiB) by default.
+    */
+    void        ChunkSize(size_t size);
+    /** Set way of storing raw text element bodies
+
+        Bodies of script, style, textarea, title and xmp elements are
+        copied into the element text by default. RawTextMode::kDrop skips
+        them and RawTextMode::kSpan keeps only a view of them in the input,
+        which avoids copying large inline scripts. A span stays valid only
+        as long as the input: the file or stream parsed last by this parser
+        or the memory passed to Parse(const char*, size_t).
+
+        @param mode Mode to use.
+    */
+    void        RawText(RawTextMode mode);
+    /** Reuse memory of the document between parses
+
+        Instead of building every document from scratch, Parse() fills
+        the elements of the previously parsed document over again, keeping
+        memory of their strings and vectors. Together with the tree
+        construction stacks which are kept anyway, a parser parsing many
+        similar documents allocates very little after the first one.
+        The previous document is overwritten, take it out first with
+        TakeDocument() to keep it.
+
+        @param value Use true to enable this option and false to disable.
+    */
+    void        Reuse(bool value);
+    /** Build documents in their arenas
+
+        Text and attribute values of parsed documents are stored in a bump
+        allocator owned by the document (see Document::GetArena()) instead
+        of separate strings, so parsing and destroying a document takes far
+        fewer heap allocations and threads parsing at once don't contend
+        for the allocator as much. Non-standard attribute names and values
+        of class and id attributes are kept in the arena as well.
+        Still allocated separately are: vectors of children and attributes
+        of every element, names of elements with non-standard tag names
+        and style attributes, which are split into declarations.
+        Copies of elements and of the whole document are independent of
+        the arena, only pointers and views refer to it.
+        Works best together with Reuse(bool), which keeps the arena blocks
+        of the previous document.
+
+        @param value Use true to enable this option and false to disable.
+    */
+    void        UseArena(bool value);
+    /** Add prune rule
+
+        Elements matching a prune rule (a simple CSS selector, i.e. "svg",
+        ".ad-slot" or "[aria-hidden=true]") are left out of the document
+        together with their contents. They are recognized at their start
+        tags and their contents are skipped without building anything,
+        which makes parsing of pages full of ads or inline graphics
+        considerably faster.
+
+        @see TreeBuilder::AddPruneRule(const SelectorRule&)
+
+        @param selector Simple CSS selector, see SelectorRule.
+        @return True if the rule was added, false if the selector
+        is not supported.
+    */
+    bool        AddPruneRule(const std::string& selector);
+    /** Remove all prune rules */
+    void        ClearPruneRules();
+    /** Add stop condition
+
+        Parsing ends as soon as every stop condition is met, that is a given
+        number of elements matching its selector were parsed whole. The rest
+        of the input is not even read. The document then holds everything
+        up to that point, elements which were still open are closed there.
+        Use Stopped() and GetStopOffset() to check where the parse ended.
+        For example StopAfter("head") parses only the head of a document
+        and StopAfter("a[href]", 10) only up to the tenth link.
+
+        @param selector Simple CSS selector, see SelectorRule.
+        @param count Number of matching elements to wait for.
+        @return True if the condition was added, false if the selector
+        is not supported, count is 0 or there are already
+        TreeBuilder::kMaxStopConditions conditions.
+    */
+    bool        StopAfter(const std::string& selector, size_t count = 1);
+    /** Remove all stop conditions */
+    void        ClearStopConditions();
+    /** Set resource limits
+
+        Bounds nesting depth, number of elements, attributes, text and
+        input length of parsed documents, so broken or hostile documents
+        can't take arbitrary time or memory. A document exceeding a limit
+        fails to parse with an error naming the limit or, if limits
+        truncate, ends right before the token which exceeded it.
+        Use GetExceededLimit() to check which limit it was.
+
+        @param limits Limits to use, see ParseLimits.
+    */
+    void        Limits(const ParseLimits& limits);
+    /** Set encoding hint
+
+        Gives the encoding known from elsewhere, i.e. from the Content-Type
+        header of an HTTP response. A byte order mark still takes precedence,
+        a <meta> tag declaring the encoding doesn't.
+
+        @see Charset::Detect()
+
+        @param encoding Encoding of parsed documents, Encoding::kUnknown
+        (default) to detect it.
+    */
+    void        EncodingHint(Encoding encoding);
+    /** Transcode documents to UTF-8
+
+        Enabled by default. Documents are sniffed for their encoding (see
+        Charset) and those in other encodings than UTF-8 are transcoded
+        before parsing, so the Document always holds UTF-8. A document
+        which doesn't declare its encoding and isn't valid UTF-8 is read
+        as windows-1252, like browsers do. Transcoded documents are parsed
+        from a buffer kept by the parser, so source offsets, the line index
+        and raw text spans (see RawText(RawTextMode)) refer to the
+        transcoded text. Valid UTF-8 and ASCII documents are parsed in place
+        after a quick validation pass.
+
+        @param value Use true to enable this option and false to parse
+        the bytes as they are.
+    */
+    void        Transcode(bool value);
 
     //Other
     /** Parse html document from file
 
         Parses document to Document object. To retrieve parsed Document
-        object use GetDocument().
+        object use GetDocument(). The file is memory-mapped and parsed
+        in place, the mapping is kept until another file is parsed or
+        the parser is destroyed.
 
         @param filename Name of the file to parse.
         @return True on success, False otherwise.
@@ -90,6 +305,84 @@ public:
         @return True on success, False otherwise.
     */
     bool        Parse(std::istream& stream);
+    /** Parse html document from memory
+
+        Parses document to Document object. To retrieve parsed Document
+        object use GetDocument(). This is the fastest way to parse a document,
+        since the tokenizer works directly on the given memory and nothing
+        is copied until it lands in the Document. The data has to stay
+        valid only during this call.
+
+        @param data Pointer to the first character of the document.
+        @param length Length of the document in bytes.
+        @return True on success, False otherwise.
+    */
+    bool        Parse(const char* data, size_t length);
+    /** Parse html document from string
+
+        Parses document to Document object. To retrieve parsed Document
+        object use GetDocument(). The parser takes over the string's buffer,
+        so no copy of the document is made. This isn't an overload of
+        Parse(), because temporary file names would bind to it.
+
+        @param data String containing the document.
+        @return True on success, False otherwise.
+    */
+    bool        ParseString(std::string&& data);
+    /** Parse html document from file into a FlatDocument
+
+        @see Parse(const char*, size_t, FlatDocument&)
+
+        @param filename Name of the file to parse.
+        @param document Document to build, cleared first.
+        @return True on success, False otherwise.
+    */
+    bool        Parse(const std::string& filename, FlatDocument& document);
+    /** Parse html document from memory into a FlatDocument
+
+        Builds a read-optimized FlatDocument given by the caller instead of
+        the Document held by the parser. The raw text and limit options
+        apply the same way, the tree reuse and arena options don't, since
+        a FlatDocument always reuses its memory and keeps text in its arena.
+
+        @param data Pointer to the first character of the document.
+        @param length Length of the document in bytes.
+        @param document Document to build, cleared first.
+        @return True on success, False otherwise.
+    */
+    bool        Parse(const char* data, size_t length, FlatDocument& document);
+    /** Parse html document from file into events
+
+        Parses document without building a Document object. Every start tag,
+        end tag, text, comment and doctype is reported to a given handler.
+        The events follow the same rules as Parse(), so omitted closing tags
+        and empty elements get end tag events too.
+
+        @param filename Name of the file to parse.
+        @param handler Handler to send events to.
+        @return True on success, False otherwise. Stopping the parse from
+        the handler is not an error.
+    */
+    bool        ParseEvents(const std::string& filename, Handler& handler);
+    /** Parse html document from stream into events
+
+        @see ParseEvents(const std::string&, Handler&)
+
+        @param stream Stream to read from.
+        @param handler Handler to send events to.
+        @return True on success, False otherwise.
+    */
+    bool        ParseEvents(std::istream& stream, Handler& handler);
+    /** Parse html document from memory into events
+
+        @see ParseEvents(const std::string&, Handler&)
+
+        @param data Pointer to the first character of the document.
+        @param length Length of the document in bytes.
+        @param handler Handler to send events to.
+        @return True on success, False otherwise.
+    */
+    bool        ParseEvents(const char* data, size_t length, Handler& handler);
     /** Write current Document object to file
 
         Writes document object from document_ variable to file with a given
@@ -110,79 +403,59 @@ protected:
     bool        silent_;
     bool        skipUnnecessaryClosingTags_;
     bool        allowMistypedCommentTags_;
+    size_t      threads_;
+    size_t      chunkSize_;
+    RawTextMode rawTextMode_;
+    bool        reuse_;
+    bool        useArena_;
+    bool        stopped_;
+    size_t      stopOffset_;
+    Limit       exceededLimit_;
+    Encoding    encodingHint_;
+    bool        transcode_;
+    Encoding    encoding_;
     Document    document_;
+    DomBuilder  domBuilder_;
+    /** Tree builder kept between parses, holds prune rules,
+        stop conditions and limits */
+    TreeBuilder treeBuilder_;
+    std::string source_;
+    /** Input transcoded to UTF-8, kept to reuse its memory */
+    std::string transcoded_;
+    MappedFile  file_;
+    LineIndex   lines_;
+    /** Tokenizer used with more than one thread, kept with its threads
+        between parses, not copied with the parser */
+    std::unique_ptr<ParallelTokenizer>  parallelTokenizer_;
+
+    /** Detect encoding of input and transcode it if needed
+
+        Sets encoding_. Input which is not UTF-8 is transcoded into
+        transcoded_, a byte order mark is skipped.
+
+        @param data Pointer to the first character of the input, set to
+        the first character of the UTF-8 input to parse.
+        @param length Length of the input in bytes, set to the length
+        of the UTF-8 input to parse.
+    */
+    void        Decode(const char*& data, size_t& length);
+    /** Open file for parsing
+
+        Memory-maps a given file into file_. Prints an error message,
+        if parser doesn't run in silent mode and the file can't be opened.
 
-    /** Read next html tag from stream
-
-        Reads from stream until the end of next tag and return an Element
-        object with a name and attributes of the next tag. If the Doctype
-        tag is found, this function sets an apropriate parameter in the
-        document_ variable. After this it will read until the end of the
-        next tag. Every comment tag (<!-- -->) is ignored. If a text is
-        found before the next tag it is set in a textOut parameter,
-        whitespaces before and after the text are trimmed and multiple
-        newline characters in a row are changed to a single one. If comment
-        or a doctype tag was found between the text an additional newline
-        will be added in it's place. If the next tag was an empty one
-        (<tag/>) emptyOut is set to true. If the next tag was a closing tag
-        (</tag>) then closeOut parameter is set to true. If a given stream
-        ended before the next tag (eofbit was set) or failed,
-        then this function returns nullptr.
-
-        @param stream
-        Reference to a stream to read from.
-
-        @param emptyOut
-        Output parameter, is set to true if found tag was empty (<tag/>),
-        false otherwise.
-
-        @param closeOut
-        Output parameter, is set to true if found tag was a closing tag
-        (<tag/>), false otherwise.
-
-        @param textOut
-        Output parameter, if any text was found before the next tag, this
-        will contain it, otherwise it will be empty.
-
-        @param linesOut
-        Output parameter, returns number of lines read.
-
-        @return An Element object with the next tag,
-        or an empty element if the stream ended or failed.
-    */
-    Element     ReadNextTag(std::istream& stream, bool& emptyOut,
-                            bool& closeOut, std::string& textOut,
-                            size_t& linesOut);
-    /** Parse tag for an element
-
-        Parses a html tag in a given string for an Element object with
-        a name and attributes if they exist. The given string should
-        contain everything between '<' or '</' and '>' or '/>' signs.
-        If an std::ios_base::failure exception is cought while extracting
-        the name, this function returns nullptr. Otherwise it returns
-        pointer to the new Element object. If an exception was cought
-        and the parser doesn't run in a silent mode, then an apropriate
-        message is written to stderr.
-
-        @param tag String containing a tag to parse.
-        @return An Element object or an empty element if this function fails.
-    */
-    Element     ParseTagForElement(const std::string& tag);
-    /** Parse string for an attribute
-
-        Parses string for an attribute, extracting it's name and value.
-        The given string should be in a form of 'name="value"'
-        (excluding ' character). If the string doesn't contain '=' character
-        this function returns an Attribute object with a name of a given
-        string and no value, otherwise it returns an Attribute object
-        with the name created from part of the string to the left of
-        the '=' sign and value from a right part, excluding the last
-        character and the first character after '='.
-
-        @param str String to parse.
-        @return An Attribute object.
-    */
-    Attribute   ParseStringForAttribute(const std::string& str);
+        @param filename Name of the file to open.
+        @return True on success, False otherwise.
+    */
+    bool        OpenFile(const std::string& filename);
+    /** Read stream for parsing
+
+        Reads everything from a given stream into source_.
+
+        @param stream Stream to read from.
+        @return True on success, False otherwise.
+    */
+    bool        ReadStream(std::istream& stream);
 
     /** Write opening tag of an element to stream
 
@@ -225,6 +498,16 @@ protected:
         @return Always false.
     */
     bool UnexpectedTagError(const std::string& tagName, size_t line) const;
+    /** End with exceeded limit error
+
+        Prints exceeded limit error message, if parser doesn't run in
+        silent mode.
+
+        @param limit Exceeded limit.
+        @param line Line at which the limit was exceeded, 0 if unknown.
+        @return Always false.
+    */
+    bool LimitError(Limit limit, size_t line) const;
     /** End with document empty error
 
         Prints document empty error message, if parser doesn't run in
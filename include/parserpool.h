@@ -0,0 +1,233 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef PARSERPOOL_H
+#define PARSERPOOL_H
+
+#include <stddef.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "document.h"
+#include "mappedfile.h"
+#include "parselimits.h"
+#include "parser.h"
+#include "selectorrule.h"
+#include "stringview.h"
+
+namespace idogaf
+{
+/** Statistics of a batch parse */
+struct BatchStats
+{
+    /** Number of parsed documents */
+    size_t  documents = 0;
+    /** Number of documents which failed to parse or couldn't be opened */
+    size_t  failed = 0;
+    /** Total size of parsed documents in bytes */
+    size_t  bytes = 0;
+    /** Wall clock time of the whole batch in seconds */
+    double  seconds = 0.0;
+    /** Number of times a thread took work from another thread */
+    size_t  steals = 0;
+
+    /** Get throughput
+        @return Parsed megabytes (1024 * 1024 bytes) per second.
+    */
+    double  GetMegabytesPerSecond() const;
+    /** Get throughput
+        @return Parsed documents per second.
+    */
+    double  GetDocumentsPerSecond() const;
+};
+
+/** Pool of parsers for parsing many documents at once
+
+    Spreads a batch of documents across a number of threads. Every thread
+    gets a contiguous part of the batch and, once it's done, steals half
+    of the remaining work of another thread, so a few big documents don't
+    leave other threads idle. Each thread keeps its own Parser and file
+    mapping between documents and batches.
+*/
+class ParserPool
+{
+public:
+    /** Callback receiving parsed documents
+
+        Called from the pool's threads, possibly concurrently, as soon as
+        a document is parsed. Its arguments are the index of the document
+        in the batch, the parsed document and true if parsing succeeded.
+        The document is reused by the thread for its next document, so its
+        memory isn't allocated over and over. Swap it out with
+        Document::Swap() to keep it, preferably for a document you are
+        done with.
+    */
+    typedef std::function<void(size_t, Document&, bool)> Callback;
+
+    /** Thread count constructor
+
+        @param threads Number of threads, 0 (default) uses one thread
+        per hardware thread.
+    */
+    ParserPool(size_t threads = 0);
+    /** Default destructor */
+    ~ParserPool() = default;
+    ParserPool(const ParserPool& other) = delete;
+    ParserPool& operator=(const ParserPool& other) = delete;
+
+    //Getters
+    size_t      GetThreads() const;
+    /** Get statistics of the last batch
+        @return Statistics of the last finished batch.
+    */
+    BatchStats  GetStats() const;
+    bool        Silent() const;
+    bool        SkipUnnecessaryClosingTags() const;
+    bool        AllowMistypedCommentTags() const;
+    const std::vector<SelectorRule>&   GetPruneRules() const;
+    const ParseLimits&  Limits() const;
+    bool        UseArena() const;
+
+    //Setters
+    /** Set parsers silent mode
+
+        @see Parser::Silent(bool)
+    */
+    void        Silent(bool silent = false);
+    /** Skip unnecessary closing tags
+
+        @see Parser::SkipUnnecessaryClosingTags(bool)
+    */
+    void        SkipUnnecessaryClosingTags(bool value);
+    /** Allow mistyped comment tags
+
+        @see Parser::AllowMistypedCommentTags(bool)
+    */
+    void        AllowMistypedCommentTags(bool value);
+    /** Add prune rule
+
+        @see Parser::AddPruneRule(const std::string&)
+    */
+    bool        AddPruneRule(const std::string& selector);
+    /** Remove all prune rules */
+    void        ClearPruneRules();
+    /** Set resource limits
+
+        Applied to every document of a batch, so no single document can
+        hold up a worker for long.
+
+        @see Parser::Limits(const ParseLimits&)
+    */
+    void        Limits(const ParseLimits& limits);
+    /** Build documents in their arenas
+
+        Each document, including those returned by ParseFiles() and
+        ParseBuffers(), owns its arena, so threads don't contend for
+        the heap for text and attribute values.
+
+        @see Parser::UseArena(bool)
+    */
+    void        UseArena(bool value);
+
+    //Other
+    /** Parse a batch of files
+
+        @param filenames Names of the files to parse.
+        @return Parsed documents, in the order of filenames. Documents
+        which failed to parse are empty or incomplete.
+    */
+    std::vector<Document> ParseFiles(const std::vector<std::string>& filenames);
+    /** Parse a batch of files
+
+        @param filenames Names of the files to parse.
+        @param callback Callback receiving every parsed document.
+    */
+    void        ParseFiles(const std::vector<std::string>& filenames,
+                           const Callback& callback);
+    /** Parse a batch of documents held in memory
+
+        @param buffers Views of the documents to parse. The memory has to
+        stay valid during this call.
+        @return Parsed documents, in the order of buffers. Documents
+        which failed to parse are empty or incomplete.
+    */
+    std::vector<Document> ParseBuffers(const std::vector<StringView>& buffers);
+    /** Parse a batch of documents held in memory
+
+        @param buffers Views of the documents to parse. The memory has to
+        stay valid during this call.
+        @param callback Callback receiving every parsed document.
+    */
+    void        ParseBuffers(const std::vector<StringView>& buffers,
+                             const Callback& callback);
+
+protected:
+    /** Per-thread state */
+    struct Worker
+    {
+        Parser      parser;
+        MappedFile  file;
+        /** Document reused for every document passed to a callback */
+        Document    document;
+        /** Indices of documents left to this thread, [begin, end) */
+        std::mutex  mutex;
+        size_t      begin = 0;
+        size_t      end = 0;
+        BatchStats  stats;
+    };
+    /** Parse a single document of a batch */
+    typedef std::function<bool(Worker&, size_t, Document&)> Task;
+
+    bool        silent_;
+    bool        skipUnnecessaryClosingTags_;
+    bool        allowMistypedCommentTags_;
+    std::vector<SelectorRule>  pruneRules_;
+    ParseLimits limits_;
+    bool        useArena_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    BatchStats  stats_;
+
+    /** Parse a single file
+        @return True on success, False otherwise.
+    */
+    bool        ParseFile(Worker& worker, const std::string& filename,
+                          Document& document);
+    /** Parse a single document held in memory
+        @return True on success, False otherwise.
+    */
+    bool        ParseBuffer(Worker& worker, const StringView& buffer,
+                            Document& document);
+    /** Run a batch
+
+        @param count Number of documents in the batch.
+        @param task Function parsing a document.
+        @param results Vector to parse documents into, or nullptr.
+        @param callback Callback receiving documents, used if results
+        is nullptr.
+    */
+    void        Run(size_t count, const Task& task,
+                    std::vector<Document>* results, const Callback& callback);
+    /** Thread body
+        @param index Index of the worker.
+    */
+    void        Work(size_t index, const Task& task,
+                     std::vector<Document>* results, const Callback& callback);
+    /** Take next document for a worker
+
+        Takes the first document left to the worker or steals the second
+        half of documents left to another worker.
+
+        @param index Index of the worker.
+        @param documentOut Output parameter, index of the document.
+        @return False if there is no work left.
+    */
+    bool        TakeWork(size_t index, size_t& documentOut);
+
+private:
+};
+}
+
+#endif // PARSERPOOL_H
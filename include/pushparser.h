@@ -0,0 +1,282 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef PUSHPARSER_H
+#define PUSHPARSER_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "charset.h"
+#include "document.h"
+#include "dombuilder.h"
+#include "handler.h"
+#include "parselimits.h"
+#include "selectorrule.h"
+#include "tokenizer.h"
+#include "treebuilder.h"
+
+namespace idogaf
+{
+/** Incremental parser for documents arriving in parts
+
+    Parses a document fed in chunks of any size, i.e. as they arrive from
+    the network. Chunks may end anywhere, including inside tags, comments,
+    attribute values and script or style bodies. Everything that can be parsed is
+    parsed during Feed(), only an incomplete token at the end of the
+    received data is kept until more data arrives. After the last chunk
+    call Finish().
+
+    The result is either a Document (default constructor) or a stream
+    of events sent to a Handler, the same as from Parser::Parse()
+    and Parser::ParseEvents().
+
+    Documents in other encodings than UTF-8 are transcoded part by part,
+    the same way Parser does it (see Parser::Transcode(bool)). The first
+    Charset::kPrescanLength bytes are held back until the encoding is
+    known. A byte order mark, the hint and a <meta> declaration are
+    looked for in them, and without any of these they also decide
+    between UTF-8 and windows-1252: unlike Parser, the push parser can't
+    validate the whole document first. A character split between two
+    parts is completed with the next one. UTF-8 input is parsed as it is.
+*/
+class PushParser
+{
+public:
+    /** Default constructor
+
+        Constructs a parser building a Document object. To retrieve it,
+        after calling Finish() use GetDocument().
+    */
+    PushParser();
+    /** Handler constructor
+
+        Constructs a parser sending events to a given handler.
+
+        @param handler Handler to send events to.
+    */
+    PushParser(Handler& handler);
+    /** Default destructor */
+    ~PushParser() = default;
+    PushParser(const PushParser& other) = delete;
+    PushParser& operator=(const PushParser& other) = delete;
+
+    //Getters
+    /** Get parsed document
+        @return Copy of the parsed document.
+    */
+    Document    GetDocument() const;
+    /** Get parsed document
+        @return Pointer to the parsed document.
+    */
+    Document*   GetDocumentPtr();
+    /** Take parsed document
+
+        @see Parser::TakeDocument(Document&)
+    */
+    void        TakeDocument(Document& documentOut);
+    /** Take parsed document
+
+        @see Parser::TakeDocument()
+    */
+    Document    TakeDocument();
+    /** Check if the parser finished
+
+        @return True if the document ended (root element was closed),
+        the handler asked to stop or an error was found. Any data fed
+        after that is ignored.
+    */
+    bool        Finished() const;
+    /** Get number of buffered bytes
+        @return Number of received bytes which were not parsed yet.
+    */
+    size_t      GetBufferedSize() const;
+    bool        Silent() const;
+    bool        SkipUnnecessaryClosingTags() const;
+    bool        AllowMistypedCommentTags() const;
+    bool        Reuse() const;
+    bool        UseArena() const;
+    const std::vector<SelectorRule>&   GetPruneRules() const;
+    const ParseLimits&  Limits() const;
+    /** Get exceeded limit
+
+        @see Parser::GetExceededLimit()
+    */
+    Limit       GetExceededLimit() const;
+    Encoding    EncodingHint() const;
+    bool        Transcode() const;
+    /** Get encoding of the document
+
+        @return Encoding the document is read in, Encoding::kUnknown until
+        enough data arrived to detect it.
+    */
+    Encoding    GetEncoding() const;
+
+    //Setters
+    /** Set parsers silent mode
+
+        @see Parser::Silent(bool)
+    */
+    void        Silent(bool silent = false);
+    /** Skip unnecessary closing tags
+
+        Has to be set before the first Feed().
+
+        @see Parser::SkipUnnecessaryClosingTags(bool)
+    */
+    void        SkipUnnecessaryClosingTags(bool value);
+    /** Allow mistyped comment tags
+
+        Has to be set before the first Feed().
+
+        @see Parser::AllowMistypedCommentTags(bool)
+    */
+    void        AllowMistypedCommentTags(bool value);
+    /** Reuse memory of the document between parses
+
+        Takes effect at the next Reset().
+
+        @see Parser::Reuse(bool)
+    */
+    void        Reuse(bool value);
+    /** Build documents in their arenas
+
+        Has to be set before the first Feed() after construction or Reset().
+
+        @see Parser::UseArena(bool)
+    */
+    void        UseArena(bool value);
+    /** Add prune rule
+
+        Has to be called before the first Feed().
+
+        @see Parser::AddPruneRule(const std::string&)
+    */
+    bool        AddPruneRule(const std::string& selector);
+    /** Remove all prune rules */
+    void        ClearPruneRules();
+    /** Set resource limits
+
+        Has to be set before the first Feed(). The input length limit
+        counts all fed bytes, data past it is ignored.
+
+        @see Parser::Limits(const ParseLimits&)
+    */
+    void        Limits(const ParseLimits& limits);
+    /** Set encoding hint
+
+        Has to be set before the first Feed().
+
+        @see Parser::EncodingHint(Encoding)
+    */
+    void        EncodingHint(Encoding encoding);
+    /** Transcode documents to UTF-8
+
+        Enabled by default. Has to be set before the first Feed().
+
+        @see Parser::Transcode(bool)
+    */
+    void        Transcode(bool value);
+
+    //Other
+    /** Prepare for another document
+
+        Options, prune rules and limits are kept, so is memory of the
+        internal buffers. The document is cleared, or kept to be filled
+        over again when reusing.
+    */
+    void        Reset();
+    /** Feed next part of the document
+
+        @param data Pointer to the first character of the part.
+        It has to stay valid only during this call.
+        @param length Length of the part in bytes.
+        @return False if the document turned out to be ill formed,
+        true otherwise.
+    */
+    bool        Feed(const char* data, size_t length);
+    /** Finish parsing
+
+        Parses whatever is left in the buffer as the end of the document.
+
+        @return False if the document turned out to be ill formed,
+        true otherwise.
+    */
+    bool        Finish();
+
+protected:
+    bool        silent_;
+    bool        errorReported_;
+    bool        reuse_;
+    /** Handler receiving events, domBuilder_ when building a document */
+    Handler*    handler_;
+    Document    document_;
+    DomBuilder  domBuilder_;
+    Tokenizer   tokenizer_;
+    TreeBuilder treeBuilder_;
+    std::string buffer_;
+    size_t      retrySize_;
+    /** Offset of the first character not processed yet */
+    size_t      offset_;
+    /** Number of bytes fed so far */
+    size_t      received_;
+    /** True if the fed data exceeded the input length limit */
+    bool        inputExceeded_;
+    Encoding    encodingHint_;
+    bool        transcode_;
+    Encoding    encoding_;
+    /** Beginning of the document, kept until its encoding is known */
+    std::string sniffed_;
+    /** Incomplete character at the end of the last part */
+    std::string carry_;
+    /** Last part transcoded to UTF-8 */
+    std::string transcoded_;
+
+    /** Parse UTF-8 data
+
+        @param data Pointer to the first character of the data.
+        @param length Length of the data in bytes.
+        @return False if the document turned out to be ill formed,
+        true otherwise.
+    */
+    bool        Process(const char* data, size_t length);
+    /** Detect encoding of the sniffed data and parse it
+
+        @return False if the document turned out to be ill formed,
+        true otherwise.
+    */
+    bool        DetectEncoding();
+    /** Transcode data to UTF-8 and parse it
+
+        @param data Pointer to the first character of the data.
+        @param length Length of the data in bytes.
+        @param partial Use true if more data will follow, an incomplete
+        character at the end is then kept until the next part.
+        @return False if the document turned out to be ill formed,
+        true otherwise.
+    */
+    bool        TranscodePart(const char* data, size_t length, bool partial);
+    /** Tokenize and process as much of given data as possible
+
+        @param data Pointer to the first character of the data.
+        @param length Length of the data in bytes.
+        @param partial Use true if more data will follow.
+        @return Pointer to the first character which was not processed.
+    */
+    const char* Run(const char* data, size_t length, bool partial);
+    /** Check for errors
+
+        Prints unexpected tag or exceeded limit error message once,
+        if parser doesn't run in silent mode.
+
+        @return False if the tree builder failed or the input length limit
+        was exceeded without truncating, true otherwise.
+    */
+    bool        CheckError();
+
+private:
+};
+}
+
+#endif // PUSHPARSER_H
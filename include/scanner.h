@@ -0,0 +1,59 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <stddef.h>
+
+namespace idogaf
+{
+/** Vectorized delimiter scanner
+
+    Finds the first occurrence of any character from a small set
+    in a character range. The tokenizer looks for '<' and '&' in text
+    and raw text bodies, and for '>' and quotes in tags.
+    Depending on the CPU the search runs 32 bytes at a time (AVX2),
+    16 bytes at a time (SSE2) or one byte at a time (scalar fallback).
+    The implementation is picked once, at the first use of any scanner.
+*/
+class Scanner
+{
+public:
+    /** Maximum number of characters a scanner can look for */
+    static const size_t kMaxChars = 8;
+
+    /** Character set constructor
+
+        @param chars Null-terminated string with characters to look for.
+        Only the first kMaxChars characters are used.
+    */
+    explicit Scanner(const char* chars);
+    /** Default destructor */
+    ~Scanner() = default;
+
+    //Other
+    /** Find first character from the set
+
+        @param begin Pointer to the first character of the range.
+        @param end Pointer one past the last character of the range.
+        @return Pointer to the first character from the set found inside
+        the range, or end if there is none.
+    */
+    const char* Find(const char* begin, const char* end) const;
+    /** Get name of the instruction set used by scanners
+
+        @return "avx2", "sse2" or "scalar".
+    */
+    static const char* GetInstructionSet();
+
+protected:
+    char    chars_[kMaxChars];
+    size_t  count_;
+    bool    table_[256];
+
+private:
+};
+}
+
+#endif // SCANNER_H
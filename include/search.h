@@ -28,7 +28,7 @@ public:
         @param query CSS selector query.
         @return Vector containg every element matching given query.
     */
-    static Vector_E Find(Element root, const std::string& query);
+    static Vector_E Find(const Element& root, const std::string& query);
     /** Find elements in a tree
 
         This function uses CSS selectors to search for elements
@@ -40,9 +40,6 @@ public:
         execution the tree is modified (possibly resulting in the
         invalidation of some pointers), the result of the function is
         undefined and possibility of a segmentation fault exists.
-        Warning: Currently this will also search in root elements right
-        siblings and it's ancestors right siblings and their children.
-        Use Search::Find() for stable results.
 
         @param root Pointer to the root element of the tree to search in.
         @param query CSS selector query.
@@ -63,27 +60,86 @@ public:
         @param vec Vector containing root elements of the trees to search in.
         @return query CSS selector query.
     */
-    static Vector_E FindInVector(Vector_E vec, const std::string& query);
+    static Vector_E FindInVector(const Vector_E& vec, const std::string& query);
 
 protected:
 
 private:
+    /** Matches elements of its arrays against parsed queries */
+    friend class FlatDocument;
+
+    /** Simple selector, parsed once for all the elements it's checked
+        against */
+    struct Selector
+    {
+        /** '.', '#', '[' or 0 for a tag name */
+        char        type;
+        /** Attribute operator: '=', '~', '|', '^', '$', '*'
+            or 0 if the attribute only has to be present */
+        char        op;
+        /** Atom of the tag or attribute name */
+        Atom        atom;
+        /** Tag, class, id or attribute name, "*" for any */
+        std::string name;
+        /** Attribute value to compare with, without quotes */
+        std::string value;
+    };
+    /** Simple selector with the separator following it */
+    struct Step
+    {
+        Selector    selector;
+        /** False if the selector can't match any element */
+        bool        valid;
+        /** ' ', '>', '+', '~' or 0 if the next selector checks the same
+            elements */
+        char        separator;
+    };
+    typedef std::vector<Step>   Complex;
+
+    /** Parse query
+
+        Splits comma separated complex queries into simple selectors
+        and separators.
+
+        @param query CSS selector query.
+        @param complexesOut Output parameter, filled with one complex
+        query per comma separated part of the query.
+    */
+    static void ParseQuery(const std::string& query,
+                           std::vector<Complex>& complexesOut);
     /** Run single query */
-    static Set_P RunQuery(Set_P elements, const std::string& query);
+    static Set_P RunQuery(Set_P elements, const Selector& selector);
+    /** Parse single query
+
+        @param query Single query to parse.
+        @param selectorOut Output parameter, filled with the selector.
+        @return False if the query can't match any element.
+    */
+    static bool ParseSelector(const std::string& query, Selector& selectorOut);
     /** Check element for a single query
 
+        Nothing is copied or allocated, so it's cheap to check every
+        element of a tree.
+
         @param element Pointer to the element to check.
-        @param query Single query to check.
+        @param selector Parsed single query to check.
         @return True if the element matches the query, false otherwise.
     */
-    static bool CheckElement(Element* element, const std::string& query);
+    static bool CheckElement(Element* element, const Selector& selector);
     /** Check multiple elements for a single query
 
         @param elements Set of pointers to the Element objects to check.
-        @param query Single query to check.
+        @param selector Parsed single query to check.
         @return Vector of pointers to the elements matching the query.
     */
-    static Set_P CheckElements(Set_P elements, const std::string& query);
+    static Set_P CheckElements(Set_P elements, const Selector& selector);
+    /** Check if element belongs to a tree
+
+        @param element Pointer to the element to check.
+        @param root Pointer to the root element of the tree.
+        @return True if the element is the root or one of its descendants.
+    */
+    static bool IsInTree(Element* element, Element* root);
     /** Process separator
 
         Processes elements against one of the separators:
@@ -113,21 +169,14 @@ private:
     static Set_P _preceded(Set_P elements);
 
     //Single selectors
-    static bool _ofClass(Element* e, const std::string& name);
-    static bool _hasId(Element* e, const std::string& name);
-    static bool _hasAttribute(Element* e, const std::string& name);
-    static bool _hasValue(Element* e, const std::string& name,
-                          const std::string& value);
-    static bool _hasWord(Element* e, const std::string& name,
-                         const std::string& word);
-    static bool _startingWith(Element* e, const std::string& name,
-                              const std::string& phrase);
-    static bool _beginingWith(Element* e, const std::string& name,
-                              const std::string& phrase);
-    static bool _endingWith(Element* e, const std::string& name,
-                            const std::string& phrase);
-    static bool _hasSubstr(Element* e, const std::string& name,
-                           const std::string& substring);
+    static bool _ofClass(const StringView& classes, const std::string& name);
+    static bool _hasId(const StringView& id, const std::string& name);
+    /** Check attribute value against an attribute selector
+        @param selector Attribute selector.
+        @param value Value of the attribute.
+        @return True if the value meets the operator of the selector.
+    */
+    static bool CheckValue(const Selector& selector, const StringView& value);
 };
 }
 
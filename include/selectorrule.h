@@ -0,0 +1,124 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef SELECTORRULE_H
+#define SELECTORRULE_H
+
+#include <string>
+#include <vector>
+
+#include "atom.h"
+#include "stringview.h"
+#include "tokenizer.h"
+
+namespace idogaf
+{
+/** Rule selecting elements by their start tags
+
+    Used by the tree builder to pick elements to prune and elements ending
+    the parse early, before any of them is built. A rule is a simple CSS
+    selector: an optional tag name followed by any number of class (.name),
+    id (#name) and attribute ([name], [name=value], [name~=value],
+    [name|=value], [name^=value], [name$=value] or [name*=value])
+    conditions, i.e. "svg", ".ad-slot", "div#banner" or "[aria-hidden=true]".
+    An element matches if all conditions are met.
+*/
+class SelectorRule
+{
+public:
+    /** Default constructor
+
+        Constructs an invalid rule, which matches nothing.
+    */
+    SelectorRule();
+    /** Selector constructor
+
+        @param selector Simple CSS selector. Check Valid() to see if it
+        was understood.
+    */
+    explicit SelectorRule(const std::string& selector);
+    /** Default destructor */
+    ~SelectorRule() = default;
+
+    //Getters
+    /** Check if the rule is valid
+        @return True if the selector was understood, false otherwise.
+    */
+    bool                Valid() const;
+    /** Get selector of the rule
+        @return Selector the rule was constructed from.
+    */
+    const std::string&  GetSelector() const;
+
+    //Other
+    /** Check start tag against the rule
+
+        @param token Start tag token.
+        @return True if the element started by the token matches the rule,
+        false otherwise.
+    */
+    bool                Matches(const Token& token) const;
+    /** Check element against the rule
+
+        @param atom Atom of the element name.
+        @param name Element name.
+        @param attributeNames Names of the attributes of the element.
+        @param attributeValues Values of the attributes, in the order
+        of attributeNames.
+        @param count Number of attributes.
+        @return True if the element matches the rule, false otherwise.
+    */
+    bool                Matches(Atom atom, const StringView& name,
+                                const StringView* attributeNames,
+                                const StringView* attributeValues,
+                                size_t count) const;
+
+protected:
+    /** Kind of a condition */
+    enum class ConditionType
+    {
+        kClass,     ///< Class list contains a word
+        kId,        ///< Id is equal to a value
+        kAttribute, ///< Attribute is present
+        kValue,     ///< Attribute is equal to a value
+        kWord,      ///< Attribute is a space separated list containing a word
+        kDashPrefix,///< Attribute is equal to a value or starts with value-
+        kPrefix,    ///< Attribute starts with a value
+        kSuffix,    ///< Attribute ends with a value
+        kSubstring  ///< Attribute contains a value
+    };
+    /** Single class, id or attribute condition */
+    struct Condition
+    {
+        ConditionType   type;
+        std::string     name;
+        std::string     value;
+    };
+
+    std::string             selector_;
+    bool                    valid_;
+    /** Atom of the tag name, kNoAtom for any or non-standard name */
+    Atom                    atom_;
+    /** Tag name, empty for any name */
+    std::string             name_;
+    std::vector<Condition>  conditions_;
+
+    /** Parse the selector into conditions
+        @return True if the selector was understood, false otherwise.
+    */
+    bool                Parse();
+    /** Check single condition against attributes of a start tag */
+    bool                Check(const Condition& condition,
+                              const Token& token) const;
+    /** Check single condition against one attribute
+        @return True if the attribute meets the condition.
+    */
+    static bool         CheckAttribute(const Condition& condition,
+                                       const StringView& name,
+                                       const StringView& value);
+
+private:
+};
+}
+
+#endif // SELECTORRULE_H
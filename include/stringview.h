@@ -0,0 +1,112 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef STRINGVIEW_H
+#define STRINGVIEW_H
+
+#include <stddef.h>
+#include <string.h>
+#include <string>
+
+namespace idogaf
+{
+/** Non-owning view of a character range
+
+    Points into memory owned by someone else (i.e. the parsed input),
+    so creating and copying it never allocates. The viewed memory has to
+    outlive the view.
+*/
+class StringView
+{
+public:
+    /** Default constructor
+
+        Constructs an empty view.
+    */
+    constexpr StringView() : data_(nullptr), length_(0) {}
+    /** Range constructor
+
+        @param data Pointer to the first character.
+        @param length Number of characters.
+    */
+    constexpr StringView(const char* data, size_t length)
+        : data_(data), length_(length) {}
+    /** Pointer pair constructor
+
+        @param begin Pointer to the first character.
+        @param end Pointer one past the last character.
+    */
+    StringView(const char* begin, const char* end)
+        : data_(begin), length_(static_cast<size_t>(end - begin)) {}
+    /** C string constructor
+
+        @param str Null-terminated string to view.
+    */
+    StringView(const char* str) : data_(str), length_(strlen(str)) {}
+    /** String constructor
+
+        @param str String to view.
+    */
+    StringView(const std::string& str) : data_(str.data()), length_(str.length()) {}
+
+    //Getters
+    const char* GetData() const { return data_; }
+    size_t      GetLength() const { return length_; }
+    bool        Empty() const { return length_ == 0; }
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + length_; }
+    char        operator[](size_t position) const { return data_[position]; }
+    /** Get copy of the viewed characters
+        @return String containing copy of the viewed characters.
+    */
+    std::string ToString() const { return std::string(data_, length_); }
+
+    //Other
+    bool        Equals(const StringView& other) const
+    {
+        return length_ == other.length_
+               && (length_ == 0 || memcmp(data_, other.data_, length_) == 0);
+    }
+
+protected:
+    const char* data_;
+    size_t      length_;
+
+private:
+};
+
+inline bool operator==(const StringView& lhs, const StringView& rhs)
+{
+    return lhs.Equals(rhs);
+}
+inline bool operator!=(const StringView& lhs, const StringView& rhs)
+{
+    return !lhs.Equals(rhs);
+}
+inline bool operator==(const StringView& lhs, const std::string& rhs)
+{
+    return lhs.Equals(StringView(rhs));
+}
+inline bool operator!=(const StringView& lhs, const std::string& rhs)
+{
+    return !lhs.Equals(StringView(rhs));
+}
+inline bool operator==(const std::string& lhs, const StringView& rhs)
+{
+    return rhs.Equals(StringView(lhs));
+}
+inline bool operator!=(const std::string& lhs, const StringView& rhs)
+{
+    return !rhs.Equals(StringView(lhs));
+}
+inline bool operator==(const StringView& lhs, const char* rhs)
+{
+    return lhs.Equals(StringView(rhs));
+}
+inline bool operator!=(const StringView& lhs, const char* rhs)
+{
+    return !lhs.Equals(StringView(rhs));
+}
+}
+
+#endif // STRINGVIEW_H
@@ -36,7 +36,8 @@ public:
     Style(const Style& other);
     /** Attribute-based constructor
 
-        Copies values from the attribute.
+        Copies values from the attribute. The value is always copied and
+        split into style declarations, even if the attribute holds a span.
 
         @param attribute Attribute to copy values from.
     */
@@ -46,6 +47,15 @@ public:
         @return A reference to this
      */
     Style& operator=(const Style& other);
+    /** Move constructor
+        @param other Object to move from, left empty
+     */
+    Style(Style&& other) noexcept;
+    /** Move assignment operator
+        @param other Object to move from, left empty
+        @return A reference to this
+     */
+    Style& operator=(Style&& other) noexcept;
 
     //Getters
     static std::string GetStaticName();
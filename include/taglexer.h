@@ -0,0 +1,83 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef TAGLEXER_H
+#define TAGLEXER_H
+
+#include "stringview.h"
+
+namespace idogaf
+{
+/** Single-pass lexer for the inside of a tag
+
+    Splits everything between '<' and '>' (or '/>') into a tag name and
+    name-value pairs of attributes. Double-quoted, single-quoted and
+    unquoted values are supported, as well as whitespaces around '='.
+    Names and values are returned as views into the lexed memory, so
+    lexing never allocates.
+*/
+class TagLexer
+{
+public:
+    /** Range constructor
+
+        Lexes the tag name right away.
+
+        @param begin Pointer to the first character after '<'.
+        @param end Pointer to the '>' (or '/>') ending the tag.
+    */
+    TagLexer(const char* begin, const char* end);
+    /** Already lexed name constructor
+
+        Constructs a lexer for a tag, which name was already found.
+
+        @param name View of the tag name.
+        @param attributes View of everything after the tag name
+        up to '>' or '/>'.
+    */
+    TagLexer(const StringView& name, const StringView& attributes);
+    /** Default destructor */
+    ~TagLexer() = default;
+
+    //Getters
+    /** Get tag name
+        @return View of the tag name or an empty view if the tag has no name.
+    */
+    StringView  GetName() const;
+
+    //Other
+    /** Lex next attribute
+
+        @param nameOut Output parameter, set to the name of the attribute.
+        @param valueOut Output parameter, set to the value of the attribute
+        without quotes, or an empty view if the attribute has no value.
+        @return True if an attribute was found, false if the end of the tag
+        was reached.
+    */
+    bool        NextAttribute(StringView& nameOut, StringView& valueOut);
+    /** Lex next attribute and check its value for character references
+
+        @param nameOut Output parameter, set to the name of the attribute.
+        @param valueOut Output parameter, set to the value of the attribute
+        without quotes, or an empty view if the attribute has no value.
+        @param referencesOut Output parameter, set to true if the value
+        contains '&'.
+        @return True if an attribute was found, false if the end of the tag
+        was reached.
+    */
+    bool        NextAttribute(StringView& nameOut, StringView& valueOut,
+                              bool& referencesOut);
+
+protected:
+    const char* cursor_;
+    const char* end_;
+    StringView  name_;
+
+    /** Move cursor past whitespaces */
+    void        SkipSpaces();
+
+private:
+};
+}
+
+#endif // TAGLEXER_H
@@ -0,0 +1,215 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <stddef.h>
+
+#include "atom.h"
+#include "stringview.h"
+
+namespace idogaf
+{
+
+/** Kind of a token returned by the Tokenizer */
+enum class TokenType
+{
+    kText,      ///< Trimmed text between tags
+    kStartTag,  ///< Opening tag (<tag>) or empty tag (<tag/>)
+    kEndTag,    ///< Closing tag (</tag>)
+    kComment,   ///< Comment (<!-- -->)
+    kDoctype    ///< Doctype (<!DOCTYPE >)
+};
+
+/** Single token of a html document
+
+    Every view points into the tokenized memory.
+*/
+struct Token
+{
+    TokenType   type = TokenType::kText;
+    /** Tag name, only for kStartTag and kEndTag tokens */
+    StringView  name;
+    /** Atom of the tag name, kNoAtom for non-standard names */
+    Atom        atom = kNoAtom;
+    /** Everything after the tag name up to '>' or '/>',
+        only for kStartTag tokens */
+    StringView  attributes;
+    /** Trimmed text of a kText token, body of a kComment token,
+        trimmed value of a kDoctype token or trimmed body of a raw text
+        element (kTagRawText property) for kStartTag tokens */
+    StringView  text;
+    /** True if text contains '&', so it may hold character references.
+        Found by the scan looking for the end of the text */
+    bool        references = false;
+    /** True if a kStartTag token was an empty tag (<tag/>) */
+    bool        selfClosing = false;
+    /** True if a kStartTag token is a raw text element, its body is
+        in text and no separate closing tag follows */
+    bool        rawText = false;
+    /** Whole token as it appears in the input, from its first character
+        up to the first character of whatever follows it */
+    StringView  source;
+    /** Offset of the first character of source from the beginning
+        of the document, in bytes */
+    size_t      offset = 0;
+};
+
+/** Html tokenizer
+
+    Splits a document held in memory into tokens. The tokenizer works
+    directly on the given memory with vectorized scanning, nothing is
+    copied. Whitespace-only text is not returned as a token. Bodies of
+    raw text elements (script, style, textarea, title and xmp) are returned
+    together with their opening tag.
+*/
+class Tokenizer
+{
+public:
+    /** Default constructor
+
+        Constructs a tokenizer with no input.
+    */
+    Tokenizer();
+    /** Range constructor
+
+        @param data Pointer to the first character of the input.
+        @param length Length of the input in bytes.
+    */
+    Tokenizer(const char* data, size_t length);
+    /** Default destructor */
+    ~Tokenizer() = default;
+
+    //Getters
+    /** Get position of the tokenizer
+        @return Pointer to the first character that was not tokenized yet.
+    */
+    const char* GetPosition() const;
+    /** Check if the whole input was tokenized
+        @return True if there are no more tokens, false otherwise.
+    */
+    bool        AtEnd() const;
+    /** Get offset of the tokenizer
+        @return Offset of the first character that was not tokenized yet
+        from the beginning of the document.
+    */
+    size_t      GetOffset() const;
+    bool        AllowMistypedCommentTags() const;
+
+    //Setters
+    /** Set new input
+
+        Replaces the input and resets its offset to 0. A document tokenized
+        in parts should give the offset of every part with SetOffset().
+
+        @param data Pointer to the first character of the input.
+        @param length Length of the input in bytes.
+        @param partial Use true if the input is only a part of the document
+        and more of it will follow. A token which is not complete at the end
+        of a partial input is not returned, the tokenizer stops at its
+        beginning instead.
+    */
+    void        SetInput(const char* data, size_t length, bool partial = false);
+    /** Set tokenizing limit
+
+        Tokens starting at or after the limit are not returned, but the last
+        token starting before it is returned whole, even if it goes past
+        the limit. Reset to the end of the input by SetInput().
+
+        @param limit Pointer inside the input.
+    */
+    void        SetLimit(const char* limit);
+    /** Set offset of the input
+
+        @param offset Offset of the first character of the input from
+        the beginning of the document, added to offsets of all tokens.
+    */
+    void        SetOffset(size_t offset);
+    /** Allow mistyped comment tags
+
+        Setting this to true will result in treating "<! --" string as a start
+        of a comment.
+
+        @param value Use true to enable this option and false to disable.
+    */
+    void        AllowMistypedCommentTags(bool value);
+
+    //Other
+    /** Read next token
+
+        @param tokenOut Output parameter, set to the next token.
+        @return True if a token was read, false if the input ended
+        or the rest of a partial input is an incomplete token.
+    */
+    bool        Next(Token& tokenOut);
+
+protected:
+    const char* begin_;
+    const char* cursor_;
+    const char* end_;
+    const char* limit_;
+    /** Offset of begin_ from the beginning of the document */
+    size_t      offset_;
+    bool        partial_;
+    bool        allowMistypedCommentTags_;
+
+    /** Give up on an incomplete token
+
+        Moves the tokenizer back to the beginning of the token.
+
+        @param tokenBegin Pointer to the first character of the token.
+        @return Always false.
+    */
+    bool        Incomplete(const char* tokenBegin);
+
+    /** Find beginning of the next tag
+
+        Scans a text run for the next '<' character.
+
+        @param cursor Pointer to the first character of the text run.
+        @param referencesOut Output parameter, set to true if the text run
+        contains '&'.
+        @return Pointer to the next '<' or end of the input if there is none.
+    */
+    const char* FindTagBegin(const char* cursor, bool& referencesOut) const;
+    /** Find end of a tag
+
+        Scans a tag body for the closing '>' character. Quoted attribute
+        values are skipped, so they can contain '>'.
+
+        @param tagBegin Pointer to the '<' character starting the tag.
+        @return Pointer to the closing '>' or end of the input if the tag
+        is unterminated.
+    */
+    const char* FindTagEnd(const char* tagBegin) const;
+    /** Find end of a comment
+
+        @param begin Pointer to the first character after '<!'.
+        @return Pointer to the '>' of the closing "-->" or end of the input
+        if the comment is unterminated.
+    */
+    const char* FindCommentEnd(const char* begin) const;
+    /** Find end of a raw text element body
+
+        Looks for the closing tag of a raw text element (kTagRawText
+        property), ignoring letter case. Only '<' and '&' characters stop
+        the vectorized scan.
+
+        @param atom Atom of the element name.
+        @param begin Pointer to the first character of the body.
+        @param cursorOut Output parameter, set to the first character after
+        the closing tag.
+        @param referencesOut Output parameter, set to true if the body
+        contains '&'.
+        @return Pointer one past the last character of the body.
+    */
+    const char* FindRawTextEnd(Atom atom, const char* begin,
+                               const char*& cursorOut,
+                               bool& referencesOut) const;
+
+private:
+};
+}
+
+#endif // TOKENIZER_H
@@ -0,0 +1,137 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef TOKENREADER_H
+#define TOKENREADER_H
+
+#include <stddef.h>
+
+#include "stringview.h"
+#include "taglexer.h"
+#include "tokenizer.h"
+
+namespace idogaf
+{
+/** Pull parser over a document held in memory
+
+    Walks the tokens of a document one at a time, as the caller advances
+    it with Next(). Tokens are reported as they appear in the document,
+    omitted closing tags are not implied. Names, attributes and text are
+    views into the given memory, which has to outlive the reader.
+    Nothing is allocated while reading.
+
+    Example:
+    @code
+    TokenReader reader(data, length);
+    while(reader.Next())
+    {
+        if(reader.GetType() != TokenType::kStartTag) continue;
+        if(reader.GetName() == "nav") reader.SkipSubtree();
+        ...
+    }
+    @endcode
+*/
+class TokenReader
+{
+public:
+    /** Range constructor
+
+        @param data Pointer to the first character of the document.
+        @param length Length of the document in bytes.
+    */
+    TokenReader(const char* data, size_t length);
+    /** Default destructor */
+    ~TokenReader() = default;
+
+    //Getters
+    /** Get the current token
+        @return Reference to the current token.
+    */
+    const Token&    GetToken() const;
+    /** Get kind of the current token
+        @return Type of the current token.
+    */
+    TokenType   GetType() const;
+    /** Get tag name of the current token
+        @return Tag name for start and end tags, empty view otherwise.
+    */
+    StringView  GetName() const;
+    /** Get text of the current token
+
+        @return Trimmed text for text tokens, body of a comment, value
+        of a doctype or trimmed body of a raw text element start tag.
+        Empty view otherwise.
+    */
+    StringView  GetText() const;
+    /** Get attributes of the current token
+
+        @return Lexer positioned at the first attribute of the current
+        start tag, use TagLexer::NextAttribute() to read them.
+    */
+    TagLexer    GetAttributes() const;
+    /** Get value of an attribute of the current token by name
+
+        @param name Name of the attribute to find.
+        @param valueOut Output parameter, set to the value of the attribute
+        if it was found.
+        @return True if the current token is a start tag with a given
+        attribute, false otherwise.
+    */
+    bool        GetAttribute(const StringView& name, StringView& valueOut) const;
+    /** Check if the current token starts an element without contents
+
+        @return True if the current token is an empty tag (<tag/>),
+        a singleton tag (i.e. <br>) or a raw text element (i.e. <script>)
+        with its body included,
+        false otherwise.
+    */
+    bool        IsEmptyElement() const;
+    /** Get position of the reader
+        @return Pointer to the first character after the current token.
+    */
+    const char* GetPosition() const;
+    bool        AllowMistypedCommentTags() const;
+
+    //Setters
+    /** Allow mistyped comment tags
+
+        Setting this to true will result in treating "<! --" string as a start
+        of a comment.
+
+        @param value Use true to enable this option and false to disable.
+    */
+    void        AllowMistypedCommentTags(bool value);
+
+    //Other
+    /** Advance to the next token
+
+        @return True if the reader moved to the next token,
+        false if the document ended.
+    */
+    bool        Next();
+    /** Skip contents of the current element
+
+        If the current token is a start tag, advances the reader to the
+        matching end tag, without looking into anything in between but
+        names of the nested tags. Nested elements with the same name are
+        balanced. Names are compared like the tree builder does it, letter
+        case included, so <DIV> is not closed by </div>. If the current token
+        is an empty element or not a start tag, the reader doesn't move.
+        Omitted end tags are not implied, so skipping an element whose end
+        tag may be left out (i.e. <p> or <li>) without one in the document
+        skips to the end of the document.
+
+        @return True if the reader is at the matching end tag or didn't
+        have to move, false if the document ended before the end tag.
+    */
+    bool        SkipSubtree();
+
+protected:
+    Tokenizer   tokenizer_;
+    Token       token_;
+
+private:
+};
+}
+
+#endif // TOKENREADER_H
@@ -0,0 +1,291 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef TREEBUILDER_H
+#define TREEBUILDER_H
+
+#include <string>
+#include <vector>
+
+#include "atom.h"
+#include "handler.h"
+#include "parselimits.h"
+#include "selectorrule.h"
+#include "tokenizer.h"
+
+namespace idogaf
+{
+/** Tree construction stage of the parser
+
+    Turns tokens into start tag, end tag, text, comment and doctype events
+    for a Handler. Decides which elements are empty and where omitted
+    closing tags are implied, so every consumer of the events sees
+    the same tree. Only names of the currently open elements are kept,
+    so memory use is proportional to the depth of the document.
+*/
+class TreeBuilder
+{
+public:
+    /** Maximum number of stop conditions */
+    static const size_t kMaxStopConditions = 32;
+
+    /** Handler constructor
+
+        @param handler Handler to send events to.
+    */
+    TreeBuilder(Handler& handler);
+    /** Default destructor */
+    ~TreeBuilder() = default;
+
+    //Getters
+    /** Check if the tree builder failed
+        @return True if an unexpected tag was found or a limit was exceeded
+        without truncating, false otherwise.
+    */
+    bool        Failed() const;
+    /** Check if the tree builder finished
+        @return True if the root element was closed, the handler asked
+        to stop or the tree builder failed, false otherwise.
+    */
+    bool        Finished() const;
+    /** Get name of the unexpected tag
+        @return Name of the tag which made the tree builder fail or
+        an empty string if it didn't fail.
+    */
+    const std::string&  GetErrorTag() const;
+    /** Get current offset
+
+        Use LineIndex to turn it into a line number.
+
+        @return Offset of the last processed token from the beginning
+        of the document, the unexpected tag if the tree builder failed.
+    */
+    size_t      GetOffset() const;
+    /** Get number of open elements
+        @return Number of elements which were started but not ended yet.
+    */
+    size_t      GetDepth() const;
+    bool        SkipUnnecessaryClosingTags() const;
+    const std::vector<SelectorRule>&   GetPruneRules() const;
+    /** Check if stop conditions were met
+        @return True if the tree builder finished, because all stop
+        conditions were met, false otherwise.
+    */
+    bool        Stopped() const;
+    /** Get offset at which stop conditions were met
+        @return Offset one past the end of the element which met the last
+        stop condition or 0 if the tree builder didn't stop.
+    */
+    size_t      GetStopOffset() const;
+    const ParseLimits&  Limits() const;
+    /** Get exceeded limit
+        @return Limit which made the tree builder fail or truncate
+        the document, Limit::kNone if no limit was exceeded.
+    */
+    Limit       GetExceededLimit() const;
+
+    //Setters
+    /** Skip unnecessary closing tags
+
+        Setting this to true will allow parsing without failing,
+        if a misplaced closing tag was found.
+
+        @param value Use true to enable this option and false to disable.
+    */
+    void        SkipUnnecessaryClosingTags(bool value);
+    /** Add prune rule
+
+        Elements matching any of the prune rules are left out together
+        with their contents, no events are sent for them. Their contents
+        are skipped by counting start and end tags of the same name only.
+        A pruned element also ends at a closing tag of any open element.
+        The root element is never pruned.
+
+        @param rule Rule to add, invalid rules are ignored.
+    */
+    void        AddPruneRule(const SelectorRule& rule);
+    /** Remove all prune rules */
+    void        ClearPruneRules();
+    /** Add stop condition
+
+        The tree builder finishes once every stop condition is met, that is
+        a given number of elements matching its rule were closed. Elements
+        which are still open then get end tag events with an empty source
+        range at the stop offset, so the events still form a complete tree.
+
+        @param rule Rule selecting elements to count.
+        @param count Number of matching elements to wait for.
+        @return True if the condition was added, false if the rule is
+        invalid, count is 0 or there are already kMaxStopConditions
+        conditions.
+    */
+    bool        AddStopCondition(const SelectorRule& rule, size_t count = 1);
+    /** Remove all stop conditions */
+    void        ClearStopConditions();
+    /** Set resource limits
+
+        Limits are checked at every start tag and text token, before
+        anything is sent to the handler. A token exceeding a limit either
+        makes the tree builder fail or, if limits truncate, finish as if
+        the document ended right before it. The input length limit is left
+        to the caller.
+
+        @param limits Limits to use.
+    */
+    void        Limits(const ParseLimits& limits);
+
+    //Other
+    /** Prepare for another document
+
+        Resets the state of the tree builder, but keeps its options, rules,
+        limits and memory of the stack of open elements.
+
+        @param handler Handler to send events to.
+    */
+    void        Reset(Handler& handler);
+    /** Process next token
+
+        @param token Token to process.
+        @return True if more tokens are expected, false if the tree builder
+        finished.
+    */
+    bool        Process(const Token& token);
+    /** Finish processing
+
+        Sends end tag events for all elements which are still open.
+        Should be called after the input ended.
+    */
+    void        Finish();
+
+protected:
+    /** Rule ending the parse after a number of matches */
+    struct StopCondition
+    {
+        SelectorRule    rule;
+        size_t          count;
+        /** Number of matching elements closed so far */
+        size_t          found;
+    };
+
+    Handler*                    handler_;
+    /** Names of open elements, set only for non-standard names */
+    std::vector<std::string>    stack_;
+    /** Atoms of names of open elements */
+    std::vector<Atom>           atoms_;
+    size_t                      depth_;
+    /** Offset of the processed token */
+    size_t                      offset_;
+    /** Offset one past the end of the processed token */
+    size_t                      endOffset_;
+    bool                        textSinceTag_;
+    bool                        finished_;
+    bool                        failed_;
+    bool                        skipUnnecessaryClosingTags_;
+    std::string                 errorTag_;
+    /** Atom of the processed tag name */
+    Atom                        atom_;
+    /** Processed tag name, set only for non-standard names */
+    std::string                 name_;
+    std::vector<SelectorRule>   pruneRules_;
+    /** Number of open elements named as the pruned one,
+        0 if nothing is pruned */
+    size_t                      pruneDepth_;
+    Atom                        pruneAtom_;
+    /** Name of the pruned element, set only for non-standard names */
+    std::string                 pruneName_;
+    std::vector<StopCondition>  stopConditions_;
+    /** Masks of stop conditions matched by open elements */
+    std::vector<unsigned int>   stopMarks_;
+    bool                        stopped_;
+    size_t                      stopOffset_;
+    ParseLimits                 limits_;
+    Limit                       exceededLimit_;
+    /** Number of elements started so far */
+    size_t                      nodes_;
+    /** Length of text processed so far */
+    size_t                      textLength_;
+
+    /** Process start tag token */
+    bool        ProcessStartTag(const Token& token);
+    /** Process end tag token */
+    bool        ProcessEndTag(const Token& token);
+    /** Check start tag against prune rules */
+    bool        IsPruned(const Token& token) const;
+    /** Skip token inside a pruned element
+        @return True if the token was skipped, false if it ended pruning
+        and has to be processed.
+    */
+    bool        Prune(const Token& token);
+    /** Check limits before opening an element
+        @return True if the element can be opened, false if it exceeded
+        a limit.
+    */
+    bool        CheckLimits(const Token& token);
+    /** Count text against the text length limit
+        @return True if the text can be processed, false if it exceeded
+        the limit.
+    */
+    bool        CheckText(size_t length);
+    /** Send start tag event */
+    bool        StartElement(const Token& token);
+    /** Send end tag event for the current element and close it
+
+        @param begin Offset of the closing tag.
+        @param end Offset one past the end of the closing tag, equal
+        to begin for implied closing tags.
+        @return True to continue, false if the handler asked to stop.
+    */
+    bool        EndElement(size_t begin, size_t end);
+    /** Open a new current element named as in atom_ and name_ */
+    void        Push();
+    /** Get name of an open element
+        @param level Depth of the element, 0 for the root.
+        @return View of the name.
+    */
+    StringView  GetName(size_t level) const;
+    /** Check name of an open element
+        @param level Depth of the element, 0 for the root.
+        @param atom Atom of the name to compare with.
+        @param name Name to compare with.
+        @return True if the element has a given name, false otherwise.
+    */
+    bool        HasName(size_t level, Atom atom, const StringView& name) const;
+    /** Count closed element for stop conditions
+        @param marks Mask of stop conditions matched by the element.
+        @return True if all stop conditions are met, false otherwise.
+    */
+    bool        CountMatch(unsigned int marks);
+    /** Finish because stop conditions were met
+        @param offset Offset at which the conditions were met.
+        @return Always false.
+    */
+    bool        StopAt(size_t offset);
+    /** Finish because a limit was exceeded
+
+        Fails or, if limits truncate, closes every open element at the
+        offset of the processed token.
+
+        @param limit Exceeded limit.
+        @return Always false.
+    */
+    bool        Exceed(Limit limit);
+    /** Send end tag events for all open elements
+        @param offset Offset to give the events as their source range.
+    */
+    void        CloseAll(size_t offset);
+    /** Get offset of a position inside a token
+        @param token Token containing the position.
+        @param position Pointer inside the source of the token.
+        @return Offset of the position from the beginning of the document.
+    */
+    static size_t OffsetOf(const Token& token, const char* position);
+    /** Finish with an unexpected tag error */
+    bool        Fail(const StringView& tagName);
+    /** Finish because the handler asked to */
+    bool        Stop();
+
+private:
+};
+}
+
+#endif // TREEBUILDER_H
@@ -0,0 +1,156 @@
+#include "arena.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <utility>
+
+namespace idogaf
+{
+
+Arena::Arena(size_t blockSize)
+{
+    current_ = 0;
+    cursor_ = nullptr;
+    end_ = nullptr;
+    blockSize_ = blockSize == 0 ? kDefaultBlockSize : blockSize;
+    usedBefore_ = 0;
+}
+
+Arena::~Arena()
+{
+    Release();
+}
+
+//Getters
+size_t Arena::GetSize() const
+{
+    if(blocks_.empty()) return 0;
+    return usedBefore_ + (cursor_ - blocks_[current_].data);
+}
+size_t Arena::GetCapacity() const
+{
+    size_t capacity = 0;
+    for(size_t i = 0; i < blocks_.size(); i++)
+        capacity += blocks_[i].size;
+    return capacity;
+}
+size_t Arena::GetBlockCount() const
+{
+    return blocks_.size();
+}
+
+//Other
+void* Arena::Allocate(size_t size, size_t alignment)
+{
+    size_t padding = (alignment - reinterpret_cast<uintptr_t>(cursor_))
+                     & (alignment - 1);
+    if(cursor_ == nullptr || size + padding > static_cast<size_t>(end_ - cursor_))
+    {
+        NextBlock(size + alignment - 1);
+        padding = (alignment - reinterpret_cast<uintptr_t>(cursor_))
+                  & (alignment - 1);
+    }
+    char* ptr = cursor_ + padding;
+    cursor_ = ptr + size;
+    return ptr;
+}
+
+StringView Arena::Store(const StringView& str)
+{
+    if(str.Empty()) return StringView();
+    char* copy = static_cast<char*>(Allocate(str.GetLength(), 1));
+    memcpy(copy, str.begin(), str.GetLength());
+    return StringView(copy, str.GetLength());
+}
+
+StringView Arena::Append(const StringView& str, const StringView& more)
+{
+    if(str.Empty()) return Store(more);
+    if(more.Empty()) return str;
+    if(str.end() == cursor_
+       && more.GetLength() <= static_cast<size_t>(end_ - cursor_))
+    {
+        //Last allocation, extend it in place
+        memcpy(cursor_, more.begin(), more.GetLength());
+        cursor_ += more.GetLength();
+        return StringView(str.begin(), str.GetLength() + more.GetLength());
+    }
+    size_t length = str.GetLength() + more.GetLength();
+    char* copy = static_cast<char*>(Allocate(length, 1));
+    memcpy(copy, str.begin(), str.GetLength());
+    memcpy(copy + str.GetLength(), more.begin(), more.GetLength());
+    return StringView(copy, length);
+}
+
+bool Arena::Contains(const char* ptr) const
+{
+    for(size_t i = 0; i < blocks_.size(); i++)
+        if(ptr >= blocks_[i].data && ptr < blocks_[i].data + blocks_[i].size)
+            return true;
+    return false;
+}
+
+void Arena::Clear()
+{
+    current_ = 0;
+    usedBefore_ = 0;
+    if(blocks_.empty()) return;
+    cursor_ = blocks_[0].data;
+    end_ = cursor_ + blocks_[0].size;
+}
+
+void Arena::Release()
+{
+    for(size_t i = 0; i < blocks_.size(); i++)
+        delete[] blocks_[i].data;
+    blocks_.clear();
+    current_ = 0;
+    cursor_ = nullptr;
+    end_ = nullptr;
+    usedBefore_ = 0;
+}
+
+void Arena::Swap(Arena& other)
+{
+    blocks_.swap(other.blocks_);
+    std::swap(current_, other.current_);
+    std::swap(cursor_, other.cursor_);
+    std::swap(end_, other.end_);
+    std::swap(blockSize_, other.blockSize_);
+    std::swap(usedBefore_, other.usedBefore_);
+}
+
+//Protected member functions
+void Arena::NextBlock(size_t size)
+{
+    if(!blocks_.empty())
+    {
+        usedBefore_ += cursor_ - blocks_[current_].data;
+        //Reuse blocks kept by Clear()
+        while(++current_ < blocks_.size())
+        {
+            if(blocks_[current_].size >= size)
+            {
+                cursor_ = blocks_[current_].data;
+                end_ = cursor_ + blocks_[current_].size;
+                return;
+            }
+        }
+    }
+    //Every block is twice as large as the one before, up to kMaxBlockSize
+    size_t blockSize = blockSize_;
+    if(!blocks_.empty())
+    {
+        blockSize = 2 * blocks_.back().size;
+        if(blockSize > kMaxBlockSize) blockSize = kMaxBlockSize;
+    }
+    if(blockSize < size) blockSize = size;
+    Block block;
+    block.data = new char[blockSize];
+    block.size = blockSize;
+    blocks_.push_back(block);
+    current_ = blocks_.size() - 1;
+    cursor_ = block.data;
+    end_ = cursor_ + blockSize;
+}
+}
@@ -0,0 +1,998 @@
+#include "atom.h"
+
+#include <string.h>
+
+namespace idogaf
+{
+
+/** Name and properties of an atom */
+struct AtomEntry
+{
+    StringView      name;
+    unsigned int    properties;
+};
+
+/** Move groups of tags into the closed by bits */
+static constexpr unsigned int ClosedBy(unsigned int groups)
+{
+    return groups << kTagClosedByShift;
+}
+
+/** Names and properties of atoms, indexed by atom */
+static constexpr AtomEntry kAtomEntries[kAtomCount] = {
+    {StringView(), 0},
+    {StringView("a", 1), kTagElement},
+    {StringView("abbr", 4), kTagElement},
+    {StringView("accept", 6), 0},
+    {StringView("accept-charset", 14), 0},
+    {StringView("accesskey", 9), 0},
+    {StringView("acronym", 7), kTagElement},
+    {StringView("action", 6), 0},
+    {StringView("address", 7), kTagElement | kTagClosesP},
+    {StringView("align", 5), 0},
+    {StringView("alink", 5), 0},
+    {StringView("allow", 5), 0},
+    {StringView("allowfullscreen", 15), 0},
+    {StringView("alt", 3), 0},
+    {StringView("applet", 6), kTagElement},
+    {StringView("archive", 7), 0},
+    {StringView("area", 4), kTagElement | kTagVoid},
+    {StringView("article", 7), kTagElement | kTagClosesP},
+    {StringView("aside", 5), kTagElement | kTagClosesP},
+    {StringView("async", 5), 0},
+    {StringView("audio", 5), kTagElement},
+    {StringView("autocapitalize", 14), 0},
+    {StringView("autocomplete", 12), 0},
+    {StringView("autofocus", 9), 0},
+    {StringView("autoplay", 8), 0},
+    {StringView("b", 1), kTagElement},
+    {StringView("background", 10), 0},
+    {StringView("base", 4), kTagElement | kTagVoid},
+    {StringView("basefont", 8), kTagElement},
+    {StringView("bdi", 3), kTagElement},
+    {StringView("bdo", 3), kTagElement},
+    {StringView("bgcolor", 7), 0},
+    {StringView("bgsound", 7), kTagElement},
+    {StringView("big", 3), kTagElement},
+    {StringView("blink", 5), kTagElement},
+    {StringView("blockquote", 10), kTagElement | kTagClosesP},
+    {StringView("body", 4), kTagElement},
+    {StringView("border", 6), 0},
+    {StringView("br", 2), kTagElement | kTagVoid},
+    {StringView("button", 6), kTagElement},
+    {StringView("canvas", 6), kTagElement},
+    {StringView("caption", 7), kTagElement},
+    {StringView("center", 6), kTagElement},
+    {StringView("charset", 7), 0},
+    {StringView("checked", 7), 0},
+    {StringView("cite", 4), kTagElement},
+    {StringView("class", 5), 0},
+    {StringView("classid", 7), 0},
+    {StringView("clear", 5), 0},
+    {StringView("code", 4), kTagElement},
+    {StringView("codebase", 8), 0},
+    {StringView("col", 3), kTagElement | kTagVoid},
+    {StringView("colgroup", 8), kTagElement},
+    {StringView("color", 5), 0},
+    {StringView("cols", 4), 0},
+    {StringView("colspan", 7), 0},
+    {StringView("command", 7), kTagElement | kTagVoid},
+    {StringView("content", 7), 0},
+    {StringView("contenteditable", 15), 0},
+    {StringView("controls", 8), 0},
+    {StringView("coords", 6), 0},
+    {StringView("crossorigin", 11), 0},
+    {StringView("data", 4), kTagElement},
+    {StringView("datalist", 8), kTagElement},
+    {StringView("datetime", 8), 0},
+    {StringView("dd", 2), kTagElement | kTagOptionalEnd | kTagDtDd | ClosedBy(kTagDtDd)},
+    {StringView("declare", 7), 0},
+    {StringView("decoding", 8), 0},
+    {StringView("default", 7), 0},
+    {StringView("defer", 5), 0},
+    {StringView("del", 3), kTagElement},
+    {StringView("details", 7), kTagElement},
+    {StringView("dfn", 3), kTagElement},
+    {StringView("dialog", 6), kTagElement},
+    {StringView("dir", 3), kTagElement},
+    {StringView("dirname", 7), 0},
+    {StringView("disabled", 8), 0},
+    {StringView("div", 3), kTagElement},
+    {StringView("dl", 2), kTagElement | kTagClosesP},
+    {StringView("download", 8), 0},
+    {StringView("draggable", 9), 0},
+    {StringView("dt", 2), kTagElement | kTagDtDd | ClosedBy(kTagDtDd)},
+    {StringView("em", 2), kTagElement},
+    {StringView("embed", 5), kTagElement | kTagVoid},
+    {StringView("enctype", 7), 0},
+    {StringView("enterkeyhint", 12), 0},
+    {StringView("face", 4), 0},
+    {StringView("fieldset", 8), kTagElement | kTagClosesP},
+    {StringView("figcaption", 10), kTagElement},
+    {StringView("figure", 6), kTagElement},
+    {StringView("font", 4), kTagElement},
+    {StringView("footer", 6), kTagElement | kTagClosesP},
+    {StringView("for", 3), 0},
+    {StringView("form", 4), kTagElement | kTagClosesP},
+    {StringView("formaction", 10), 0},
+    {StringView("formenctype", 11), 0},
+    {StringView("formmethod", 10), 0},
+    {StringView("formnovalidate", 14), 0},
+    {StringView("formtarget", 10), 0},
+    {StringView("frame", 5), kTagElement},
+    {StringView("frameborder", 11), 0},
+    {StringView("frameset", 8), kTagElement},
+    {StringView("h1", 2), kTagElement | kTagClosesP},
+    {StringView("h2", 2), kTagElement | kTagClosesP},
+    {StringView("h3", 2), kTagElement | kTagClosesP},
+    {StringView("h4", 2), kTagElement | kTagClosesP},
+    {StringView("h5", 2), kTagElement | kTagClosesP},
+    {StringView("h6", 2), kTagElement | kTagClosesP},
+    {StringView("head", 4), kTagElement},
+    {StringView("header", 6), kTagElement | kTagClosesP},
+    {StringView("headers", 7), 0},
+    {StringView("height", 6), 0},
+    {StringView("hgroup", 6), kTagElement | kTagClosesP},
+    {StringView("hidden", 6), 0},
+    {StringView("high", 4), 0},
+    {StringView("hr", 2), kTagElement | kTagVoid | kTagClosesP},
+    {StringView("href", 4), 0},
+    {StringView("hreflang", 8), 0},
+    {StringView("hspace", 6), 0},
+    {StringView("html", 4), kTagElement},
+    {StringView("http-equiv", 10), 0},
+    {StringView("i", 1), kTagElement},
+    {StringView("id", 2), 0},
+    {StringView("iframe", 6), kTagElement},
+    {StringView("image", 5), kTagElement},
+    {StringView("img", 3), kTagElement | kTagVoid},
+    {StringView("inert", 5), 0},
+    {StringView("input", 5), kTagElement | kTagVoid},
+    {StringView("inputmode", 9), 0},
+    {StringView("ins", 3), kTagElement},
+    {StringView("integrity", 9), 0},
+    {StringView("is", 2), 0},
+    {StringView("isindex", 7), kTagElement},
+    {StringView("ismap", 5), 0},
+    {StringView("itemid", 6), 0},
+    {StringView("itemprop", 8), 0},
+    {StringView("itemref", 7), 0},
+    {StringView("itemscope", 9), 0},
+    {StringView("itemtype", 8), 0},
+    {StringView("kbd", 3), kTagElement},
+    {StringView("keygen", 6), kTagElement | kTagVoid},
+    {StringView("kind", 4), 0},
+    {StringView("label", 5), kTagElement},
+    {StringView("lang", 4), 0},
+    {StringView("language", 8), 0},
+    {StringView("legend", 6), kTagElement},
+    {StringView("li", 2), kTagElement | kTagOptionalEnd | kTagLi | ClosedBy(kTagLi)},
+    {StringView("link", 4), kTagElement | kTagVoid},
+    {StringView("list", 4), 0},
+    {StringView("listing", 7), kTagElement},
+    {StringView("loading", 7), 0},
+    {StringView("longdesc", 8), 0},
+    {StringView("loop", 4), 0},
+    {StringView("low", 3), 0},
+    {StringView("main", 4), kTagElement | kTagClosesP},
+    {StringView("map", 3), kTagElement},
+    {StringView("marginheight", 12), 0},
+    {StringView("marginwidth", 11), 0},
+    {StringView("mark", 4), kTagElement},
+    {StringView("marquee", 7), kTagElement},
+    {StringView("math", 4), kTagElement},
+    {StringView("max", 3), 0},
+    {StringView("maxlength", 9), 0},
+    {StringView("media", 5), 0},
+    {StringView("menu", 4), kTagElement},
+    {StringView("menuitem", 8), kTagElement},
+    {StringView("meta", 4), kTagElement | kTagVoid},
+    {StringView("meter", 5), kTagElement},
+    {StringView("method", 6), 0},
+    {StringView("min", 3), 0},
+    {StringView("minlength", 9), 0},
+    {StringView("multiple", 8), 0},
+    {StringView("muted", 5), 0},
+    {StringView("name", 4), 0},
+    {StringView("nav", 3), kTagElement | kTagClosesP},
+    {StringView("nobr", 4), kTagElement},
+    {StringView("noembed", 7), kTagElement},
+    {StringView("noframes", 8), kTagElement},
+    {StringView("nomodule", 8), 0},
+    {StringView("nonce", 5), 0},
+    {StringView("noscript", 8), kTagElement},
+    {StringView("noshade", 7), 0},
+    {StringView("novalidate", 10), 0},
+    {StringView("nowrap", 6), 0},
+    {StringView("object", 6), kTagElement},
+    {StringView("ol", 2), kTagElement | kTagClosesP},
+    {StringView("onblur", 6), 0},
+    {StringView("onchange", 8), 0},
+    {StringView("onclick", 7), 0},
+    {StringView("onerror", 7), 0},
+    {StringView("onfocus", 7), 0},
+    {StringView("oninput", 7), 0},
+    {StringView("onkeydown", 9), 0},
+    {StringView("onkeyup", 7), 0},
+    {StringView("onload", 6), 0},
+    {StringView("onmousedown", 11), 0},
+    {StringView("onmouseout", 10), 0},
+    {StringView("onmouseover", 11), 0},
+    {StringView("onmouseup", 9), 0},
+    {StringView("onsubmit", 8), 0},
+    {StringView("open", 4), 0},
+    {StringView("optgroup", 8), kTagElement | kTagOptionalEnd | kTagOptgroup | ClosedBy(kTagOptgroup)},
+    {StringView("optimum", 7), 0},
+    {StringView("option", 6), kTagElement | kTagOptionalEnd | kTagOption | ClosedBy(kTagOption) | ClosedBy(kTagOptgroup)},
+    {StringView("output", 6), kTagElement},
+    {StringView("p", 1), kTagElement | kTagOptionalEnd | kTagClosesP | ClosedBy(kTagClosesP)},
+    {StringView("param", 5), kTagElement | kTagVoid},
+    {StringView("pattern", 7), 0},
+    {StringView("picture", 7), kTagElement},
+    {StringView("ping", 4), 0},
+    {StringView("placeholder", 11), 0},
+    {StringView("plaintext", 9), kTagElement},
+    {StringView("playsinline", 11), 0},
+    {StringView("popover", 7), 0},
+    {StringView("poster", 6), 0},
+    {StringView("pre", 3), kTagElement | kTagClosesP},
+    {StringView("preload", 7), 0},
+    {StringView("progress", 8), kTagElement},
+    {StringView("property", 8), 0},
+    {StringView("q", 1), kTagElement},
+    {StringView("rb", 2), kTagElement | kTagOptionalEnd | kTagRuby | ClosedBy(kTagRuby)},
+    {StringView("readonly", 8), 0},
+    {StringView("referrerpolicy", 14), 0},
+    {StringView("rel", 3), 0},
+    {StringView("required", 8), 0},
+    {StringView("rev", 3), 0},
+    {StringView("reversed", 8), 0},
+    {StringView("role", 4), 0},
+    {StringView("rows", 4), 0},
+    {StringView("rowspan", 7), 0},
+    {StringView("rp", 2), kTagElement | kTagOptionalEnd | kTagRuby | ClosedBy(kTagRuby)},
+    {StringView("rt", 2), kTagElement | kTagOptionalEnd | kTagRuby | ClosedBy(kTagRuby)},
+    {StringView("rtc", 3), kTagElement | kTagOptionalEnd | kTagRuby | ClosedBy(kTagRuby)},
+    {StringView("ruby", 4), kTagElement},
+    {StringView("rules", 5), 0},
+    {StringView("s", 1), kTagElement},
+    {StringView("samp", 4), kTagElement},
+    {StringView("sandbox", 7), 0},
+    {StringView("scope", 5), 0},
+    {StringView("script", 6), kTagElement | kTagRawText},
+    {StringView("scrolling", 9), 0},
+    {StringView("search", 6), kTagElement},
+    {StringView("section", 7), kTagElement | kTagClosesP},
+    {StringView("select", 6), kTagElement},
+    {StringView("selected", 8), 0},
+    {StringView("shape", 5), 0},
+    {StringView("size", 4), 0},
+    {StringView("sizes", 5), 0},
+    {StringView("slot", 4), kTagElement},
+    {StringView("small", 5), kTagElement},
+    {StringView("source", 6), kTagElement | kTagVoid},
+    {StringView("spacer", 6), kTagElement},
+    {StringView("span", 4), kTagElement},
+    {StringView("spellcheck", 10), 0},
+    {StringView("src", 3), 0},
+    {StringView("srcdoc", 6), 0},
+    {StringView("srclang", 7), 0},
+    {StringView("srcset", 6), 0},
+    {StringView("start", 5), 0},
+    {StringView("step", 4), 0},
+    {StringView("strike", 6), kTagElement},
+    {StringView("strong", 6), kTagElement},
+    {StringView("style", 5), kTagElement | kTagRawText},
+    {StringView("sub", 3), kTagElement},
+    {StringView("summary", 7), kTagElement},
+    {StringView("sup", 3), kTagElement},
+    {StringView("svg", 3), kTagElement},
+    {StringView("tabindex", 8), 0},
+    {StringView("table", 5), kTagElement | kTagClosesP},
+    {StringView("target", 6), 0},
+    {StringView("tbody", 5), kTagElement | kTagOptionalEnd | kTagTbody | ClosedBy(kTagTbody) | ClosedBy(kTagTfoot)},
+    {StringView("td", 2), kTagElement | kTagOptionalEnd | kTagCell | ClosedBy(kTagCell)},
+    {StringView("template", 8), kTagElement},
+    {StringView("text", 4), 0},
+    {StringView("textarea", 8), kTagElement | kTagRawText},
+    {StringView("tfoot", 5), kTagElement | kTagOptionalEnd | kTagTfoot | ClosedBy(kTagTbody)},
+    {StringView("th", 2), kTagElement | kTagOptionalEnd | kTagCell | ClosedBy(kTagCell)},
+    {StringView("thead", 5), kTagElement | ClosedBy(kTagTbody) | ClosedBy(kTagTfoot)},
+    {StringView("time", 4), kTagElement},
+    {StringView("title", 5), kTagElement | kTagRawText},
+    {StringView("tr", 2), kTagElement | kTagOptionalEnd | kTagTr | ClosedBy(kTagTr)},
+    {StringView("track", 5), kTagElement | kTagVoid},
+    {StringView("translate", 9), 0},
+    {StringView("tt", 2), kTagElement},
+    {StringView("type", 4), 0},
+    {StringView("u", 1), kTagElement},
+    {StringView("ul", 2), kTagElement | kTagClosesP},
+    {StringView("usemap", 6), 0},
+    {StringView("valign", 6), 0},
+    {StringView("value", 5), 0},
+    {StringView("valuetype", 9), 0},
+    {StringView("var", 3), kTagElement},
+    {StringView("version", 7), 0},
+    {StringView("video", 5), kTagElement},
+    {StringView("vlink", 5), 0},
+    {StringView("vspace", 6), 0},
+    {StringView("wbr", 3), kTagElement | kTagVoid},
+    {StringView("width", 5), 0},
+    {StringView("wrap", 4), 0},
+    {StringView("xmlns", 5), 0},
+    {StringView("xmp", 3), kTagElement | kTagRawText},
+};
+
+//Other
+Atom AtomTable::Find(const StringView& name)
+{
+    const char* data = name.GetData();
+    switch(name.GetLength())
+    {
+    case 1:
+        switch(data[0])
+        {
+        case 'a':
+            return kAtomA;
+        case 'b':
+            return kAtomB;
+        case 'i':
+            return kAtomI;
+        case 'p':
+            return kAtomP;
+        case 'q':
+            return kAtomQ;
+        case 's':
+            return kAtomS;
+        case 'u':
+            return kAtomU;
+        }
+        break;
+    case 2:
+        switch(data[0])
+        {
+        case 'b':
+            if(data[1] == 'r') return kAtomBr;
+            break;
+        case 'd':
+            if(data[1] == 'd') return kAtomDd;
+            if(data[1] == 'l') return kAtomDl;
+            if(data[1] == 't') return kAtomDt;
+            break;
+        case 'e':
+            if(data[1] == 'm') return kAtomEm;
+            break;
+        case 'h':
+            if(data[1] == '1') return kAtomH1;
+            if(data[1] == '2') return kAtomH2;
+            if(data[1] == '3') return kAtomH3;
+            if(data[1] == '4') return kAtomH4;
+            if(data[1] == '5') return kAtomH5;
+            if(data[1] == '6') return kAtomH6;
+            if(data[1] == 'r') return kAtomHr;
+            break;
+        case 'i':
+            if(data[1] == 'd') return kAtomId;
+            if(data[1] == 's') return kAtomIs;
+            break;
+        case 'l':
+            if(data[1] == 'i') return kAtomLi;
+            break;
+        case 'o':
+            if(data[1] == 'l') return kAtomOl;
+            break;
+        case 'r':
+            if(data[1] == 'b') return kAtomRb;
+            if(data[1] == 'p') return kAtomRp;
+            if(data[1] == 't') return kAtomRt;
+            break;
+        case 't':
+            if(data[1] == 'd') return kAtomTd;
+            if(data[1] == 'h') return kAtomTh;
+            if(data[1] == 'r') return kAtomTr;
+            if(data[1] == 't') return kAtomTt;
+            break;
+        case 'u':
+            if(data[1] == 'l') return kAtomUl;
+            break;
+        }
+        break;
+    case 3:
+        switch(data[0])
+        {
+        case 'a':
+            if(memcmp(data + 1, "lt", 2) == 0) return kAtomAlt;
+            break;
+        case 'b':
+            if(memcmp(data + 1, "di", 2) == 0) return kAtomBdi;
+            if(memcmp(data + 1, "do", 2) == 0) return kAtomBdo;
+            if(memcmp(data + 1, "ig", 2) == 0) return kAtomBig;
+            break;
+        case 'c':
+            if(memcmp(data + 1, "ol", 2) == 0) return kAtomCol;
+            break;
+        case 'd':
+            if(memcmp(data + 1, "el", 2) == 0) return kAtomDel;
+            if(memcmp(data + 1, "fn", 2) == 0) return kAtomDfn;
+            if(memcmp(data + 1, "ir", 2) == 0) return kAtomDir;
+            if(memcmp(data + 1, "iv", 2) == 0) return kAtomDiv;
+            break;
+        case 'f':
+            if(memcmp(data + 1, "or", 2) == 0) return kAtomFor;
+            break;
+        case 'i':
+            if(memcmp(data + 1, "mg", 2) == 0) return kAtomImg;
+            if(memcmp(data + 1, "ns", 2) == 0) return kAtomIns;
+            break;
+        case 'k':
+            if(memcmp(data + 1, "bd", 2) == 0) return kAtomKbd;
+            break;
+        case 'l':
+            if(memcmp(data + 1, "ow", 2) == 0) return kAtomLow;
+            break;
+        case 'm':
+            if(memcmp(data + 1, "ap", 2) == 0) return kAtomMap;
+            if(memcmp(data + 1, "ax", 2) == 0) return kAtomMax;
+            if(memcmp(data + 1, "in", 2) == 0) return kAtomMin;
+            break;
+        case 'n':
+            if(memcmp(data + 1, "av", 2) == 0) return kAtomNav;
+            break;
+        case 'p':
+            if(memcmp(data + 1, "re", 2) == 0) return kAtomPre;
+            break;
+        case 'r':
+            if(memcmp(data + 1, "el", 2) == 0) return kAtomRel;
+            if(memcmp(data + 1, "ev", 2) == 0) return kAtomRev;
+            if(memcmp(data + 1, "tc", 2) == 0) return kAtomRtc;
+            break;
+        case 's':
+            if(memcmp(data + 1, "rc", 2) == 0) return kAtomSrc;
+            if(memcmp(data + 1, "ub", 2) == 0) return kAtomSub;
+            if(memcmp(data + 1, "up", 2) == 0) return kAtomSup;
+            if(memcmp(data + 1, "vg", 2) == 0) return kAtomSvg;
+            break;
+        case 'v':
+            if(memcmp(data + 1, "ar", 2) == 0) return kAtomVar;
+            break;
+        case 'w':
+            if(memcmp(data + 1, "br", 2) == 0) return kAtomWbr;
+            break;
+        case 'x':
+            if(memcmp(data + 1, "mp", 2) == 0) return kAtomXmp;
+            break;
+        }
+        break;
+    case 4:
+        switch(data[0])
+        {
+        case 'a':
+            if(memcmp(data + 1, "bbr", 3) == 0) return kAtomAbbr;
+            if(memcmp(data + 1, "rea", 3) == 0) return kAtomArea;
+            break;
+        case 'b':
+            if(memcmp(data + 1, "ase", 3) == 0) return kAtomBase;
+            if(memcmp(data + 1, "ody", 3) == 0) return kAtomBody;
+            break;
+        case 'c':
+            if(memcmp(data + 1, "ite", 3) == 0) return kAtomCite;
+            if(memcmp(data + 1, "ode", 3) == 0) return kAtomCode;
+            if(memcmp(data + 1, "ols", 3) == 0) return kAtomCols;
+            break;
+        case 'd':
+            if(memcmp(data + 1, "ata", 3) == 0) return kAtomData;
+            break;
+        case 'f':
+            if(memcmp(data + 1, "ace", 3) == 0) return kAtomFace;
+            if(memcmp(data + 1, "ont", 3) == 0) return kAtomFont;
+            if(memcmp(data + 1, "orm", 3) == 0) return kAtomForm;
+            break;
+        case 'h':
+            if(memcmp(data + 1, "ead", 3) == 0) return kAtomHead;
+            if(memcmp(data + 1, "igh", 3) == 0) return kAtomHigh;
+            if(memcmp(data + 1, "ref", 3) == 0) return kAtomHref;
+            if(memcmp(data + 1, "tml", 3) == 0) return kAtomHtml;
+            break;
+        case 'k':
+            if(memcmp(data + 1, "ind", 3) == 0) return kAtomKind;
+            break;
+        case 'l':
+            if(memcmp(data + 1, "ang", 3) == 0) return kAtomLang;
+            if(memcmp(data + 1, "ink", 3) == 0) return kAtomLink;
+            if(memcmp(data + 1, "ist", 3) == 0) return kAtomList;
+            if(memcmp(data + 1, "oop", 3) == 0) return kAtomLoop;
+            break;
+        case 'm':
+            if(memcmp(data + 1, "ain", 3) == 0) return kAtomMain;
+            if(memcmp(data + 1, "ark", 3) == 0) return kAtomMark;
+            if(memcmp(data + 1, "ath", 3) == 0) return kAtomMath;
+            if(memcmp(data + 1, "enu", 3) == 0) return kAtomMenu;
+            if(memcmp(data + 1, "eta", 3) == 0) return kAtomMeta;
+            break;
+        case 'n':
+            if(memcmp(data + 1, "ame", 3) == 0) return kAtomName;
+            if(memcmp(data + 1, "obr", 3) == 0) return kAtomNobr;
+            break;
+        case 'o':
+            if(memcmp(data + 1, "pen", 3) == 0) return kAtomOpen;
+            break;
+        case 'p':
+            if(memcmp(data + 1, "ing", 3) == 0) return kAtomPing;
+            break;
+        case 'r':
+            if(memcmp(data + 1, "ole", 3) == 0) return kAtomRole;
+            if(memcmp(data + 1, "ows", 3) == 0) return kAtomRows;
+            if(memcmp(data + 1, "uby", 3) == 0) return kAtomRuby;
+            break;
+        case 's':
+            if(memcmp(data + 1, "amp", 3) == 0) return kAtomSamp;
+            if(memcmp(data + 1, "ize", 3) == 0) return kAtomSize;
+            if(memcmp(data + 1, "lot", 3) == 0) return kAtomSlot;
+            if(memcmp(data + 1, "pan", 3) == 0) return kAtomSpan;
+            if(memcmp(data + 1, "tep", 3) == 0) return kAtomStep;
+            break;
+        case 't':
+            if(memcmp(data + 1, "ext", 3) == 0) return kAtomText;
+            if(memcmp(data + 1, "ime", 3) == 0) return kAtomTime;
+            if(memcmp(data + 1, "ype", 3) == 0) return kAtomType;
+            break;
+        case 'w':
+            if(memcmp(data + 1, "rap", 3) == 0) return kAtomWrap;
+            break;
+        }
+        break;
+    case 5:
+        switch(data[0])
+        {
+        case 'a':
+            if(memcmp(data + 1, "lign", 4) == 0) return kAtomAlign;
+            if(memcmp(data + 1, "link", 4) == 0) return kAtomAlink;
+            if(memcmp(data + 1, "llow", 4) == 0) return kAtomAllow;
+            if(memcmp(data + 1, "side", 4) == 0) return kAtomAside;
+            if(memcmp(data + 1, "sync", 4) == 0) return kAtomAsync;
+            if(memcmp(data + 1, "udio", 4) == 0) return kAtomAudio;
+            break;
+        case 'b':
+            if(memcmp(data + 1, "link", 4) == 0) return kAtomBlink;
+            break;
+        case 'c':
+            if(memcmp(data + 1, "lass", 4) == 0) return kAtomClass;
+            if(memcmp(data + 1, "lear", 4) == 0) return kAtomClear;
+            if(memcmp(data + 1, "olor", 4) == 0) return kAtomColor;
+            break;
+        case 'd':
+            if(memcmp(data + 1, "efer", 4) == 0) return kAtomDefer;
+            break;
+        case 'e':
+            if(memcmp(data + 1, "mbed", 4) == 0) return kAtomEmbed;
+            break;
+        case 'f':
+            if(memcmp(data + 1, "rame", 4) == 0) return kAtomFrame;
+            break;
+        case 'i':
+            if(memcmp(data + 1, "mage", 4) == 0) return kAtomImage;
+            if(memcmp(data + 1, "nert", 4) == 0) return kAtomInert;
+            if(memcmp(data + 1, "nput", 4) == 0) return kAtomInput;
+            if(memcmp(data + 1, "smap", 4) == 0) return kAtomIsmap;
+            break;
+        case 'l':
+            if(memcmp(data + 1, "abel", 4) == 0) return kAtomLabel;
+            break;
+        case 'm':
+            if(memcmp(data + 1, "edia", 4) == 0) return kAtomMedia;
+            if(memcmp(data + 1, "eter", 4) == 0) return kAtomMeter;
+            if(memcmp(data + 1, "uted", 4) == 0) return kAtomMuted;
+            break;
+        case 'n':
+            if(memcmp(data + 1, "once", 4) == 0) return kAtomNonce;
+            break;
+        case 'p':
+            if(memcmp(data + 1, "aram", 4) == 0) return kAtomParam;
+            break;
+        case 'r':
+            if(memcmp(data + 1, "ules", 4) == 0) return kAtomRules;
+            break;
+        case 's':
+            if(memcmp(data + 1, "cope", 4) == 0) return kAtomScope;
+            if(memcmp(data + 1, "hape", 4) == 0) return kAtomShape;
+            if(memcmp(data + 1, "izes", 4) == 0) return kAtomSizes;
+            if(memcmp(data + 1, "mall", 4) == 0) return kAtomSmall;
+            if(memcmp(data + 1, "tart", 4) == 0) return kAtomStart;
+            if(memcmp(data + 1, "tyle", 4) == 0) return kAtomStyle;
+            break;
+        case 't':
+            if(memcmp(data + 1, "able", 4) == 0) return kAtomTable;
+            if(memcmp(data + 1, "body", 4) == 0) return kAtomTbody;
+            if(memcmp(data + 1, "foot", 4) == 0) return kAtomTfoot;
+            if(memcmp(data + 1, "head", 4) == 0) return kAtomThead;
+            if(memcmp(data + 1, "itle", 4) == 0) return kAtomTitle;
+            if(memcmp(data + 1, "rack", 4) == 0) return kAtomTrack;
+            break;
+        case 'v':
+            if(memcmp(data + 1, "alue", 4) == 0) return kAtomValue;
+            if(memcmp(data + 1, "ideo", 4) == 0) return kAtomVideo;
+            if(memcmp(data + 1, "link", 4) == 0) return kAtomVlink;
+            break;
+        case 'w':
+            if(memcmp(data + 1, "idth", 4) == 0) return kAtomWidth;
+            break;
+        case 'x':
+            if(memcmp(data + 1, "mlns", 4) == 0) return kAtomXmlns;
+            break;
+        }
+        break;
+    case 6:
+        switch(data[0])
+        {
+        case 'a':
+            if(memcmp(data + 1, "ccept", 5) == 0) return kAtomAccept;
+            if(memcmp(data + 1, "ction", 5) == 0) return kAtomAction;
+            if(memcmp(data + 1, "pplet", 5) == 0) return kAtomApplet;
+            break;
+        case 'b':
+            if(memcmp(data + 1, "order", 5) == 0) return kAtomBorder;
+            if(memcmp(data + 1, "utton", 5) == 0) return kAtomButton;
+            break;
+        case 'c':
+            if(memcmp(data + 1, "anvas", 5) == 0) return kAtomCanvas;
+            if(memcmp(data + 1, "enter", 5) == 0) return kAtomCenter;
+            if(memcmp(data + 1, "oords", 5) == 0) return kAtomCoords;
+            break;
+        case 'd':
+            if(memcmp(data + 1, "ialog", 5) == 0) return kAtomDialog;
+            break;
+        case 'f':
+            if(memcmp(data + 1, "igure", 5) == 0) return kAtomFigure;
+            if(memcmp(data + 1, "ooter", 5) == 0) return kAtomFooter;
+            break;
+        case 'h':
+            if(memcmp(data + 1, "eader", 5) == 0) return kAtomHeader;
+            if(memcmp(data + 1, "eight", 5) == 0) return kAtomHeight;
+            if(memcmp(data + 1, "group", 5) == 0) return kAtomHgroup;
+            if(memcmp(data + 1, "idden", 5) == 0) return kAtomHidden;
+            if(memcmp(data + 1, "space", 5) == 0) return kAtomHspace;
+            break;
+        case 'i':
+            if(memcmp(data + 1, "frame", 5) == 0) return kAtomIframe;
+            if(memcmp(data + 1, "temid", 5) == 0) return kAtomItemid;
+            break;
+        case 'k':
+            if(memcmp(data + 1, "eygen", 5) == 0) return kAtomKeygen;
+            break;
+        case 'l':
+            if(memcmp(data + 1, "egend", 5) == 0) return kAtomLegend;
+            break;
+        case 'm':
+            if(memcmp(data + 1, "ethod", 5) == 0) return kAtomMethod;
+            break;
+        case 'n':
+            if(memcmp(data + 1, "owrap", 5) == 0) return kAtomNowrap;
+            break;
+        case 'o':
+            if(memcmp(data + 1, "bject", 5) == 0) return kAtomObject;
+            if(memcmp(data + 1, "nblur", 5) == 0) return kAtomOnblur;
+            if(memcmp(data + 1, "nload", 5) == 0) return kAtomOnload;
+            if(memcmp(data + 1, "ption", 5) == 0) return kAtomOption;
+            if(memcmp(data + 1, "utput", 5) == 0) return kAtomOutput;
+            break;
+        case 'p':
+            if(memcmp(data + 1, "oster", 5) == 0) return kAtomPoster;
+            break;
+        case 's':
+            if(memcmp(data + 1, "cript", 5) == 0) return kAtomScript;
+            if(memcmp(data + 1, "earch", 5) == 0) return kAtomSearch;
+            if(memcmp(data + 1, "elect", 5) == 0) return kAtomSelect;
+            if(memcmp(data + 1, "ource", 5) == 0) return kAtomSource;
+            if(memcmp(data + 1, "pacer", 5) == 0) return kAtomSpacer;
+            if(memcmp(data + 1, "rcdoc", 5) == 0) return kAtomSrcdoc;
+            if(memcmp(data + 1, "rcset", 5) == 0) return kAtomSrcset;
+            if(memcmp(data + 1, "trike", 5) == 0) return kAtomStrike;
+            if(memcmp(data + 1, "trong", 5) == 0) return kAtomStrong;
+            break;
+        case 't':
+            if(memcmp(data + 1, "arget", 5) == 0) return kAtomTarget;
+            break;
+        case 'u':
+            if(memcmp(data + 1, "semap", 5) == 0) return kAtomUsemap;
+            break;
+        case 'v':
+            if(memcmp(data + 1, "align", 5) == 0) return kAtomValign;
+            if(memcmp(data + 1, "space", 5) == 0) return kAtomVspace;
+            break;
+        }
+        break;
+    case 7:
+        switch(data[0])
+        {
+        case 'a':
+            if(memcmp(data + 1, "cronym", 6) == 0) return kAtomAcronym;
+            if(memcmp(data + 1, "ddress", 6) == 0) return kAtomAddress;
+            if(memcmp(data + 1, "rchive", 6) == 0) return kAtomArchive;
+            if(memcmp(data + 1, "rticle", 6) == 0) return kAtomArticle;
+            break;
+        case 'b':
+            if(memcmp(data + 1, "gcolor", 6) == 0) return kAtomBgcolor;
+            if(memcmp(data + 1, "gsound", 6) == 0) return kAtomBgsound;
+            break;
+        case 'c':
+            if(memcmp(data + 1, "aption", 6) == 0) return kAtomCaption;
+            if(memcmp(data + 1, "harset", 6) == 0) return kAtomCharset;
+            if(memcmp(data + 1, "hecked", 6) == 0) return kAtomChecked;
+            if(memcmp(data + 1, "lassid", 6) == 0) return kAtomClassid;
+            if(memcmp(data + 1, "olspan", 6) == 0) return kAtomColspan;
+            if(memcmp(data + 1, "ommand", 6) == 0) return kAtomCommand;
+            if(memcmp(data + 1, "ontent", 6) == 0) return kAtomContent;
+            break;
+        case 'd':
+            if(memcmp(data + 1, "eclare", 6) == 0) return kAtomDeclare;
+            if(memcmp(data + 1, "efault", 6) == 0) return kAtomDefault;
+            if(memcmp(data + 1, "etails", 6) == 0) return kAtomDetails;
+            if(memcmp(data + 1, "irname", 6) == 0) return kAtomDirname;
+            break;
+        case 'e':
+            if(memcmp(data + 1, "nctype", 6) == 0) return kAtomEnctype;
+            break;
+        case 'h':
+            if(memcmp(data + 1, "eaders", 6) == 0) return kAtomHeaders;
+            break;
+        case 'i':
+            if(memcmp(data + 1, "sindex", 6) == 0) return kAtomIsindex;
+            if(memcmp(data + 1, "temref", 6) == 0) return kAtomItemref;
+            break;
+        case 'l':
+            if(memcmp(data + 1, "isting", 6) == 0) return kAtomListing;
+            if(memcmp(data + 1, "oading", 6) == 0) return kAtomLoading;
+            break;
+        case 'm':
+            if(memcmp(data + 1, "arquee", 6) == 0) return kAtomMarquee;
+            break;
+        case 'n':
+            if(memcmp(data + 1, "oembed", 6) == 0) return kAtomNoembed;
+            if(memcmp(data + 1, "oshade", 6) == 0) return kAtomNoshade;
+            break;
+        case 'o':
+            if(memcmp(data + 1, "nclick", 6) == 0) return kAtomOnclick;
+            if(memcmp(data + 1, "nerror", 6) == 0) return kAtomOnerror;
+            if(memcmp(data + 1, "nfocus", 6) == 0) return kAtomOnfocus;
+            if(memcmp(data + 1, "ninput", 6) == 0) return kAtomOninput;
+            if(memcmp(data + 1, "nkeyup", 6) == 0) return kAtomOnkeyup;
+            if(memcmp(data + 1, "ptimum", 6) == 0) return kAtomOptimum;
+            break;
+        case 'p':
+            if(memcmp(data + 1, "attern", 6) == 0) return kAtomPattern;
+            if(memcmp(data + 1, "icture", 6) == 0) return kAtomPicture;
+            if(memcmp(data + 1, "opover", 6) == 0) return kAtomPopover;
+            if(memcmp(data + 1, "reload", 6) == 0) return kAtomPreload;
+            break;
+        case 'r':
+            if(memcmp(data + 1, "owspan", 6) == 0) return kAtomRowspan;
+            break;
+        case 's':
+            if(memcmp(data + 1, "andbox", 6) == 0) return kAtomSandbox;
+            if(memcmp(data + 1, "ection", 6) == 0) return kAtomSection;
+            if(memcmp(data + 1, "rclang", 6) == 0) return kAtomSrclang;
+            if(memcmp(data + 1, "ummary", 6) == 0) return kAtomSummary;
+            break;
+        case 'v':
+            if(memcmp(data + 1, "ersion", 6) == 0) return kAtomVersion;
+            break;
+        }
+        break;
+    case 8:
+        switch(data[0])
+        {
+        case 'a':
+            if(memcmp(data + 1, "utoplay", 7) == 0) return kAtomAutoplay;
+            break;
+        case 'b':
+            if(memcmp(data + 1, "asefont", 7) == 0) return kAtomBasefont;
+            break;
+        case 'c':
+            if(memcmp(data + 1, "odebase", 7) == 0) return kAtomCodebase;
+            if(memcmp(data + 1, "olgroup", 7) == 0) return kAtomColgroup;
+            if(memcmp(data + 1, "ontrols", 7) == 0) return kAtomControls;
+            break;
+        case 'd':
+            if(memcmp(data + 1, "atalist", 7) == 0) return kAtomDatalist;
+            if(memcmp(data + 1, "atetime", 7) == 0) return kAtomDatetime;
+            if(memcmp(data + 1, "ecoding", 7) == 0) return kAtomDecoding;
+            if(memcmp(data + 1, "isabled", 7) == 0) return kAtomDisabled;
+            if(memcmp(data + 1, "ownload", 7) == 0) return kAtomDownload;
+            break;
+        case 'f':
+            if(memcmp(data + 1, "ieldset", 7) == 0) return kAtomFieldset;
+            if(memcmp(data + 1, "rameset", 7) == 0) return kAtomFrameset;
+            break;
+        case 'h':
+            if(memcmp(data + 1, "reflang", 7) == 0) return kAtomHreflang;
+            break;
+        case 'i':
+            if(memcmp(data + 1, "temprop", 7) == 0) return kAtomItemprop;
+            if(memcmp(data + 1, "temtype", 7) == 0) return kAtomItemtype;
+            break;
+        case 'l':
+            if(memcmp(data + 1, "anguage", 7) == 0) return kAtomLanguage;
+            if(memcmp(data + 1, "ongdesc", 7) == 0) return kAtomLongdesc;
+            break;
+        case 'm':
+            if(memcmp(data + 1, "enuitem", 7) == 0) return kAtomMenuitem;
+            if(memcmp(data + 1, "ultiple", 7) == 0) return kAtomMultiple;
+            break;
+        case 'n':
+            if(memcmp(data + 1, "oframes", 7) == 0) return kAtomNoframes;
+            if(memcmp(data + 1, "omodule", 7) == 0) return kAtomNomodule;
+            if(memcmp(data + 1, "oscript", 7) == 0) return kAtomNoscript;
+            break;
+        case 'o':
+            if(memcmp(data + 1, "nchange", 7) == 0) return kAtomOnchange;
+            if(memcmp(data + 1, "nsubmit", 7) == 0) return kAtomOnsubmit;
+            if(memcmp(data + 1, "ptgroup", 7) == 0) return kAtomOptgroup;
+            break;
+        case 'p':
+            if(memcmp(data + 1, "rogress", 7) == 0) return kAtomProgress;
+            if(memcmp(data + 1, "roperty", 7) == 0) return kAtomProperty;
+            break;
+        case 'r':
+            if(memcmp(data + 1, "eadonly", 7) == 0) return kAtomReadonly;
+            if(memcmp(data + 1, "equired", 7) == 0) return kAtomRequired;
+            if(memcmp(data + 1, "eversed", 7) == 0) return kAtomReversed;
+            break;
+        case 's':
+            if(memcmp(data + 1, "elected", 7) == 0) return kAtomSelected;
+            break;
+        case 't':
+            if(memcmp(data + 1, "abindex", 7) == 0) return kAtomTabindex;
+            if(memcmp(data + 1, "emplate", 7) == 0) return kAtomTemplate;
+            if(memcmp(data + 1, "extarea", 7) == 0) return kAtomTextarea;
+            break;
+        }
+        break;
+    case 9:
+        switch(data[0])
+        {
+        case 'a':
+            if(memcmp(data + 1, "ccesskey", 8) == 0) return kAtomAccesskey;
+            if(memcmp(data + 1, "utofocus", 8) == 0) return kAtomAutofocus;
+            break;
+        case 'd':
+            if(memcmp(data + 1, "raggable", 8) == 0) return kAtomDraggable;
+            break;
+        case 'i':
+            if(memcmp(data + 1, "nputmode", 8) == 0) return kAtomInputmode;
+            if(memcmp(data + 1, "ntegrity", 8) == 0) return kAtomIntegrity;
+            if(memcmp(data + 1, "temscope", 8) == 0) return kAtomItemscope;
+            break;
+        case 'm':
+            if(memcmp(data + 1, "axlength", 8) == 0) return kAtomMaxlength;
+            if(memcmp(data + 1, "inlength", 8) == 0) return kAtomMinlength;
+            break;
+        case 'o':
+            if(memcmp(data + 1, "nkeydown", 8) == 0) return kAtomOnkeydown;
+            if(memcmp(data + 1, "nmouseup", 8) == 0) return kAtomOnmouseup;
+            break;
+        case 'p':
+            if(memcmp(data + 1, "laintext", 8) == 0) return kAtomPlaintext;
+            break;
+        case 's':
+            if(memcmp(data + 1, "crolling", 8) == 0) return kAtomScrolling;
+            break;
+        case 't':
+            if(memcmp(data + 1, "ranslate", 8) == 0) return kAtomTranslate;
+            break;
+        case 'v':
+            if(memcmp(data + 1, "aluetype", 8) == 0) return kAtomValuetype;
+            break;
+        }
+        break;
+    case 10:
+        switch(data[0])
+        {
+        case 'b':
+            if(memcmp(data + 1, "ackground", 9) == 0) return kAtomBackground;
+            if(memcmp(data + 1, "lockquote", 9) == 0) return kAtomBlockquote;
+            break;
+        case 'f':
+            if(memcmp(data + 1, "igcaption", 9) == 0) return kAtomFigcaption;
+            if(memcmp(data + 1, "ormaction", 9) == 0) return kAtomFormaction;
+            if(memcmp(data + 1, "ormmethod", 9) == 0) return kAtomFormmethod;
+            if(memcmp(data + 1, "ormtarget", 9) == 0) return kAtomFormtarget;
+            break;
+        case 'h':
+            if(memcmp(data + 1, "ttp-equiv", 9) == 0) return kAtomHttpEquiv;
+            break;
+        case 'n':
+            if(memcmp(data + 1, "ovalidate", 9) == 0) return kAtomNovalidate;
+            break;
+        case 'o':
+            if(memcmp(data + 1, "nmouseout", 9) == 0) return kAtomOnmouseout;
+            break;
+        case 's':
+            if(memcmp(data + 1, "pellcheck", 9) == 0) return kAtomSpellcheck;
+            break;
+        }
+        break;
+    case 11:
+        switch(data[0])
+        {
+        case 'c':
+            if(memcmp(data + 1, "rossorigin", 10) == 0) return kAtomCrossorigin;
+            break;
+        case 'f':
+            if(memcmp(data + 1, "ormenctype", 10) == 0) return kAtomFormenctype;
+            if(memcmp(data + 1, "rameborder", 10) == 0) return kAtomFrameborder;
+            break;
+        case 'm':
+            if(memcmp(data + 1, "arginwidth", 10) == 0) return kAtomMarginwidth;
+            break;
+        case 'o':
+            if(memcmp(data + 1, "nmousedown", 10) == 0) return kAtomOnmousedown;
+            if(memcmp(data + 1, "nmouseover", 10) == 0) return kAtomOnmouseover;
+            break;
+        case 'p':
+            if(memcmp(data + 1, "laceholder", 10) == 0) return kAtomPlaceholder;
+            if(memcmp(data + 1, "laysinline", 10) == 0) return kAtomPlaysinline;
+            break;
+        }
+        break;
+    case 12:
+        switch(data[0])
+        {
+        case 'a':
+            if(memcmp(data + 1, "utocomplete", 11) == 0) return kAtomAutocomplete;
+            break;
+        case 'e':
+            if(memcmp(data + 1, "nterkeyhint", 11) == 0) return kAtomEnterkeyhint;
+            break;
+        case 'm':
+            if(memcmp(data + 1, "arginheight", 11) == 0) return kAtomMarginheight;
+            break;
+        }
+        break;
+    case 14:
+        switch(data[0])
+        {
+        case 'a':
+            if(memcmp(data + 1, "ccept-charset", 13) == 0) return kAtomAcceptCharset;
+            if(memcmp(data + 1, "utocapitalize", 13) == 0) return kAtomAutocapitalize;
+            break;
+        case 'f':
+            if(memcmp(data + 1, "ormnovalidate", 13) == 0) return kAtomFormnovalidate;
+            break;
+        case 'r':
+            if(memcmp(data + 1, "eferrerpolicy", 13) == 0) return kAtomReferrerpolicy;
+            break;
+        }
+        break;
+    case 15:
+        switch(data[0])
+        {
+        case 'a':
+            if(memcmp(data + 1, "llowfullscreen", 14) == 0) return kAtomAllowfullscreen;
+            break;
+        case 'c':
+            if(memcmp(data + 1, "ontenteditable", 14) == 0) return kAtomContenteditable;
+            break;
+        }
+        break;
+    }
+    return kNoAtom;
+}
+
+StringView AtomTable::GetName(Atom atom)
+{
+    if(atom >= kAtomCount) return StringView();
+    return kAtomEntries[atom].name;
+}
+
+unsigned int AtomTable::GetProperties(Atom atom)
+{
+    if(atom >= kAtomCount) return 0;
+    return kAtomEntries[atom].properties;
+}
+
+bool AtomTable::Equal(Atom atom, const StringView& name,
+                      Atom otherAtom, const StringView& otherName)
+{
+    return atom == otherAtom && (atom != kNoAtom || name == otherName);
+}
+}
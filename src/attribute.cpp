@@ -1,59 +1,185 @@
 #include "attribute.h"
 
+#include <utility>
+
+#include "entitydecoder.h"
+
 namespace idogaf
 {
 
 Attribute::Attribute()
 {
+    atom_ = kNoAtom;
     name_ = std::string();
     value_ = std::string();
+    references_ = false;
 }
 
 Attribute::Attribute(const std::string& name)
 {
-    name_ = name;
+    SetName(name);
     value_ = std::string();
+    references_ = false;
 }
 
 Attribute::Attribute(const std::string& name, const std::string& value)
 {
-    name_ = name;
+    SetName(name);
     value_ = value;
+    references_ = EntityDecoder::HasReferences(value_);
 }
 
 Attribute::Attribute(const Attribute& other)
 {
+    //A copy owns its name and value, spans may outlive their arena
+    atom_ = other.atom_;
+    name_ = other.nameSpan_.Empty() ? other.name_ : other.nameSpan_.ToString();
+    nameSpan_ = StringView();
+    value_ = other.GetValue();
+    valueSpan_ = StringView();
+    references_ = other.references_;
+}
+
+Attribute::Attribute(const Attribute& other, Arena& arena)
+{
+    atom_ = other.atom_;
     name_ = other.name_;
+    nameSpan_ = other.nameSpan_.Empty() ? StringView()
+                                        : arena.Store(other.nameSpan_);
     value_ = other.value_;
+    valueSpan_ = other.valueSpan_.Empty() ? StringView()
+                                          : arena.Store(other.valueSpan_);
+    references_ = other.references_;
 }
 
 Attribute& Attribute::operator=(const Attribute& rhs)
 {
     if (this == &rhs) return *this; // handle self assignment
     //assignment operator
-    name_ = rhs.name_;
-    value_ = rhs.value_;
+    atom_ = rhs.atom_;
+    name_ = rhs.nameSpan_.Empty() ? rhs.name_ : rhs.nameSpan_.ToString();
+    nameSpan_ = StringView();
+    value_ = rhs.GetValue();
+    valueSpan_ = StringView();
+    references_ = rhs.references_;
+    return *this;
+}
+
+Attribute::Attribute(Attribute&& other) noexcept
+    : name_(std::move(other.name_)), value_(std::move(other.value_))
+{
+    atom_ = other.atom_;
+    nameSpan_ = other.nameSpan_;
+    valueSpan_ = other.valueSpan_;
+    references_ = other.references_;
+}
+
+Attribute& Attribute::operator=(Attribute&& rhs) noexcept
+{
+    if (this == &rhs) return *this; // handle self assignment
+    atom_ = rhs.atom_;
+    name_ = std::move(rhs.name_);
+    nameSpan_ = rhs.nameSpan_;
+    value_ = std::move(rhs.value_);
+    valueSpan_ = rhs.valueSpan_;
+    references_ = rhs.references_;
     return *this;
 }
 
 //Getters
 std::string Attribute::GetName() const
 {
+    return GetNameView().ToString();
+}
+StringView Attribute::GetNameView() const
+{
+    if(atom_ != kNoAtom) return AtomTable::GetName(atom_);
+    if(!nameSpan_.Empty()) return nameSpan_;
     return name_;
 }
+std::string Attribute::GetDecodedValue() const
+{
+    if(!references_) return GetValue();
+    std::string value;
+    StringView view = GetValueView();
+    EntityDecoder::Decode(view.begin(), view.end(), value, true);
+    return value;
+}
+StringView Attribute::GetDecodedValue(std::string& buffer) const
+{
+    StringView view = GetValueView();
+    if(!references_) return view;
+    buffer.clear();
+    EntityDecoder::Decode(view.begin(), view.end(), buffer, true);
+    return buffer;
+}
+bool Attribute::HasReferences() const
+{
+    return references_;
+}
+Atom Attribute::GetAtom() const
+{
+    return atom_;
+}
 std::string Attribute::GetValue() const
 {
+    if(!valueSpan_.Empty()) return valueSpan_.ToString();
+    return value_;
+}
+StringView Attribute::GetValueView() const
+{
+    if(!valueSpan_.Empty()) return valueSpan_;
     return value_;
 }
+StringView Attribute::GetValueSpan() const
+{
+    return valueSpan_;
+}
 
 //Setters
 void Attribute::SetName(const std::string& name)
 {
-    name_ = name;
+    atom_ = AtomTable::Find(name);
+    nameSpan_ = StringView();
+    if(atom_ != kNoAtom) name_.clear();
+    else name_ = name;
+}
+void Attribute::SetNameSpan(const StringView& name)
+{
+    atom_ = AtomTable::Find(name);
+    name_.clear();
+    nameSpan_ = atom_ != kNoAtom ? StringView() : name;
 }
 void Attribute::SetValue(const std::string& value)
+{
+    SetValue(value, EntityDecoder::HasReferences(value));
+}
+void Attribute::SetValue(const std::string& value, bool references)
 {
     value_ = value;
+    valueSpan_ = StringView();
+    references_ = references;
+}
+void Attribute::SetValueSpan(const StringView& value)
+{
+    SetValueSpan(value, EntityDecoder::HasReferences(value.begin(),
+                                                     value.end()));
+}
+void Attribute::SetValueSpan(const StringView& value, bool references)
+{
+    value_.clear();
+    valueSpan_ = value;
+    references_ = references;
+}
+
+//Other
+bool Attribute::HasName(const std::string& name) const
+{
+    return HasName(AtomTable::Find(name), name);
+}
+bool Attribute::HasName(Atom atom, const std::string& name) const
+{
+    return AtomTable::Equal(atom_, GetNameView(), atom, name);
 }
 
 }
@@ -0,0 +1,70 @@
+#include "attributeiterator.h"
+
+#include "element.h"
+
+namespace idogaf
+{
+
+/** Number of positions taken by id, class and style */
+const size_t kCommonAttributes = 3;
+
+AttributeIterator::AttributeIterator()
+{
+    element_ = nullptr;
+    position_ = 0;
+}
+
+AttributeIterator::AttributeIterator(const Element* element, size_t position)
+{
+    element_ = element;
+    position_ = position;
+    SkipUnset();
+}
+
+//Other
+const Attribute& AttributeIterator::operator*() const
+{
+    return *operator->();
+}
+const Attribute* AttributeIterator::operator->() const
+{
+    switch(position_)
+    {
+    case 0:
+        return &element_->id_;
+    case 1:
+        return &element_->class_;
+    case 2:
+        return &element_->style_;
+    }
+    return &element_->attributes_[position_ - kCommonAttributes];
+}
+AttributeIterator& AttributeIterator::operator++()
+{
+    position_++;
+    SkipUnset();
+    return *this;
+}
+AttributeIterator AttributeIterator::operator++(int)
+{
+    AttributeIterator previous = *this;
+    ++*this;
+    return previous;
+}
+bool AttributeIterator::operator==(const AttributeIterator& other) const
+{
+    return element_ == other.element_ && position_ == other.position_;
+}
+bool AttributeIterator::operator!=(const AttributeIterator& other) const
+{
+    return !(*this == other);
+}
+
+//Protected member functions
+void AttributeIterator::SkipUnset()
+{
+    while(position_ < kCommonAttributes
+          && operator->()->GetValueView().Empty())
+        position_++;
+}
+}
@@ -1,55 +1,62 @@
 #include "class.h"
 
-#include <sstream>
+#include <ctype.h>
+#include <utility>
 
 namespace idogaf
 {
 
 Class::Class() : Attribute()
 {
-    name_ = Class::GetStaticName();
-    classes_ = std::vector<std::string>();
+    atom_ = kAtomClass;
 }
 
 Class::Class(const Attribute& attribute)
 {
-    name_ = Class::GetStaticName();
-    value_ = attribute.GetValue();
-    classes_ = std::vector<std::string>();
-    if(!value_.empty())
-    {
-        std::stringstream ss = std::stringstream(value_);
-        std::string buffer = std::string();
-        while (ss.good())
-        {
-            ss >> buffer;
-            if (buffer.empty()) break;
-            classes_.push_back(buffer);
-        }
-    }
+    atom_ = kAtomClass;
+    //A span stays a span, so classes of arena documents aren't copied
+    if(!attribute.GetValueSpan().Empty()) valueSpan_ = attribute.GetValueSpan();
+    else value_ = attribute.GetValue();
+    references_ = attribute.HasReferences();
 }
 
-Class::Class(const Class& other)
+Class::Class(const Class& other) : Attribute(other)
 {
-    name_ = Class::GetStaticName();
-    value_ = other.value_;
-    classes_ = other.classes_;
+    atom_ = kAtomClass;
 }
 
 Class& Class::operator=(const Class& rhs)
 {
     if (this == &rhs) return *this; // handle self assignment
     //assignment operator
-    name_ = Class::GetStaticName();
-    value_ = rhs.value_;
-    classes_ = rhs.classes_;
+    Attribute::operator=(rhs);
+    atom_ = kAtomClass;
+    return *this;
+}
+
+Class::Class(Class&& other) noexcept : Attribute(std::move(other))
+{
+    atom_ = kAtomClass;
+}
+
+Class& Class::operator=(Class&& rhs) noexcept
+{
+    if (this == &rhs) return *this; // handle self assignment
+    Attribute::operator=(std::move(rhs));
+    atom_ = kAtomClass;
     return *this;
 }
 
 //Getters
 std::vector<std::string> Class::GetClassesInVector() const
 {
-    return classes_;
+    std::vector<std::string> classes;
+    StringView value = GetValueView();
+    const char* cursor = value.begin();
+    StringView className;
+    while(NextClass(cursor, value.end(), className))
+        classes.push_back(className.ToString());
+    return classes;
 }
 std::string Class::GetStaticName()
 {
@@ -60,12 +67,27 @@ std::string Class::GetStaticName()
 void Class::SetName(const std::string& name) {}
 
 //Other
-bool Class::Matches(const std::string& className)
+bool Class::Matches(const std::string& className) const
 {
-    for(auto it = classes_.begin(); it != classes_.end(); ++it)
-    {
-        if(*it == className) return true;
-    }
+    StringView value = GetValueView();
+    const char* cursor = value.begin();
+    StringView name;
+    while(NextClass(cursor, value.end(), name))
+        if(name == className) return true;
     return false;
 }
+
+//Protected member functions
+bool Class::NextClass(const char*& cursor, const char* end,
+                      StringView& classNameOut)
+{
+    //Class names are separated by whitespaces
+    while(cursor < end && isspace(static_cast<unsigned char>(*cursor)))
+        cursor++;
+    const char* nameBegin = cursor;
+    while(cursor < end && !isspace(static_cast<unsigned char>(*cursor)))
+        cursor++;
+    classNameOut = StringView(nameBegin, cursor - nameBegin);
+    return cursor > nameBegin;
+}
 }
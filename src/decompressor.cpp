@@ -0,0 +1,355 @@
+#include "decompressor.h"
+
+#include <iostream>
+
+#ifdef IDOGAF_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef IDOGAF_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace idogaf
+{
+
+/** Number of bytes needed to recognize every format */
+const size_t kMagicLength = 4;
+/** Maximum number of bytes given to zlib at once */
+const size_t kMaxGzipInput = 1u << 30;
+
+Decompressor::Decompressor()
+{
+    silent_ = false;
+    failed_ = false;
+    started_ = false;
+    streamEnd_ = false;
+    compression_ = Compression::kNone;
+    decompressedSize_ = 0;
+    gzipStream_ = nullptr;
+    zstdStream_ = nullptr;
+}
+
+Decompressor::~Decompressor()
+{
+    FreeStreams();
+}
+
+//Getters
+Compression Decompressor::GetCompression() const
+{
+    return compression_;
+}
+size_t Decompressor::GetDecompressedSize() const
+{
+    return decompressedSize_;
+}
+bool Decompressor::Silent() const
+{
+    return silent_;
+}
+
+//Setters
+void Decompressor::Silent(bool silent)
+{
+    silent_ = silent;
+}
+
+//Other
+bool Decompressor::Supported(Compression compression)
+{
+    switch(compression)
+    {
+    case Compression::kNone:
+        return true;
+    case Compression::kGzip:
+#ifdef IDOGAF_HAVE_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    case Compression::kZstd:
+#ifdef IDOGAF_HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+Compression Decompressor::Detect(const char* data, size_t length)
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    if(length >= 2 && bytes[0] == 0x1F && bytes[1] == 0x8B)
+        return Compression::kGzip;
+    if(length >= 4 && bytes[0] == 0x28 && bytes[1] == 0xB5 && bytes[2] == 0x2F
+       && bytes[3] == 0xFD)
+        return Compression::kZstd;
+    return Compression::kNone;
+}
+
+void Decompressor::Reset()
+{
+    failed_ = false;
+    started_ = false;
+    streamEnd_ = false;
+    compression_ = Compression::kNone;
+    decompressedSize_ = 0;
+    header_.clear();
+}
+
+bool Decompressor::Parse(const std::string& filename, PushParser& parser)
+{
+    if(!file_.Open(filename))
+    {
+        if(!silent_)
+            std::cerr << "Error opening file " << filename << std::endl;
+        return false;
+    }
+    bool success = Parse(file_.GetData(), file_.GetSize(), parser);
+    file_.Close();
+    return success;
+}
+
+bool Decompressor::Parse(const char* data, size_t length, PushParser& parser)
+{
+    Reset();
+    if(!Feed(data, length, parser))
+    {
+        parser.Finish();
+        return false;
+    }
+    return Finish(parser);
+}
+
+bool Decompressor::Feed(const char* data, size_t length, PushParser& parser)
+{
+    if(failed_) return false;
+    if(!started_)
+    {
+        //Wait for enough bytes to recognize the format
+        if(header_.size() + length < kMagicLength)
+        {
+            header_.append(data, length);
+            return true;
+        }
+        if(!header_.empty())
+        {
+            size_t missing = kMagicLength - header_.size();
+            header_.append(data, missing);
+            data += missing;
+            length -= missing;
+        }
+        compression_ = Detect(header_.empty() ? data : header_.data(),
+                              header_.empty() ? length : header_.size());
+        if(!Start()) return false;
+        if(!header_.empty() && !Decompress(header_.data(), header_.size(), parser))
+            return false;
+        header_.clear();
+    }
+    return Decompress(data, length, parser);
+}
+
+bool Decompressor::Finish(PushParser& parser)
+{
+    if(failed_)
+    {
+        parser.Finish();
+        return false;
+    }
+    if(!started_)
+    {
+        //Input too short to be compressed
+        compression_ = Compression::kNone;
+        started_ = true;
+        streamEnd_ = true;
+        decompressedSize_ += header_.size();
+        bool fed = parser.Feed(header_.data(), header_.size());
+        header_.clear();
+        if(!fed)
+        {
+            parser.Finish();
+            return false;
+        }
+    }
+    if(!streamEnd_ && !parser.Finished())
+    {
+        DecompressError("Unexpected end of compressed data");
+        parser.Finish();
+        return false;
+    }
+    return parser.Finish();
+}
+
+//Protected member functions
+bool Decompressor::Start()
+{
+    started_ = true;
+    streamEnd_ = compression_ == Compression::kNone;
+    if(!Supported(compression_))
+        return DecompressError(compression_ == Compression::kGzip
+                               ? "gzip input is not supported, "
+                                 "idogaf was built without zlib"
+                               : "zstd input is not supported, "
+                                 "idogaf was built without libzstd");
+    if(compression_ == Compression::kNone) return true;
+    block_.resize(kBlockSize);
+#ifdef IDOGAF_HAVE_ZLIB
+    if(compression_ == Compression::kGzip)
+    {
+        z_stream* stream = static_cast<z_stream*>(gzipStream_);
+        if(stream == nullptr)
+        {
+            stream = new z_stream();
+            //32 enables gzip and zlib header detection
+            if(inflateInit2(stream, 15 + 32) != Z_OK)
+            {
+                delete stream;
+                return DecompressError("Can't initialize zlib");
+            }
+            gzipStream_ = stream;
+        }
+        else inflateReset(stream);
+    }
+#endif
+#ifdef IDOGAF_HAVE_ZSTD
+    if(compression_ == Compression::kZstd)
+    {
+        if(zstdStream_ == nullptr)
+        {
+            zstdStream_ = ZSTD_createDStream();
+            if(zstdStream_ == nullptr)
+                return DecompressError("Can't initialize libzstd");
+        }
+        ZSTD_initDStream(static_cast<ZSTD_DStream*>(zstdStream_));
+    }
+#endif
+    return true;
+}
+
+bool Decompressor::Decompress(const char* data, size_t length,
+                              PushParser& parser)
+{
+    if(parser.Finished() || length == 0) return true;
+    switch(compression_)
+    {
+    case Compression::kNone:
+        decompressedSize_ += length;
+        if(parser.Feed(data, length)) return true;
+        failed_ = true;
+        return false;
+    case Compression::kGzip:
+        //zlib takes at most 4 GiB at once
+        while(length > kMaxGzipInput)
+        {
+            if(!InflateGzip(data, kMaxGzipInput, parser)) return false;
+            data += kMaxGzipInput;
+            length -= kMaxGzipInput;
+        }
+        return InflateGzip(data, length, parser);
+    case Compression::kZstd:
+        return DecompressZstd(data, length, parser);
+    }
+    return false;
+}
+
+bool Decompressor::InflateGzip(const char* data, size_t length,
+                               PushParser& parser)
+{
+#ifdef IDOGAF_HAVE_ZLIB
+    z_stream* stream = static_cast<z_stream*>(gzipStream_);
+    stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream->avail_in = static_cast<uInt>(length);
+    do
+    {
+        if(streamEnd_)
+        {
+            if(stream->avail_in == 0) break;
+            //Concatenated gzip members make up one document
+            inflateReset(stream);
+            streamEnd_ = false;
+        }
+        stream->next_out = reinterpret_cast<Bytef*>(block_.data());
+        stream->avail_out = static_cast<uInt>(block_.size());
+        int result = inflate(stream, Z_NO_FLUSH);
+        if(result == Z_STREAM_END) streamEnd_ = true;
+        else if(result != Z_OK && result != Z_BUF_ERROR)
+            return DecompressError(stream->msg != nullptr ? stream->msg
+                                   : "Corrupted gzip data");
+        size_t produced = block_.size() - stream->avail_out;
+        decompressedSize_ += produced;
+        if(!parser.Feed(block_.data(), produced))
+        {
+            failed_ = true;
+            return false;
+        }
+    }
+    //A full block means more output may be pending
+    while(!parser.Finished()
+          && (stream->avail_in > 0 || stream->avail_out == 0));
+    return true;
+#else
+    (void)data;
+    (void)length;
+    (void)parser;
+    return DecompressError("gzip input is not supported");
+#endif
+}
+
+bool Decompressor::DecompressZstd(const char* data, size_t length,
+                                  PushParser& parser)
+{
+#ifdef IDOGAF_HAVE_ZSTD
+    ZSTD_DStream* stream = static_cast<ZSTD_DStream*>(zstdStream_);
+    ZSTD_inBuffer input = {data, length, 0};
+    while(!parser.Finished())
+    {
+        ZSTD_outBuffer output = {block_.data(), block_.size(), 0};
+        size_t result = ZSTD_decompressStream(stream, &output, &input);
+        if(ZSTD_isError(result))
+            return DecompressError(ZSTD_getErrorName(result));
+        //0 means a frame was completely decoded and flushed
+        streamEnd_ = result == 0;
+        decompressedSize_ += output.pos;
+        if(!parser.Feed(block_.data(), output.pos))
+        {
+            failed_ = true;
+            return false;
+        }
+        //Done when all input was consumed and nothing more is pending
+        if(input.pos == input.size && output.pos < output.size) break;
+    }
+    return true;
+#else
+    (void)data;
+    (void)length;
+    (void)parser;
+    return DecompressError("zstd input is not supported");
+#endif
+}
+
+void Decompressor::FreeStreams()
+{
+#ifdef IDOGAF_HAVE_ZLIB
+    if(gzipStream_ != nullptr)
+    {
+        inflateEnd(static_cast<z_stream*>(gzipStream_));
+        delete static_cast<z_stream*>(gzipStream_);
+    }
+#endif
+#ifdef IDOGAF_HAVE_ZSTD
+    if(zstdStream_ != nullptr)
+        ZSTD_freeDStream(static_cast<ZSTD_DStream*>(zstdStream_));
+#endif
+    gzipStream_ = nullptr;
+    zstdStream_ = nullptr;
+}
+
+bool Decompressor::DecompressError(const char* message)
+{
+    failed_ = true;
+    if(!silent_)
+        std::cerr << "Error: " << message << std::endl;
+    return false;
+}
+}
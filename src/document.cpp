@@ -1,5 +1,7 @@
 #include "document.h"
 
+#include <utility>
+
 namespace idogaf
 {
 
@@ -12,7 +14,8 @@ Document::Document()
 
 Document::Document(const Document& other)
 {
-    root_ = other.root_;
+    //Spans are stored in the arena of this document
+    root_ = Element(other.root_, arena_);
     doctype_ = other.doctype_;
 }
 
@@ -20,11 +23,29 @@ Document& Document::operator=(const Document& rhs)
 {
     if (this == &rhs) return *this; // handle self assignment
     //assignment operator
-    root_ = rhs.root_;
+    arena_.Clear();
+    root_ = Element(rhs.root_, arena_);
     doctype_ = rhs.doctype_;
     return *this;
 }
 
+Document::Document(Document&& other) noexcept
+    : root_(std::move(other.root_)), doctype_(std::move(other.doctype_))
+{
+    arena_.Swap(other.arena_);
+}
+
+Document& Document::operator=(Document&& rhs) noexcept
+{
+    if (this == &rhs) return *this; // handle self assignment
+    root_ = std::move(rhs.root_);
+    doctype_ = std::move(rhs.doctype_);
+    //The other document keeps the old arena, its tree no longer uses it
+    arena_.Swap(rhs.arena_);
+    rhs.arena_.Clear();
+    return *this;
+}
+
 //Getters
 std::string Document::GetDoctype() const
 {
@@ -46,15 +67,31 @@ bool Document::Empty() const
 {
     return doctype_.empty() && root_.Empty();
 }
+Arena& Document::GetArena()
+{
+    return arena_;
+}
 
 //Setters
 void Document::SetDoctype(std::string doctype)
 {
-    doctype_ = doctype;
+    doctype_ = std::move(doctype);
 }
-void Document::SetRoot(Element root)
+void Document::SetRoot(const Element& root)
 {
     root_ = root;
 }
+void Document::SetRoot(Element&& root)
+{
+    root_ = std::move(root);
+}
+
+//Other
+void Document::Swap(Document& other)
+{
+    root_.Swap(other.root_);
+    doctype_.swap(other.doctype_);
+    arena_.Swap(other.arena_);
+}
 
 }
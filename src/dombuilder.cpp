@@ -0,0 +1,192 @@
+#include "dombuilder.h"
+
+#include <utility>
+
+namespace idogaf
+{
+
+DomBuilder::DomBuilder(Document& document)
+{
+    document_ = &document;
+    current_ = nullptr;
+    rawTextMode_ = RawTextMode::kCopy;
+    reuse_ = false;
+    useArena_ = false;
+    started_ = false;
+}
+
+//Getters
+RawTextMode DomBuilder::GetRawTextMode() const
+{
+    return rawTextMode_;
+}
+bool DomBuilder::GetReuse() const
+{
+    return reuse_;
+}
+bool DomBuilder::GetUseArena() const
+{
+    return useArena_;
+}
+
+//Setters
+void DomBuilder::SetRawTextMode(RawTextMode mode)
+{
+    rawTextMode_ = mode;
+}
+void DomBuilder::SetReuse(bool value)
+{
+    reuse_ = value;
+}
+void DomBuilder::SetUseArena(bool value)
+{
+    useArena_ = value;
+}
+
+//Other
+void DomBuilder::Reset()
+{
+    current_ = nullptr;
+    stack_.clear();
+    built_.clear();
+    started_ = false;
+    if(useArena_)
+    {
+        //Reused elements drop their spans when they are recycled
+        if(!reuse_) document_->SetRoot(Element());
+        document_->GetArena().Clear();
+    }
+}
+
+void DomBuilder::Finish()
+{
+    if(!started_)
+    {
+        if(!reuse_) return;
+        Element* root = document_->GetRootPtr();
+        root->Recycle();
+        root->RemoveChildren();
+        return;
+    }
+    if(current_ == nullptr) return;
+    current_->RemoveChildrenFrom(built_.back());
+    for(size_t i = 0; i < stack_.size(); i++)
+        stack_[i]->RemoveChildrenFrom(built_[i]);
+}
+
+bool DomBuilder::OnStartTag(const StringView& name, Atom atom,
+                            TagLexer& attributes)
+{
+    //The element is filled in place, so it's never copied
+    Element* element;
+    if(current_ == nullptr)
+    {
+        if(!reuse_) document_->SetRoot(Element());
+        element = document_->GetRootPtr();
+        started_ = true;
+    }
+    else
+    {
+        unsigned int position = built_.back()++;
+        if(position < current_->GetChildrenCount())
+            element = current_->GetChildPtrAt(position);   //Reused
+        else
+        {
+            current_->AddChild(Element());
+            element = current_->GetLastChildPtr();
+        }
+        stack_.push_back(current_);
+    }
+    element->Recycle();
+    built_.push_back(0);
+    current_ = element;
+    element->SetSourceRange(sourceBegin_, sourceEnd_, sourceEnd_);
+    if(atom != kNoAtom) element->SetName(atom);
+    else element->SetName(name.ToString());
+    StringView attributeName, value;
+    bool references;
+    if(useArena_)
+    {
+        Arena& arena = document_->GetArena();
+        while(attributes.NextAttribute(attributeName, value, references))
+        {
+            Attribute attribute;
+            //Standard names are atoms, only others need to be stored
+            attribute.SetNameSpan(AtomTable::Find(attributeName) != kNoAtom
+                                  ? attributeName : arena.Store(attributeName));
+            attribute.SetValueSpan(arena.Store(value), references);
+            element->AddAtrribute(std::move(attribute));
+        }
+        return true;
+    }
+    while(attributes.NextAttribute(attributeName, value, references))
+    {
+        Attribute attribute(attributeName.ToString());
+        attribute.SetValue(value.ToString(), references);
+        element->AddAtrribute(std::move(attribute));
+    }
+    return true;
+}
+
+bool DomBuilder::OnEndTag(const StringView& name)
+{
+    (void)name;
+    if(current_ != nullptr)
+    {
+        current_->SetSourceRange(current_->GetSourceBegin(),
+                                 current_->GetOpenTagEnd(), sourceEnd_);
+        current_->RemoveChildrenFrom(built_.back());
+        built_.pop_back();
+    }
+    if(stack_.empty())
+        current_ = nullptr;
+    else
+    {
+        current_ = stack_.back();
+        stack_.pop_back();
+    }
+    return true;
+}
+
+bool DomBuilder::OnText(const StringView& text)
+{
+    if(current_ != nullptr) AddText(text, HasReferences());
+    return true;
+}
+
+bool DomBuilder::OnRawText(const StringView& text)
+{
+    if(current_ == nullptr) return true;
+    if(rawTextMode_ == RawTextMode::kCopy) AddText(text, HasReferences());
+    else if(rawTextMode_ == RawTextMode::kSpan)
+        current_->SetTextSpan(text, HasReferences());
+    return true;
+}
+
+bool DomBuilder::OnComment(const StringView& text)
+{
+    //Ignore comments for now
+    //Just add new line to the text
+    (void)text;
+    if(current_ != nullptr) AddText("\n", false);
+    return true;
+}
+
+bool DomBuilder::OnDoctype(const StringView& doctype)
+{
+    document_->SetDoctype(doctype.ToString());
+    if(current_ != nullptr) AddText("\n", false);
+    return true;
+}
+
+//Protected member functions
+void DomBuilder::AddText(const StringView& text, bool references)
+{
+    if(useArena_)
+        current_->SetTextSpan(document_->GetArena().Append(
+                                  current_->GetTextSpan(), text),
+                              current_->HasReferences() || references);
+    else
+        current_->AddText(text.ToString(), references);
+}
+}
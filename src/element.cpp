@@ -1,5 +1,9 @@
 #include "element.h"
 
+#include <iterator>
+#include <utility>
+
+#include "entitydecoder.h"
 #include "search.h"
 
 namespace idogaf
@@ -14,29 +18,31 @@ Element::Element()
 Element::Element(const std::string& name)
 {
     SetDefaultValues();
-    name_ = name;
+    SetName(name);
 }
 
 Element::Element(const std::string& name, const std::string& text,
                  Vector_E children, Vector_A attributes)
 {
-    name_ = name;
+    SetName(name);
     text_ = text;
-    children_ = children;
-    for(Vector_E_it it = children_.begin(); it != children_.end(); ++it)
-        it->parent_ = this;
+    textSpan_ = StringView();
+    textReferences_ = EntityDecoder::HasReferences(text_);
+    sourceBegin_ = openTagEnd_ = sourceEnd_ = 0;
+    children_ = std::move(children);
+    AdoptChildren();
     attributes_ = Vector_A();
     for(size_t i = 0; i < attributes.size(); i++)
     {
-        if(attributes[i].GetName() == "class")
+        if(attributes[i].GetAtom() == kAtomClass)
         {
             class_ = Class(attributes[i]);
         }
-        else if(attributes[i].GetName() == "id")
+        else if(attributes[i].GetAtom() == kAtomId)
         {
             id_ = Id(attributes[i]);
         }
-        else if(attributes[i].GetName() == "style")
+        else if(attributes[i].GetAtom() == kAtomStyle)
         {
             style_ = Style(attributes[i]);
         }
@@ -46,46 +52,90 @@ Element::Element(const std::string& name, const std::string& text,
         }
     }
     parent_ = nullptr;
+    position_ = 0;
 }
 
 Element::Element(const std::string& name, const std::string& text,
                  Vector_E children, Class css_class, Id id, Style style)
 {
-    name_ = name;
+    SetName(name);
     text_ = text;
-    children_ = children;
-    for(Vector_E_it it = children_.begin(); it != children_.end(); ++it)
-        it->parent_ = this;
+    textSpan_ = StringView();
+    textReferences_ = EntityDecoder::HasReferences(text_);
+    sourceBegin_ = openTagEnd_ = sourceEnd_ = 0;
+    children_ = std::move(children);
+    AdoptChildren();
     class_ = css_class;
     id_ = id;
     style_ = style;
     parent_ = nullptr;
+    position_ = 0;
 }
 
 Element::Element(const Element& other)
 {
+    //A copy owns its text, spans may outlive their arena or input
+    atom_ = other.atom_;
     name_ = other.name_;
-    text_ = other.text_;
+    text_ = other.textSpan_.Empty() ? other.text_ : other.textSpan_.ToString();
+    textSpan_ = StringView();
+    textReferences_ = other.textReferences_;
+    sourceBegin_ = other.sourceBegin_;
+    openTagEnd_ = other.openTagEnd_;
+    sourceEnd_ = other.sourceEnd_;
     children_ = other.children_;
-    for(Vector_E_it it = children_.begin(); it != children_.end(); ++it)
-        it->parent_ = this;
+    AdoptChildren();
     parent_ = nullptr;
+    position_ = 0;
     attributes_ = other.attributes_;
     class_ = other.class_;
     id_ = other.id_;
     style_ = other.style_;
 }
 
+Element::Element(const Element& other, Arena& arena)
+{
+    atom_ = other.atom_;
+    name_ = other.name_;
+    text_ = other.text_;
+    textSpan_ = other.textSpan_.Empty() ? StringView()
+                                        : arena.Store(other.textSpan_);
+    textReferences_ = other.textReferences_;
+    sourceBegin_ = other.sourceBegin_;
+    openTagEnd_ = other.openTagEnd_;
+    sourceEnd_ = other.sourceEnd_;
+    children_.reserve(other.children_.size());
+    for(Vector_E::const_iterator it = other.children_.begin();
+        it != other.children_.end(); ++it)
+        children_.push_back(Element(*it, arena));
+    AdoptChildren();
+    parent_ = nullptr;
+    position_ = 0;
+    attributes_.reserve(other.attributes_.size());
+    for(Vector_A::const_iterator it = other.attributes_.begin();
+        it != other.attributes_.end(); ++it)
+        attributes_.push_back(Attribute(*it, arena));
+    class_ = Class(Attribute(other.class_, arena));
+    id_ = Id(Attribute(other.id_, arena));
+    style_ = other.style_;
+}
+
 Element& Element::operator=(const Element& rhs)
 {
     if (this == &rhs) return *this; // handle self assignment
     //assignment operator
+    atom_ = rhs.atom_;
     name_ = rhs.name_;
-    text_ = rhs.text_;
+    text_ = rhs.textSpan_.Empty() ? rhs.text_ : rhs.textSpan_.ToString();
+    textSpan_ = StringView();
+    textReferences_ = rhs.textReferences_;
+    sourceBegin_ = rhs.sourceBegin_;
+    openTagEnd_ = rhs.openTagEnd_;
+    sourceEnd_ = rhs.sourceEnd_;
     children_ = rhs.children_;
-    for(Vector_E_it it = children_.begin(); it != children_.end(); ++it)
-        it->parent_ = this;
+    AdoptChildren();
     parent_ = nullptr;
+    position_ = 0;
     attributes_ = rhs.attributes_;
     class_ = rhs.class_;
     id_ = rhs.id_;
@@ -93,6 +143,50 @@ Element& Element::operator=(const Element& rhs)
     return *this;
 }
 
+Element::Element(Element&& other) noexcept
+    : name_(std::move(other.name_)), text_(std::move(other.text_)),
+      children_(std::move(other.children_)),
+      attributes_(std::move(other.attributes_)),
+      class_(std::move(other.class_)), id_(std::move(other.id_)),
+      style_(std::move(other.style_))
+{
+    atom_ = other.atom_;
+    textSpan_ = other.textSpan_;
+    textReferences_ = other.textReferences_;
+    sourceBegin_ = other.sourceBegin_;
+    openTagEnd_ = other.openTagEnd_;
+    sourceEnd_ = other.sourceEnd_;
+    AdoptChildren();
+    parent_ = nullptr;
+    position_ = 0;
+    other.atom_ = kNoAtom;
+    other.textSpan_ = StringView();
+    other.textReferences_ = false;
+}
+
+Element& Element::operator=(Element&& rhs) noexcept
+{
+    if (this == &rhs) return *this; // handle self assignment
+    atom_ = rhs.atom_;
+    name_ = std::move(rhs.name_);
+    text_ = std::move(rhs.text_);
+    textSpan_ = rhs.textSpan_;
+    textReferences_ = rhs.textReferences_;
+    sourceBegin_ = rhs.sourceBegin_;
+    openTagEnd_ = rhs.openTagEnd_;
+    sourceEnd_ = rhs.sourceEnd_;
+    children_ = std::move(rhs.children_);
+    AdoptChildren();
+    attributes_ = std::move(rhs.attributes_);
+    class_ = std::move(rhs.class_);
+    id_ = std::move(rhs.id_);
+    style_ = std::move(rhs.style_);
+    rhs.atom_ = kNoAtom;
+    rhs.textSpan_ = StringView();
+    rhs.textReferences_ = false;
+    return *this;
+}
+
 //Public member fuctions
 
 //Getters
@@ -102,31 +196,84 @@ Element Element::Copy() const
 }
 bool Element::Empty() const
 {
-    return name_.empty() && text_.empty() && attributes_.empty()
+    return atom_ == kNoAtom && name_.empty() && text_.empty() && textSpan_.Empty()
+           && attributes_.empty()
            && children_.empty() && class_.GetValue().empty()
            && id_.GetValue().empty() && style_.GetValue().empty();
 }
 std::string Element::GetName() const
 {
+    if(atom_ != kNoAtom) return AtomTable::GetName(atom_).ToString();
     return name_;
 }
+StringView Element::GetNameView() const
+{
+    if(atom_ != kNoAtom) return AtomTable::GetName(atom_);
+    return name_;
+}
+Atom Element::GetAtom() const
+{
+    return atom_;
+}
 std::string Element::GetText() const
 {
+    if(!textSpan_.Empty()) return textSpan_.ToString();
     return text_;
 }
+StringView Element::GetTextView() const
+{
+    if(!textSpan_.Empty()) return textSpan_;
+    return text_;
+}
+std::string Element::GetDecodedText() const
+{
+    if(!textReferences_) return GetText();
+    std::string text;
+    StringView view = GetTextView();
+    EntityDecoder::Decode(view.begin(), view.end(), text);
+    return text;
+}
+StringView Element::GetDecodedText(std::string& buffer) const
+{
+    StringView view = GetTextView();
+    if(!textReferences_) return view;
+    buffer.clear();
+    EntityDecoder::Decode(view.begin(), view.end(), buffer);
+    return buffer;
+}
+bool Element::HasReferences() const
+{
+    return textReferences_;
+}
+StringView Element::GetTextSpan() const
+{
+    return textSpan_;
+}
+size_t Element::GetSourceBegin() const
+{
+    return sourceBegin_;
+}
+size_t Element::GetOpenTagEnd() const
+{
+    return openTagEnd_;
+}
+size_t Element::GetSourceEnd() const
+{
+    return sourceEnd_;
+}
 Element* Element::GetParent()
 {
     return parent_;
 }
-Class Element::GetClass() const
+const Class& Element::GetClass() const
 {
     return class_;
 }
-Id Element::GetId() const
+const Id& Element::GetId() const
 {
     return id_;
 }
-Style Element::GetStyle() const
+const Style& Element::GetStyle() const
 {
     return style_;
 }
@@ -144,9 +291,10 @@ Vector_P Element::GetChildrenPtr()
 Vector_E Element::GetChildrenByTagName(const std::string& name)
 {
     Vector_E result;
+    Atom atom = AtomTable::Find(name);
     for(Vector_E_it it = children_.begin(); it != children_.end(); ++it)
     {
-        if(it->GetName() == name)
+        if(it->HasName(atom, name))
             result.push_back(*it);
     }
     return result;
@@ -154,9 +302,10 @@ Vector_E Element::GetChildrenByTagName(const std::string& name)
 Vector_P Element::GetChildrenPtrByTagName(const std::string& name)
 {
     Vector_P result;
+    Atom atom = AtomTable::Find(name);
     for(Vector_E_it it = children_.begin(); it != children_.end(); ++it)
     {
-        if(it->GetName() == name)
+        if(it->HasName(atom, name))
             result.push_back(&(*it));
     }
     return result;
@@ -231,61 +380,128 @@ size_t Element::GetChildrenCount() const
 }
 Vector_A Element::GetAttributes() const
 {
-    Vector_A result = attributes_;
-    if(!style_.GetValue().empty()) result.insert(result.begin(), style_);
-    if(!class_.GetValue().empty()) result.insert(result.begin(), class_);
-    if(!id_.GetValue().empty()) result.insert(result.begin(), id_);
-
+    Vector_A result;
+    result.reserve(GetAttributeCount());
+    for(AttributeIterator it = AttributesBegin(); it != AttributesEnd(); ++it)
+        result.push_back(*it);
     return result;
 }
+size_t Element::GetAttributeCount() const
+{
+    return attributes_.size() + !id_.GetValueView().Empty()
+           + !class_.GetValueView().Empty() + !style_.GetValueView().Empty();
+}
+AttributeIterator Element::AttributesBegin() const
+{
+    return AttributeIterator(this, 0);
+}
+AttributeIterator Element::AttributesEnd() const
+{
+    //Positions of id, class and style come before the other attributes
+    return AttributeIterator(this, 3 + attributes_.size());
+}
 Attribute Element::GetAttributeByName(const std::string& name)
 {
-    if(name == Class::GetStaticName()) return class_;
-    if(name == Id::GetStaticName()) return id_;
-    if(name == Style::GetStaticName()) return style_;
+    const Attribute* attribute = GetAttributePtrByName(name);
+    if(attribute == nullptr) return Attribute();
+    return *attribute;
+}
+const Attribute* Element::GetAttributePtrByName(const std::string& name) const
+{
+    return GetAttributePtrByName(AtomTable::Find(name), name);
+}
+const Attribute* Element::GetAttributePtrByName(Atom atom,
+                                                const std::string& name) const
+{
+    const Attribute* common = nullptr;
+    if(atom == kAtomClass) common = &class_;
+    else if(atom == kAtomId) common = &id_;
+    else if(atom == kAtomStyle) common = &style_;
+    if(common != nullptr)
+        return common->GetValueView().Empty() ? nullptr : common;
 
-    for(Vector_A_it it = attributes_.begin(); it != attributes_.end(); ++it)
+    for(Vector_A::const_iterator it = attributes_.begin();
+        it != attributes_.end(); ++it)
     {
-        if(it->GetName() == name) return *it;
+        if(it->HasName(atom, name)) return &*it;
     }
-    return Attribute();
+    return nullptr;
+}
+unsigned int Element::GetPosition() const
+{
+    return position_;
 }
 bool Element::HasRightBrother() const
 {
-    if(parent_ == nullptr) return false;
-    for(size_t i = 0; i < parent_->GetChildrenCount(); i++)
-    {
-        if(parent_->GetChildPtrAt(i) == this)
-            return i+1 < parent_->GetChildrenCount();
-    }
-    return false;
+    return parent_ != nullptr && position_ + 1 < parent_->children_.size();
 }
 Element* Element::GetRightBrotherPtr()
 {
-    if(parent_ == nullptr) return nullptr;
-    for(size_t i = 0; i < parent_->GetChildrenCount(); i++)
-    {
-        if(parent_->GetChildPtrAt(i) == this)
-        {
-            if(i+1 < parent_->GetChildrenCount())
-                return parent_->GetChildPtrAt(i+1);
-            else break;
-        }
-    }
-    return nullptr;
+    if(!HasRightBrother()) return nullptr;
+    return &parent_->children_[position_ + 1];
+}
+bool Element::HasLeftBrother() const
+{
+    return parent_ != nullptr && position_ > 0;
+}
+Element* Element::GetLeftBrotherPtr()
+{
+    if(!HasLeftBrother()) return nullptr;
+    return &parent_->children_[position_ - 1];
 }
 //Setters
 void Element::SetName(const std::string& name)
 {
-    name_ = name;
+    atom_ = AtomTable::Find(name);
+    if(atom_ != kNoAtom) name_.clear();
+    else name_ = name;
+}
+void Element::SetName(Atom atom)
+{
+    atom_ = atom;
+    name_.clear();
 }
 void Element::SetText(const std::string& text)
 {
     text_ = text;
+    textSpan_ = StringView();
+    textReferences_ = EntityDecoder::HasReferences(text_);
+}
+void Element::SetText(std::string&& text)
+{
+    text_ = std::move(text);
+    textSpan_ = StringView();
+    textReferences_ = EntityDecoder::HasReferences(text_);
 }
 void Element::AddText(const std::string& text)
 {
+    AddText(text, EntityDecoder::HasReferences(text));
+}
+void Element::AddText(const std::string& text, bool references)
+{
+    if(!textSpan_.Empty())
+    {
+        text_ = textSpan_.ToString();
+        textSpan_ = StringView();
+    }
     text_ += text;
+    textReferences_ = textReferences_ || references;
+}
+void Element::SetTextSpan(const StringView& text)
+{
+    SetTextSpan(text, EntityDecoder::HasReferences(text.begin(), text.end()));
+}
+void Element::SetTextSpan(const StringView& text, bool references)
+{
+    text_.clear();
+    textSpan_ = text;
+    textReferences_ = references;
+}
+void Element::SetSourceRange(size_t begin, size_t openTagEnd, size_t end)
+{
+    sourceBegin_ = begin;
+    openTagEnd_ = openTagEnd;
+    sourceEnd_ = end;
 }
 void Element::SetClass(Class newClass)
 {
@@ -308,24 +524,50 @@ void Element::RemoveChildAt(unsigned int position)
 {
     if(position >= children_.size()) return;
     children_.erase(children_.begin()+position);
+    AdoptChildren(position);
 }
-void Element::AddChild(Element child)
+void Element::RemoveChildrenFrom(unsigned int position)
 {
-    children_.push_back(child);
-    children_.back().parent_ = this;
+    if(position >= children_.size()) return;
+    children_.erase(children_.begin()+position, children_.end());
+}
+void Element::AddChild(const Element& child)
+{
+    AddChild(Element(child));
+}
+void Element::AddChild(Element&& child)
+{
+    const Element* data = children_.data();
+    children_.push_back(std::move(child));
+    //Children moved to a new buffer are left without a parent
+    AdoptChildren(children_.data() == data ? children_.size() - 1 : 0);
+}
+void Element::AddChildAt(const Element& child, unsigned int position)
+{
+    AddChildAt(Element(child), position);
 }
-void Element::AddChildAt(Element child, unsigned int position)
+void Element::AddChildAt(Element&& child, unsigned int position)
 {
     if(position >= children_.size()) return;
-    children_.insert(children_.begin()+position, child);
-    children_[position].parent_ = this;
+    const Element* data = children_.data();
+    children_.insert(children_.begin()+position, std::move(child));
+    AdoptChildren(children_.data() == data ? position : 0);
 }
-void Element::AddChildren(Vector_E children)
+void Element::AddChildren(const Vector_E& children)
 {
     size_t prevSize = children_.size();
+    const Element* data = children_.data();
     children_.insert(children_.end(), children.begin(), children.end());
-    for(Vector_E_it it = children_.begin()+prevSize; it != children_.end(); ++it)
-        it->parent_ = this;
+    AdoptChildren(children_.data() == data ? prevSize : 0);
+}
+void Element::AddChildren(Vector_E&& children)
+{
+    size_t prevSize = children_.size();
+    const Element* data = children_.data();
+    children_.insert(children_.end(),
+                     std::make_move_iterator(children.begin()),
+                     std::make_move_iterator(children.end()));
+    AdoptChildren(children_.data() == data ? prevSize : 0);
 }
 
 void Element::RemoveAttributes()
@@ -337,17 +579,18 @@ void Element::RemoveAttributes()
 }
 void Element::RemoveAttributeByName(const std::string& name)
 {
-    if(name == Class::GetStaticName())
+    Atom atom = AtomTable::Find(name);
+    if(atom == kAtomClass)
     {
         class_ = Class();
         return;
     }
-    if(name == Id::GetStaticName())
+    if(atom == kAtomId)
     {
         id_ = Id();
         return;
     }
-    if(name == Style::GetStaticName())
+    if(atom == kAtomStyle)
     {
         style_ = Style();
         return;
@@ -355,26 +598,30 @@ void Element::RemoveAttributeByName(const std::string& name)
 
     for(Vector_A_it it = attributes_.begin(); it != attributes_.end(); ++it)
     {
-        if(it->GetName() == name)
+        if(it->HasName(atom, name))
         {
             attributes_.erase(it);
             return;
         }
     }
 }
-void Element::AddAtrribute(Attribute attribute)
+void Element::AddAtrribute(const Attribute& attribute)
 {
-    if(attribute.GetName() == Class::GetStaticName())
+    AddAtrribute(Attribute(attribute));
+}
+void Element::AddAtrribute(Attribute&& attribute)
+{
+    if(attribute.GetAtom() == kAtomClass)
     {
         class_ = Class(attribute);
         return;
     }
-    if(attribute.GetName() == Id::GetStaticName())
+    if(attribute.GetAtom() == kAtomId)
     {
         id_ = Id(attribute);
         return;
     }
-    if(attribute.GetName() == Style::GetStaticName())
+    if(attribute.GetAtom() == kAtomStyle)
     {
         style_ = Style(attribute);
         return;
@@ -382,14 +629,56 @@ void Element::AddAtrribute(Attribute attribute)
 
     for(Vector_A_it it = attributes_.begin(); it != attributes_.end(); ++it)
     {
-        if(it->GetName() == attribute.GetName())
+        if(it->GetAtom() == attribute.GetAtom()
+           && (attribute.GetAtom() != kNoAtom
+               || it->GetNameView() == attribute.GetNameView()))
         {
-            *it = attribute;
+            *it = std::move(attribute);
             return;
         }
     }
 
-    attributes_.push_back(attribute);
+    attributes_.push_back(std::move(attribute));
+}
+
+bool Element::HasName(const std::string& name) const
+{
+    return HasName(AtomTable::Find(name), name);
+}
+bool Element::HasName(Atom atom, const std::string& name) const
+{
+    return AtomTable::Equal(atom_, name_, atom, name);
+}
+
+void Element::Swap(Element& other)
+{
+    if(this == &other) return;
+    std::swap(atom_, other.atom_);
+    name_.swap(other.name_);
+    text_.swap(other.text_);
+    std::swap(textSpan_, other.textSpan_);
+    std::swap(textReferences_, other.textReferences_);
+    std::swap(sourceBegin_, other.sourceBegin_);
+    std::swap(openTagEnd_, other.openTagEnd_);
+    std::swap(sourceEnd_, other.sourceEnd_);
+    children_.swap(other.children_);
+    AdoptChildren();
+    other.AdoptChildren();
+    attributes_.swap(other.attributes_);
+    std::swap(class_, other.class_);
+    std::swap(id_, other.id_);
+    std::swap(style_, other.style_);
+}
+
+void Element::Recycle()
+{
+    atom_ = kNoAtom;
+    name_.clear();
+    text_.clear();
+    textSpan_ = StringView();
+    textReferences_ = false;
+    sourceBegin_ = openTagEnd_ = sourceEnd_ = 0;
+    RemoveAttributes();
 }
 
 Vector_E Element::Find(const std::string& query) const
@@ -405,13 +694,29 @@ Vector_P Element::FindPtr(const std::string& query)
 //Protected member functions
 void Element::SetDefaultValues()
 {
+    atom_       = kNoAtom;
     name_       = std::string();
     text_       = std::string();
+    textSpan_   = StringView();
+    textReferences_ = false;
+    sourceBegin_ = 0;
+    openTagEnd_ = 0;
+    sourceEnd_  = 0;
     children_   = Vector_E();
     parent_     = nullptr;
+    position_   = 0;
     attributes_ = Vector_A();
     class_      = Class();
     id_         = Id();
     style_      = Style();
 }
+
+void Element::AdoptChildren(size_t from)
+{
+    for(size_t i = from; i < children_.size(); i++)
+    {
+        children_[i].parent_ = this;
+        children_[i].position_ = static_cast<unsigned int>(i);
+    }
+}
 }
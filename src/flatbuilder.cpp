@@ -0,0 +1,85 @@
+#include "flatbuilder.h"
+
+namespace idogaf
+{
+
+FlatBuilder::FlatBuilder(FlatDocument& document)
+{
+    document_ = &document;
+    rawTextMode_ = RawTextMode::kCopy;
+}
+
+//Getters
+RawTextMode FlatBuilder::GetRawTextMode() const
+{
+    return rawTextMode_;
+}
+
+//Setters
+void FlatBuilder::SetRawTextMode(RawTextMode mode)
+{
+    rawTextMode_ = mode;
+}
+
+//Other
+void FlatBuilder::Reset()
+{
+    stack_.clear();
+    document_->Clear();
+}
+
+bool FlatBuilder::OnStartTag(const StringView& name, Atom atom,
+                             TagLexer& attributes)
+{
+    unsigned int parent = stack_.empty() ? FlatDocument::kNoNode : stack_.back();
+    unsigned int index = document_->AddElement(parent, atom, name);
+    document_->SetSourceRange(index, sourceBegin_, sourceEnd_, sourceEnd_);
+    stack_.push_back(index);
+    StringView attributeName, value;
+    while(attributes.NextAttribute(attributeName, value))
+        document_->AddAttribute(attributeName, value);
+    return true;
+}
+
+bool FlatBuilder::OnEndTag(const StringView& name)
+{
+    (void)name;
+    if(stack_.empty()) return true;
+    FlatElement element = document_->GetElement(stack_.back());
+    document_->SetSourceRange(stack_.back(), element.GetSourceBegin(),
+                              element.GetOpenTagEnd(), sourceEnd_);
+    stack_.pop_back();
+    return true;
+}
+
+bool FlatBuilder::OnText(const StringView& text)
+{
+    if(!stack_.empty())
+        document_->AddText(stack_.back(), text, HasReferences());
+    return true;
+}
+
+bool FlatBuilder::OnRawText(const StringView& text)
+{
+    if(stack_.empty()) return true;
+    if(rawTextMode_ == RawTextMode::kCopy)
+        document_->AddText(stack_.back(), text, HasReferences());
+    else if(rawTextMode_ == RawTextMode::kSpan)
+        document_->SetTextSpan(stack_.back(), text, HasReferences());
+    return true;
+}
+
+bool FlatBuilder::OnComment(const StringView& text)
+{
+    (void)text;
+    if(!stack_.empty()) document_->AddText(stack_.back(), "\n", false);
+    return true;
+}
+
+bool FlatBuilder::OnDoctype(const StringView& doctype)
+{
+    document_->SetDoctype(doctype.ToString());
+    if(!stack_.empty()) document_->AddText(stack_.back(), "\n", false);
+    return true;
+}
+}
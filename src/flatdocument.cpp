@@ -0,0 +1,580 @@
+#include "flatdocument.h"
+
+#include "entitydecoder.h"
+#include "misc.h"
+
+namespace idogaf
+{
+
+static void WriteView(std::ostream& stream, const StringView& view)
+{
+    stream.write(view.GetData(), view.GetLength());
+}
+
+FlatElement::FlatElement()
+{
+    document_ = nullptr;
+    index_ = FlatDocument::kNoNode;
+}
+
+FlatElement::FlatElement(const FlatDocument* document, unsigned int index)
+{
+    document_ = document;
+    index_ = index;
+}
+
+//Getters
+bool FlatElement::Valid() const
+{
+    return document_ != nullptr && index_ != FlatDocument::kNoNode;
+}
+unsigned int FlatElement::GetIndex() const
+{
+    return index_;
+}
+std::string FlatElement::GetName() const
+{
+    return document_->names_[index_].ToString();
+}
+StringView FlatElement::GetNameView() const
+{
+    return document_->names_[index_];
+}
+Atom FlatElement::GetAtom() const
+{
+    return document_->atoms_[index_];
+}
+std::string FlatElement::GetText() const
+{
+    return document_->texts_[index_].ToString();
+}
+std::string FlatElement::GetDecodedText() const
+{
+    StringView span = document_->texts_[index_];
+    if(!document_->textReferences_[index_]) return span.ToString();
+    std::string text;
+    EntityDecoder::Decode(span.begin(), span.end(), text);
+    return text;
+}
+StringView FlatElement::GetDecodedText(std::string& buffer) const
+{
+    StringView span = document_->texts_[index_];
+    if(!document_->textReferences_[index_]) return span;
+    buffer.clear();
+    EntityDecoder::Decode(span.begin(), span.end(), buffer);
+    return buffer;
+}
+bool FlatElement::HasReferences() const
+{
+    return document_->textReferences_[index_];
+}
+StringView FlatElement::GetTextSpan() const
+{
+    return document_->texts_[index_];
+}
+size_t FlatElement::GetSourceBegin() const
+{
+    return document_->sourceBegins_[index_];
+}
+size_t FlatElement::GetOpenTagEnd() const
+{
+    return document_->openTagEnds_[index_];
+}
+size_t FlatElement::GetSourceEnd() const
+{
+    return document_->sourceEnds_[index_];
+}
+FlatElement FlatElement::GetParent() const
+{
+    return FlatElement(document_, document_->parents_[index_]);
+}
+FlatElement FlatElement::GetFirstChild() const
+{
+    return FlatElement(document_, document_->firstChildren_[index_]);
+}
+FlatElement FlatElement::GetLastChild() const
+{
+    return FlatElement(document_, document_->lastChildren_[index_]);
+}
+FlatElement FlatElement::GetChildAt(unsigned int position) const
+{
+    unsigned int child = document_->firstChildren_[index_];
+    while(position-- > 0 && child != FlatDocument::kNoNode)
+        child = document_->nextSiblings_[child];
+    return FlatElement(document_, child);
+}
+size_t FlatElement::GetChildrenCount() const
+{
+    size_t count = 0;
+    for(unsigned int child = document_->firstChildren_[index_];
+        child != FlatDocument::kNoNode; child = document_->nextSiblings_[child])
+        count++;
+    return count;
+}
+Vector_F FlatElement::GetChildren() const
+{
+    Vector_F children;
+    for(unsigned int child = document_->firstChildren_[index_];
+        child != FlatDocument::kNoNode; child = document_->nextSiblings_[child])
+        children.push_back(FlatElement(document_, child));
+    return children;
+}
+bool FlatElement::HasRightBrother() const
+{
+    return document_->nextSiblings_[index_] != FlatDocument::kNoNode;
+}
+FlatElement FlatElement::GetRightBrother() const
+{
+    return FlatElement(document_, document_->nextSiblings_[index_]);
+}
+size_t FlatElement::GetAttributeCount() const
+{
+    return document_->GetAttributeEnd(index_)
+           - document_->attributeBegins_[index_];
+}
+StringView FlatElement::GetAttributeName(size_t position) const
+{
+    return document_->attributeNames_[document_->attributeBegins_[index_]
+                                      + position];
+}
+StringView FlatElement::GetAttributeValue(size_t position) const
+{
+    return document_->attributeValues_[document_->attributeBegins_[index_]
+                                       + position];
+}
+StringView FlatElement::GetAttributeValue(const std::string& name) const
+{
+    Atom atom = AtomTable::Find(name);
+    unsigned int end = document_->GetAttributeEnd(index_);
+    for(unsigned int i = document_->attributeBegins_[index_]; i < end; i++)
+        if(AtomTable::Equal(document_->attributeAtoms_[i],
+                            document_->attributeNames_[i], atom, name))
+            return document_->attributeValues_[i];
+    return StringView();
+}
+Vector_A FlatElement::GetAttributes() const
+{
+    Vector_A attributes;
+    unsigned int end = document_->GetAttributeEnd(index_);
+    for(unsigned int i = document_->attributeBegins_[index_]; i < end; i++)
+        attributes.push_back(Attribute(document_->attributeNames_[i].ToString(),
+                                       document_->attributeValues_[i].ToString()));
+    return attributes;
+}
+Attribute FlatElement::GetAttributeByName(const std::string& name) const
+{
+    Atom atom = AtomTable::Find(name);
+    unsigned int end = document_->GetAttributeEnd(index_);
+    for(unsigned int i = document_->attributeBegins_[index_]; i < end; i++)
+        if(AtomTable::Equal(document_->attributeAtoms_[i],
+                            document_->attributeNames_[i], atom, name))
+            return Attribute(name, document_->attributeValues_[i].ToString());
+    return Attribute();
+}
+Class FlatElement::GetClass() const
+{
+    return Class(Attribute("class", GetAttributeValue("class").ToString()));
+}
+Id FlatElement::GetId() const
+{
+    return Id(Attribute("id", GetAttributeValue("id").ToString()));
+}
+
+//Other
+bool FlatElement::HasName(const std::string& name) const
+{
+    return AtomTable::Equal(document_->atoms_[index_], document_->names_[index_],
+                            AtomTable::Find(name), name);
+}
+Vector_F FlatElement::Find(const std::string& query) const
+{
+    return document_->Find(query, index_, document_->GetSubtreeEnd(index_));
+}
+bool FlatElement::operator==(const FlatElement& other) const
+{
+    return document_ == other.document_ && index_ == other.index_;
+}
+bool FlatElement::operator!=(const FlatElement& other) const
+{
+    return !(*this == other);
+}
+
+const unsigned int FlatDocument::kNoNode;
+
+FlatDocument::FlatDocument()
+{
+}
+
+//Getters
+size_t FlatDocument::GetSize() const
+{
+    return atoms_.size();
+}
+bool FlatDocument::Empty() const
+{
+    return atoms_.empty() && doctype_.empty();
+}
+FlatElement FlatDocument::GetRoot() const
+{
+    return FlatElement(this, atoms_.empty() ? kNoNode : 0);
+}
+FlatElement FlatDocument::GetElement(unsigned int index) const
+{
+    return FlatElement(this, index);
+}
+const std::string& FlatDocument::GetDoctype() const
+{
+    return doctype_;
+}
+Arena& FlatDocument::GetArena()
+{
+    return arena_;
+}
+
+//Setters
+void FlatDocument::SetDoctype(const std::string& doctype)
+{
+    doctype_ = doctype;
+}
+
+//Other
+void FlatDocument::Clear()
+{
+    atoms_.clear();
+    names_.clear();
+    parents_.clear();
+    firstChildren_.clear();
+    lastChildren_.clear();
+    nextSiblings_.clear();
+    attributeBegins_.clear();
+    texts_.clear();
+    textReferences_.clear();
+    sourceBegins_.clear();
+    openTagEnds_.clear();
+    sourceEnds_.clear();
+    attributeAtoms_.clear();
+    attributeNames_.clear();
+    attributeValues_.clear();
+    doctype_.clear();
+    arena_.Clear();
+}
+
+unsigned int FlatDocument::AddElement(unsigned int parent, Atom atom,
+                                      const StringView& name)
+{
+    unsigned int index = static_cast<unsigned int>(atoms_.size());
+    atoms_.push_back(atom);
+    names_.push_back(atom != kNoAtom ? AtomTable::GetName(atom)
+                                     : arena_.Store(name));
+    parents_.push_back(parent);
+    firstChildren_.push_back(kNoNode);
+    lastChildren_.push_back(kNoNode);
+    nextSiblings_.push_back(kNoNode);
+    attributeBegins_.push_back(static_cast<unsigned int>(attributeNames_.size()));
+    texts_.push_back(StringView());
+    textReferences_.push_back(false);
+    sourceBegins_.push_back(0);
+    openTagEnds_.push_back(0);
+    sourceEnds_.push_back(0);
+    unsigned int previous = kNoNode;
+    if(parent != kNoNode)
+    {
+        previous = lastChildren_[parent];
+        if(previous == kNoNode) firstChildren_[parent] = index;
+        lastChildren_[parent] = index;
+    }
+    else if(index > 0)
+    {
+        //Another top-level element, rare enough to walk the top level
+        previous = 0;
+        while(nextSiblings_[previous] != kNoNode)
+            previous = nextSiblings_[previous];
+    }
+    if(previous != kNoNode) nextSiblings_[previous] = index;
+    return index;
+}
+
+void FlatDocument::AddAttribute(const StringView& name, const StringView& value)
+{
+    Atom atom = AtomTable::Find(name);
+    for(size_t i = attributeBegins_.back(); i < attributeNames_.size(); i++)
+    {
+        if(AtomTable::Equal(attributeAtoms_[i], attributeNames_[i], atom, name))
+        {
+            attributeValues_[i] = arena_.Store(value);
+            return;
+        }
+    }
+    attributeAtoms_.push_back(atom);
+    attributeNames_.push_back(atom != kNoAtom ? AtomTable::GetName(atom)
+                                              : arena_.Store(name));
+    attributeValues_.push_back(arena_.Store(value));
+}
+
+void FlatDocument::AddText(unsigned int index, const StringView& text)
+{
+    AddText(index, text, EntityDecoder::HasReferences(text.begin(), text.end()));
+}
+
+void FlatDocument::AddText(unsigned int index, const StringView& text,
+                           bool references)
+{
+    texts_[index] = arena_.Append(texts_[index], text);
+    if(references) textReferences_[index] = true;
+}
+
+void FlatDocument::SetTextSpan(unsigned int index, const StringView& text)
+{
+    SetTextSpan(index, text,
+                EntityDecoder::HasReferences(text.begin(), text.end()));
+}
+
+void FlatDocument::SetTextSpan(unsigned int index, const StringView& text,
+                               bool references)
+{
+    texts_[index] = text;
+    textReferences_[index] = references;
+}
+
+void FlatDocument::SetSourceRange(unsigned int index, size_t begin,
+                                  size_t openTagEnd, size_t end)
+{
+    sourceBegins_[index] = begin;
+    openTagEnds_[index] = openTagEnd;
+    sourceEnds_[index] = end;
+}
+
+Vector_F FlatDocument::Find(const std::string& query) const
+{
+    return Find(query, 0, static_cast<unsigned int>(atoms_.size()));
+}
+
+bool FlatDocument::WriteToStream(std::ostream& stream) const
+{
+    if(Empty()) return false;
+    if(!doctype_.empty()) stream << "<!DOCTYPE " << doctype_ << ">\n";
+    //Open elements with children, closed once the walk leaves them
+    std::vector<unsigned int> open;
+    for(unsigned int i = 0; i < atoms_.size(); i++)
+    {
+        while(!open.empty() && open.back() != parents_[i])
+        {
+            unsigned int index = open.back();
+            open.pop_back();
+            WriteClosingTag(index, stream,
+                            static_cast<unsigned int>(open.size()));
+        }
+        WriteOpeningTag(i, stream, static_cast<unsigned int>(open.size()));
+        if(firstChildren_[i] != kNoNode) open.push_back(i);
+    }
+    while(!open.empty())
+    {
+        unsigned int index = open.back();
+        open.pop_back();
+        WriteClosingTag(index, stream, static_cast<unsigned int>(open.size()));
+    }
+    return true;
+}
+
+//Protected member functions
+unsigned int FlatDocument::GetAttributeEnd(unsigned int index) const
+{
+    if(index + 1 < attributeBegins_.size()) return attributeBegins_[index + 1];
+    return static_cast<unsigned int>(attributeNames_.size());
+}
+
+unsigned int FlatDocument::GetSubtreeEnd(unsigned int index) const
+{
+    //Preorder keeps every subtree contiguous, it ends where the next
+    //sibling of the element or of its closest ancestor having one begins
+    while(index != kNoNode)
+    {
+        if(nextSiblings_[index] != kNoNode) return nextSiblings_[index];
+        index = parents_[index];
+    }
+    return static_cast<unsigned int>(atoms_.size());
+}
+
+Vector_F FlatDocument::Find(const std::string& query, unsigned int begin,
+                            unsigned int end) const
+{
+    Vector_F result;
+    std::vector<Search::Complex> complexes;
+    Search::ParseQuery(query, complexes);
+    for(unsigned int i = begin; i < end; i++)
+    {
+        for(size_t j = 0; j < complexes.size(); j++)
+        {
+            //Like in Search an empty query leaves just the root
+            if(complexes[j].empty() ? i == begin
+               : IsReached(complexes[j], complexes[j].size() - 1, i, begin, end))
+            {
+                result.push_back(FlatElement(this, i));
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+void FlatDocument::WriteOpeningTag(unsigned int index, std::ostream& stream,
+                                   unsigned int indent) const
+{
+    std::string indentation(indent, '\t');
+    stream << indentation << '<';
+    WriteView(stream, names_[index]);
+    //Like Element::GetAttributes(), id, class and style come first
+    //and are left out if empty
+    static const Atom kCommonAtoms[] = { kAtomId, kAtomClass, kAtomStyle };
+    for(size_t i = 0; i < 3; i++)
+    {
+        StringView value = GetAttributeValue(index, kCommonAtoms[i]);
+        if(value.Empty()) continue;
+        stream << ' ';
+        WriteView(stream, AtomTable::GetName(kCommonAtoms[i]));
+        stream << "=\"";
+        WriteView(stream, value);
+        stream << '"';
+    }
+    for(unsigned int i = attributeBegins_[index]; i < GetAttributeEnd(index); i++)
+    {
+        Atom atom = attributeAtoms_[i];
+        if(atom == kAtomId || atom == kAtomClass || atom == kAtomStyle)
+            continue;
+        stream << ' ';
+        WriteView(stream, attributeNames_[i]);
+        stream << "=\"";
+        WriteView(stream, attributeValues_[i]);
+        stream << '"';
+    }
+    Atom atom = atoms_[index];
+    const StringView& text = texts_[index];
+    bool hasChildren = firstChildren_[index] != kNoNode;
+    if(!hasChildren && text.Empty() && atom != kAtomMeta && atom != kAtomLink
+       && atom != kAtomScript)
+        stream << "/>\n";
+    else if(!hasChildren && !text.Empty())
+    {
+        stream << ">\n" << indentation << '\t';
+        //Every line of the text is indented
+        const char* line = text.begin();
+        for(const char* it = text.begin(); it != text.end(); ++it)
+        {
+            if(*it != '\n') continue;
+            stream.write(line, it + 1 - line);
+            stream << indentation << '\t';
+            line = it + 1;
+        }
+        stream.write(line, text.end() - line);
+        stream << '\n';
+        WriteClosingTag(index, stream, indent);
+    }
+    else if(atom == kAtomScript)
+    {
+        stream << '>';
+        WriteClosingTag(index, stream, 0);
+    }
+    else
+        stream << ">\n";
+}
+
+void FlatDocument::WriteClosingTag(unsigned int index, std::ostream& stream,
+                                   unsigned int indent) const
+{
+    stream << std::string(indent, '\t') << "</";
+    WriteView(stream, names_[index]);
+    stream << ">\n";
+}
+
+StringView FlatDocument::GetAttributeValue(unsigned int index, Atom atom) const
+{
+    unsigned int end = GetAttributeEnd(index);
+    for(unsigned int i = attributeBegins_[index]; i < end; i++)
+        if(attributeAtoms_[i] == atom) return attributeValues_[i];
+    return StringView();
+}
+
+bool FlatDocument::CheckSelector(const Search::Selector& selector,
+                                 unsigned int index) const
+{
+    switch(selector.type)
+    {
+    case '.':
+        return Search::_ofClass(GetAttributeValue(index, kAtomClass),
+                                selector.name);
+    case '#':
+        return Search::_hasId(GetAttributeValue(index, kAtomId), selector.name);
+    case '[':
+    {
+        bool any = selector.name == "*";
+        unsigned int end = GetAttributeEnd(index);
+        for(unsigned int i = attributeBegins_[index]; i < end; i++)
+        {
+            Atom atom = attributeAtoms_[i];
+            //Element keeps empty class, id and style as missing
+            if(attributeValues_[i].Empty() && (atom == kAtomClass
+               || atom == kAtomId || atom == kAtomStyle))
+                continue;
+            if((any || AtomTable::Equal(atom, attributeNames_[i],
+                                        selector.atom, selector.name))
+               && Search::CheckValue(selector, attributeValues_[i]))
+                return true;
+        }
+        return false;
+    }
+    default:
+        return AtomTable::Equal(atoms_[index], names_[index],
+                                selector.atom, selector.name);
+    }
+}
+
+bool FlatDocument::MatchesStep(const Search::Complex& complex, size_t position,
+                               unsigned int index, unsigned int scope,
+                               unsigned int scopeEnd) const
+{
+    const Search::Step& step = complex[position];
+    if(!step.valid || !CheckSelector(step.selector, index)) return false;
+    //The first selector searches the scope, the next ones check elements
+    //reached by the separators
+    if(position == 0) return index >= scope && index < scopeEnd;
+    return IsReached(complex, position - 1, index, scope, scopeEnd);
+}
+
+bool FlatDocument::IsReached(const Search::Complex& complex, size_t position,
+                             unsigned int index, unsigned int scope,
+                             unsigned int scopeEnd) const
+{
+    //Elements before the scope may only be reached as siblings of its
+    //root, but nothing reached from them is ever their descendant
+    unsigned int parent = parents_[index];
+    switch(complex[position].separator)
+    {
+    case ' ':
+        for(; parent != kNoNode && parent >= scope; parent = parents_[parent])
+            if(MatchesStep(complex, position, parent, scope, scopeEnd))
+                return true;
+        return false;
+    case '>':
+        return parent != kNoNode && parent >= scope
+               && MatchesStep(complex, position, parent, scope, scopeEnd);
+    case '+':
+    {
+        //Siblings are linked forward only, so walk them from the first one
+        if(parent == kNoNode || firstChildren_[parent] == index) return false;
+        unsigned int previous = firstChildren_[parent];
+        while(nextSiblings_[previous] != index)
+            previous = nextSiblings_[previous];
+        return MatchesStep(complex, position, previous, scope, scopeEnd);
+    }
+    case '~':
+        //"a ~ b" reaches b elements preceding an a element
+        if(parent == kNoNode) return false;
+        for(unsigned int sibling = nextSiblings_[index]; sibling != kNoNode;
+            sibling = nextSiblings_[sibling])
+            if(MatchesStep(complex, position, sibling, scope, scopeEnd))
+                return true;
+        return false;
+    }
+    return MatchesStep(complex, position, index, scope, scopeEnd);
+}
+}
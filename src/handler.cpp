@@ -0,0 +1,70 @@
+#include "handler.h"
+
+namespace idogaf
+{
+
+//Getters
+size_t Handler::GetSourceBegin() const
+{
+    return sourceBegin_;
+}
+size_t Handler::GetSourceEnd() const
+{
+    return sourceEnd_;
+}
+bool Handler::HasReferences() const
+{
+    return references_;
+}
+
+//Setters
+void Handler::SetSource(size_t begin, size_t end)
+{
+    sourceBegin_ = begin;
+    sourceEnd_ = end;
+}
+void Handler::SetReferences(bool value)
+{
+    references_ = value;
+}
+
+//Other
+
+bool Handler::OnStartTag(const StringView& name, Atom atom,
+                         TagLexer& attributes)
+{
+    (void)name;
+    (void)atom;
+    (void)attributes;
+    return true;
+}
+
+bool Handler::OnEndTag(const StringView& name)
+{
+    (void)name;
+    return true;
+}
+
+bool Handler::OnText(const StringView& text)
+{
+    (void)text;
+    return true;
+}
+
+bool Handler::OnRawText(const StringView& text)
+{
+    return OnText(text);
+}
+
+bool Handler::OnComment(const StringView& text)
+{
+    (void)text;
+    return true;
+}
+
+bool Handler::OnDoctype(const StringView& doctype)
+{
+    (void)doctype;
+    return true;
+}
+}
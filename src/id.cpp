@@ -1,30 +1,48 @@
 #include "id.h"
 
+#include <utility>
+
 namespace idogaf
 {
 
 Id::Id() : Attribute()
 {
-    name_ = Id::GetStaticName();
+    atom_ = kAtomId;
 }
 
 Id::Id(const Id& other) : Attribute(other)
 {
-    name_ = Id::GetStaticName();
+    atom_ = kAtomId;
 }
 
 Id::Id(const Attribute& attribute)
 {
-    name_ = Id::GetStaticName();
-    value_ = attribute.GetValue();
+    atom_ = kAtomId;
+    //A span stays a span, so ids of arena documents aren't copied
+    if(!attribute.GetValueSpan().Empty()) valueSpan_ = attribute.GetValueSpan();
+    else value_ = attribute.GetValue();
+    references_ = attribute.HasReferences();
 }
 
 Id& Id::operator=(const Id& rhs)
 {
     if (this == &rhs) return *this; // handle self assignment
     //assignment operator
-    name_ = Id::GetStaticName();
-    value_ = rhs.value_;
+    Attribute::operator=(rhs);
+    atom_ = kAtomId;
+    return *this;
+}
+
+Id::Id(Id&& other) noexcept : Attribute(std::move(other))
+{
+    atom_ = kAtomId;
+}
+
+Id& Id::operator=(Id&& rhs) noexcept
+{
+    if (this == &rhs) return *this; // handle self assignment
+    Attribute::operator=(std::move(rhs));
+    atom_ = kAtomId;
     return *this;
 }
 
@@ -0,0 +1,62 @@
+#include "lineindex.h"
+
+#include <string.h>
+#include <algorithm>
+
+namespace idogaf
+{
+
+LineIndex::LineIndex()
+{
+    data_ = nullptr;
+    length_ = 0;
+    built_ = false;
+}
+
+LineIndex::LineIndex(const char* data, size_t length)
+{
+    data_ = data;
+    length_ = length;
+    built_ = false;
+}
+
+//Getters
+size_t LineIndex::GetLine(size_t offset) const
+{
+    Build();
+    //Line is one more than the number of '\n' before the offset
+    return std::lower_bound(newlines_.begin(), newlines_.end(), offset)
+           - newlines_.begin() + 1;
+}
+size_t LineIndex::GetColumn(size_t offset) const
+{
+    size_t line = GetLine(offset);
+    size_t lineBegin = line == 1 ? 0 : newlines_[line-2] + 1;
+    return offset - lineBegin + 1;
+}
+
+//Setters
+void LineIndex::SetInput(const char* data, size_t length)
+{
+    data_ = data;
+    length_ = length;
+    newlines_.clear();
+    built_ = false;
+}
+
+//Protected member functions
+void LineIndex::Build() const
+{
+    if(built_) return;
+    built_ = true;
+    const char* cursor = data_;
+    const char* end = data_ + length_;
+    while(cursor < end)
+    {
+        cursor = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+        if(cursor == nullptr) break;
+        newlines_.push_back(cursor - data_);
+        cursor++;
+    }
+}
+}
@@ -0,0 +1,127 @@
+#include "mappedfile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define IDOGAF_HAVE_MMAP
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace idogaf
+{
+#ifdef IDOGAF_HAVE_MMAP
+/** Read everything left in a descriptor, for files that can't be mapped */
+static bool ReadDescriptor(int fd, std::string& out)
+{
+    char chunk[65536];
+    while(true)
+    {
+        ssize_t count = read(fd, chunk, sizeof(chunk));
+        if(count == 0) return true;
+        if(count < 0)
+        {
+            if(errno == EINTR) continue;
+            return false;
+        }
+        out.append(chunk, static_cast<size_t>(count));
+    }
+}
+#endif
+
+MappedFile::MappedFile()
+{
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    mapped_ = false;
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+//Getters
+const char* MappedFile::GetData() const
+{
+    return data_;
+}
+size_t MappedFile::GetSize() const
+{
+    return size_;
+}
+bool MappedFile::IsOpen() const
+{
+    return open_;
+}
+
+//Other
+bool MappedFile::Open(const std::string& filename)
+{
+    Close();
+#ifdef IDOGAF_HAVE_MMAP
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+    struct stat info;
+    if(fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    //Pipes, devices and files of unknown size (i.e. in /proc) are read
+    if(S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        size_t size = static_cast<size_t>(info.st_size);
+        void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(address != MAP_FAILED)
+        {
+            posix_madvise(address, size, POSIX_MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(address);
+            size_ = size;
+            mapped_ = true;
+        }
+    }
+    if(!mapped_)
+    {
+        if(!ReadDescriptor(fd, buffer_))
+        {
+            close(fd);
+            buffer_.clear();
+            return false;
+        }
+        data_ = buffer_.empty() ? nullptr : buffer_.data();
+        size_ = buffer_.size();
+    }
+    //The mapping stays valid after the descriptor is closed
+    close(fd);
+#else
+    std::ifstream stream(filename, std::ios::in | std::ios::binary);
+    if(!stream.good()) return false;
+    std::stringstream sstream;
+    sstream << stream.rdbuf();
+    buffer_ = sstream.str();
+    data_ = buffer_.empty() ? nullptr : buffer_.data();
+    size_ = buffer_.size();
+#endif
+    open_ = true;
+    return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef IDOGAF_HAVE_MMAP
+    if(mapped_)
+        munmap(const_cast<char*>(data_), size_);
+#endif
+    buffer_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    mapped_ = false;
+}
+}
@@ -1,6 +1,7 @@
 #include "misc.h"
 
 #include <ctype.h>
+#include <string.h>
 
 namespace idogaf
 {
@@ -28,49 +29,101 @@ std::string trim(const std::string& str)
     }
     return str.substr(left, right-left+1);
 }
+void trim(const char*& begin, const char*& end)
+{
+    while(begin < end && isspace(static_cast<unsigned char>(*begin)))
+        begin++;
+    while(end > begin && isspace(static_cast<unsigned char>(*(end-1))))
+        end--;
+}
 size_t countLines(const std::string& str)
+{
+    return countLines(str.data(), str.data() + str.length());
+}
+size_t countLines(const char* begin, const char* end)
 {
     size_t lines = 0;
-    for(size_t i = 0; i < str.length(); i++)
-        if(str[i] == '\n') lines++;
+    while(begin < end)
+    {
+        begin = static_cast<const char*>(memchr(begin, '\n', end - begin));
+        if(begin == nullptr) break;
+        lines++;
+        begin++;
+    }
     return lines;
 }
+bool startsWith(const char* begin, const char* end, const char* prefix)
+{
+    size_t length = strlen(prefix);
+    return static_cast<size_t>(end - begin) >= length
+           && memcmp(begin, prefix, length) == 0;
+}
+bool startsWithIgnoreCase(const char* begin, const char* end,
+                          const char* prefix, size_t length)
+{
+    if(static_cast<size_t>(end - begin) < length) return false;
+    for(size_t i = 0; i < length; i++)
+        if(tolower(static_cast<unsigned char>(begin[i])) != prefix[i])
+            return false;
+    return true;
+}
+bool endsWith(const char* begin, const char* end, const char* suffix)
+{
+    size_t length = strlen(suffix);
+    return static_cast<size_t>(end - begin) >= length
+           && memcmp(end - length, suffix, length) == 0;
+}
+const char* findStr(const char* begin, const char* end, const char* str)
+{
+    size_t length = strlen(str);
+    if(length == 0) return begin;
+    while(static_cast<size_t>(end - begin) >= length)
+    {
+        begin = static_cast<const char*>(memchr(begin, str[0],
+                                                end - begin - length + 1));
+        if(begin == nullptr) return nullptr;
+        if(memcmp(begin, str, length) == 0) return begin;
+        begin++;
+    }
+    return nullptr;
+}
 bool strInVector(const std::string& str, const std::vector<std::string> &strVec)
 {
     for(auto& s : strVec)
         if(s == str) return true;
     return false;
 }
+bool isSingletonTag(Atom tag)
+{
+    return (AtomTable::GetProperties(tag) & kTagVoid) != 0;
+}
 bool omittClosingTag(const std::string& tag, const std::string& nextTag)
 {
-    if(tag == "li" || tag == "optgroup" || tag == "tr")
-        return nextTag == tag;
-    if(tag == "dt")
-        return nextTag == "dt" || nextTag == "dd";
-    if(tag == "dd")
-        return nextTag == "dt" || nextTag == "dd";
-    if(tag == "p")
-        return strInVector(nextTag, kpElementOptVec);
-    if(tag == "rb" || tag == "rt" || tag == "rtc" || tag == "rp")
-        return nextTag == "rb" || nextTag == "rt" ||
-               nextTag == "rtc" || nextTag == "rp";
-    if(tag == "option")
-        return nextTag == "option" || nextTag == "optgroup";
-    if(tag == "thead")
-        return nextTag == "tbody" || nextTag == "tfoot";
-    if(tag == "tbody")
-        return nextTag == "tbody" || nextTag == "tfoot";
-    if(tag == "tfoot")
-        return nextTag == "tbody";
-    if(tag == "td" || tag == "th")
-        return nextTag == "td" || nextTag == "th";
-
-    return false;
+    return omittClosingTag(AtomTable::Find(tag), AtomTable::Find(nextTag));
 }
 bool omittClosingTagNMC(const std::string& tag, const std::string& parent)
 {
-    if(tag == "p") return parent != "a";
-    return strInVector(tag, kOptCTagNMC);
+    return omittClosingTagNMC(AtomTable::Find(tag), AtomTable::Find(parent));
+}
+bool omittClosingTag(Atom tag, Atom nextTag)
+{
+    unsigned int closedBy = AtomTable::GetProperties(tag) >> kTagClosedByShift;
+    return (closedBy & AtomTable::GetProperties(nextTag)) != 0;
+}
+bool omittClosingTagNMC(Atom tag, Atom parent)
+{
+    if(!(AtomTable::GetProperties(tag) & kTagOptionalEnd)) return false;
+    return tag != kAtomP || parent != kAtomA;
 }
 
+const std::vector<std::string> kSingletonTags = {
+    "area", "base", "br", "col", "command", "embed", "hr", "img", "input",
+    "keygen", "link", "meta", "param", "source", "track", "wbr" };
+const std::vector<std::string> kpElementOptVec = {
+    "address", "article", "aside", "blockquote", "dic", "dl", "fieldset",
+    "footer", "form", "h1", "h2", "h3", "h4", "h5", "h6", "header", "hgroup",
+    "hr", "main", "nav", "ol", "p", "pre", "section", "table", "ul" };
+const std::vector<std::string> kOptCTagNMC = {
+    "li", "dd", "rb", "rt", "rtc", "rp", "optgroup", "option", "tbody", "tfoot",
+    "tr", "td", "th" };
 }
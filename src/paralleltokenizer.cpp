@@ -0,0 +1,228 @@
+#include "paralleltokenizer.h"
+
+#include <string.h>
+
+namespace idogaf
+{
+
+/** Number of chunks per thread allowed to be tokenized ahead */
+const size_t kChunksAheadPerThread = 4;
+
+ParallelTokenizer::ParallelTokenizer(size_t threads)
+{
+    data_ = nullptr;
+    end_ = nullptr;
+    threads_ = threads == 0 ? 1 : threads;
+    chunkSize_ = kDefaultChunkSize;
+    allowMistypedCommentTags_ = false;
+    started_ = false;
+    stop_ = false;
+    nextChunk_ = 0;
+    currentChunk_ = 0;
+    busy_ = 0;
+    position_ = nullptr;
+    resolvedIndex_ = 0;
+    tokenIndex_ = 0;
+}
+
+ParallelTokenizer::ParallelTokenizer(const char* data, size_t length,
+                                     size_t threads)
+    : ParallelTokenizer(threads)
+{
+    SetInput(data, length);
+}
+
+ParallelTokenizer::~ParallelTokenizer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    windowCondition_.notify_all();
+    for(size_t i = 0; i < workers_.size(); i++)
+        workers_[i].join();
+}
+
+//Getters
+size_t ParallelTokenizer::GetThreads() const
+{
+    return threads_;
+}
+size_t ParallelTokenizer::GetChunkSize() const
+{
+    return chunkSize_;
+}
+bool ParallelTokenizer::AllowMistypedCommentTags() const
+{
+    return allowMistypedCommentTags_;
+}
+
+//Setters
+void ParallelTokenizer::SetInput(const char* data, size_t length)
+{
+    {
+        //Let threads finish chunks they took, then forget the old input
+        std::unique_lock<std::mutex> lock(mutex_);
+        nextChunk_ = chunks_.size();
+        while(busy_ > 0)
+            readyCondition_.wait(lock);
+        chunks_.clear();
+        nextChunk_ = 0;
+        currentChunk_ = 0;
+    }
+    data_ = data;
+    end_ = data + length;
+    started_ = false;
+    position_ = data;
+    resolved_.clear();
+    resolvedIndex_ = 0;
+    tokenIndex_ = 0;
+}
+void ParallelTokenizer::SetChunkSize(size_t size)
+{
+    chunkSize_ = size == 0 ? 1 : size;
+}
+void ParallelTokenizer::AllowMistypedCommentTags(bool value)
+{
+    allowMistypedCommentTags_ = value;
+}
+
+//Other
+bool ParallelTokenizer::Next(Token& tokenOut)
+{
+    if(!started_) Start();
+    while(currentChunk_ < chunks_.size())
+    {
+        Chunk& chunk = chunks_[currentChunk_];
+        if(resolvedIndex_ < resolved_.size())
+        {
+            tokenOut = resolved_[resolvedIndex_++];
+            return true;
+        }
+        if(tokenIndex_ < chunk.tokens.size())
+        {
+            tokenOut = chunk.tokens[tokenIndex_++];
+            return true;
+        }
+        ReleaseChunk();
+        if(currentChunk_ < chunks_.size()) ResolveChunk();
+    }
+    return false;
+}
+
+//Protected member functions
+void ParallelTokenizer::Start()
+{
+    started_ = true;
+    tokenizer_.AllowMistypedCommentTags(allowMistypedCommentTags_);
+    //Every chunk starts at '<', so it's likely to start at a token boundary
+    std::vector<Chunk> chunks;
+    const char* begin = data_;
+    while(begin < end_)
+    {
+        const char* end = end_;
+        if(static_cast<size_t>(end_ - begin) > chunkSize_)
+        {
+            const char* next = begin + chunkSize_;
+            end = static_cast<const char*>(memchr(next, '<', end_ - next));
+            if(end == nullptr) end = end_;
+        }
+        chunks.push_back(Chunk());
+        chunks.back().begin = begin;
+        chunks.back().end = end;
+        begin = end;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        chunks_.swap(chunks);
+    }
+    windowCondition_.notify_all();
+    size_t workers = threads_ < chunks_.size() ? threads_ : chunks_.size();
+    for(size_t i = workers_.size(); i < workers; i++)
+        workers_.push_back(std::thread(&ParallelTokenizer::Work, this));
+    if(!chunks_.empty()) ResolveChunk();
+}
+
+void ParallelTokenizer::Work()
+{
+    while(true)
+    {
+        size_t index;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            //Threads wait for the next input once the current one is taken
+            while(!stop_ && (nextChunk_ >= chunks_.size()
+                  || nextChunk_ >= currentChunk_ + threads_ * kChunksAheadPerThread))
+                windowCondition_.wait(lock);
+            if(stop_) return;
+            index = nextChunk_++;
+            busy_++;
+        }
+        TokenizeChunk(chunks_[index]);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            chunks_[index].ready = true;
+            busy_--;
+        }
+        readyCondition_.notify_all();
+    }
+}
+
+void ParallelTokenizer::TokenizeChunk(Chunk& chunk) const
+{
+    Tokenizer tokenizer(chunk.begin, end_ - chunk.begin);
+    tokenizer.SetOffset(chunk.begin - data_);
+    tokenizer.AllowMistypedCommentTags(allowMistypedCommentTags_);
+    tokenizer.SetLimit(chunk.end);
+    Token token;
+    while(tokenizer.Next(token))
+        chunk.tokens.push_back(token);
+    chunk.position = tokenizer.GetPosition();
+}
+
+void ParallelTokenizer::ResolveChunk()
+{
+    Chunk& chunk = chunks_[currentChunk_];
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while(!chunk.ready)
+            readyCondition_.wait(lock);
+    }
+    resolved_.clear();
+    resolvedIndex_ = 0;
+    tokenIndex_ = chunk.tokens.size();
+    //Tokenize from the real position until the end of a token matches
+    //the end of a speculative one, from there on they are the same
+    tokenizer_.SetInput(position_, end_ - position_);
+    tokenizer_.SetOffset(position_ - data_);
+    tokenizer_.SetLimit(chunk.end);
+    size_t index = 0;
+    Token token;
+    while(tokenizer_.Next(token))
+    {
+        resolved_.push_back(token);
+        const char* position = tokenizer_.GetPosition();
+        while(index < chunk.tokens.size()
+              && chunk.tokens[index].source.end() < position)
+            index++;
+        if(index < chunk.tokens.size()
+           && chunk.tokens[index].source.end() == position)
+        {
+            tokenIndex_ = index + 1;
+            position_ = chunk.position;
+            return;
+        }
+    }
+    position_ = tokenizer_.GetPosition();
+}
+
+void ParallelTokenizer::ReleaseChunk()
+{
+    std::vector<Token>().swap(chunks_[currentChunk_].tokens);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        currentChunk_++;
+    }
+    windowCondition_.notify_all();
+}
+}
@@ -0,0 +1,20 @@
+#include "parselimits.h"
+
+namespace idogaf
+{
+
+const char* getLimitName(Limit limit)
+{
+    switch(limit)
+    {
+    case Limit::kNone:              return "none";
+    case Limit::kDepth:             return "nesting depth";
+    case Limit::kNodes:             return "number of elements";
+    case Limit::kAttributes:        return "number of attributes";
+    case Limit::kAttributeLength:   return "attribute value length";
+    case Limit::kTextLength:        return "text length";
+    case Limit::kInputLength:       return "input length";
+    }
+    return "";
+}
+}
@@ -3,27 +3,62 @@
 #include <ctype.h>
 #include <fstream>
 #include <iostream>
-#include <sstream>
-#include <stack>
+#include <utility>
 
+#include "dombuilder.h"
 #include "misc.h"
+#include "paralleltokenizer.h"
+#include "tokenizer.h"
+#include "treebuilder.h"
 
 namespace idogaf
 {
 
+/** Number of bytes read from a stream at once */
+const size_t kStreamChunkSize = 64 * 1024;
+
+static void WriteView(std::ostream& stream, const StringView& view)
+{
+    stream.write(view.GetData(), view.GetLength());
+}
+
 Parser::Parser()
+    : domBuilder_(document_), treeBuilder_(domBuilder_)
 {
     silent_ = false;
     skipUnnecessaryClosingTags_ = false;
     allowMistypedCommentTags_ = false;
+    threads_ = 1;
+    chunkSize_ = ParallelTokenizer::kDefaultChunkSize;
+    rawTextMode_ = RawTextMode::kCopy;
+    reuse_ = false;
+    useArena_ = false;
+    stopped_ = false;
+    stopOffset_ = 0;
+    exceededLimit_ = Limit::kNone;
+    encodingHint_ = Encoding::kUnknown;
+    transcode_ = true;
+    encoding_ = Encoding::kUnknown;
 }
 
 Parser::Parser(const Parser& other)
+    : domBuilder_(document_), treeBuilder_(other.treeBuilder_)
 {
     silent_ = other.silent_;
     document_ = other.document_;
     skipUnnecessaryClosingTags_ = other.skipUnnecessaryClosingTags_;
     allowMistypedCommentTags_ = other.allowMistypedCommentTags_;
+    threads_ = other.threads_;
+    chunkSize_ = other.chunkSize_;
+    rawTextMode_ = other.rawTextMode_;
+    reuse_ = other.reuse_;
+    useArena_ = other.useArena_;
+    stopped_ = other.stopped_;
+    stopOffset_ = other.stopOffset_;
+    exceededLimit_ = other.exceededLimit_;
+    encodingHint_ = other.encodingHint_;
+    transcode_ = other.transcode_;
+    encoding_ = other.encoding_;
 }
 
 Parser& Parser::operator=(const Parser& rhs)
@@ -34,6 +69,18 @@ Parser& Parser::operator=(const Parser& rhs)
     document_ = rhs.document_;
     skipUnnecessaryClosingTags_ = rhs.skipUnnecessaryClosingTags_;
     allowMistypedCommentTags_ = rhs.allowMistypedCommentTags_;
+    threads_ = rhs.threads_;
+    chunkSize_ = rhs.chunkSize_;
+    rawTextMode_ = rhs.rawTextMode_;
+    reuse_ = rhs.reuse_;
+    useArena_ = rhs.useArena_;
+    treeBuilder_ = rhs.treeBuilder_;
+    stopped_ = rhs.stopped_;
+    stopOffset_ = rhs.stopOffset_;
+    exceededLimit_ = rhs.exceededLimit_;
+    encodingHint_ = rhs.encodingHint_;
+    transcode_ = rhs.transcode_;
+    encoding_ = rhs.encoding_;
     return *this;
 }
 
@@ -46,6 +93,16 @@ Document* Parser::GetDocumentPtr()
 {
     return &document_;
 }
+void Parser::TakeDocument(Document& documentOut)
+{
+    document_.Swap(documentOut);
+}
+Document Parser::TakeDocument()
+{
+    Document document;
+    document.Swap(document_);
+    return document;
+}
 bool Parser::Silent() const
 {
     return silent_;
@@ -58,6 +115,62 @@ bool Parser::AllowMistypedCommentTags() const
 {
     return allowMistypedCommentTags_;
 }
+size_t Parser::Threads() const
+{
+    return threads_;
+}
+size_t Parser::ChunkSize() const
+{
+    return chunkSize_;
+}
+RawTextMode Parser::RawText() const
+{
+    return rawTextMode_;
+}
+bool Parser::Reuse() const
+{
+    return reuse_;
+}
+bool Parser::UseArena() const
+{
+    return useArena_;
+}
+const std::vector<SelectorRule>& Parser::GetPruneRules() const
+{
+    return treeBuilder_.GetPruneRules();
+}
+bool Parser::Stopped() const
+{
+    return stopped_;
+}
+size_t Parser::GetStopOffset() const
+{
+    return stopOffset_;
+}
+const ParseLimits& Parser::Limits() const
+{
+    return treeBuilder_.Limits();
+}
+Limit Parser::GetExceededLimit() const
+{
+    return exceededLimit_;
+}
+const LineIndex& Parser::GetLineIndex() const
+{
+    return lines_;
+}
+Encoding Parser::EncodingHint() const
+{
+    return encodingHint_;
+}
+bool Parser::Transcode() const
+{
+    return transcode_;
+}
+Encoding Parser::GetEncoding() const
+{
+    return encoding_;
+}
 
 //Setters
 void Parser::Silent(bool silent)
@@ -72,90 +185,177 @@ void Parser::AllowMistypedCommentTags(bool value)
 {
     allowMistypedCommentTags_ = value;
 }
+void Parser::Threads(size_t threads)
+{
+    threads_ = threads == 0 ? 1 : threads;
+}
+void Parser::ChunkSize(size_t size)
+{
+    chunkSize_ = size == 0 ? 1 : size;
+}
+void Parser::RawText(RawTextMode mode)
+{
+    rawTextMode_ = mode;
+}
+void Parser::Reuse(bool value)
+{
+    reuse_ = value;
+}
+void Parser::UseArena(bool value)
+{
+    useArena_ = value;
+}
+bool Parser::AddPruneRule(const std::string& selector)
+{
+    SelectorRule rule(selector);
+    if(!rule.Valid()) return false;
+    treeBuilder_.AddPruneRule(rule);
+    return true;
+}
+void Parser::ClearPruneRules()
+{
+    treeBuilder_.ClearPruneRules();
+}
+bool Parser::StopAfter(const std::string& selector, size_t count)
+{
+    return treeBuilder_.AddStopCondition(SelectorRule(selector), count);
+}
+void Parser::ClearStopConditions()
+{
+    treeBuilder_.ClearStopConditions();
+}
+void Parser::Limits(const ParseLimits& limits)
+{
+    treeBuilder_.Limits(limits);
+}
+void Parser::EncodingHint(Encoding encoding)
+{
+    encodingHint_ = encoding;
+}
+void Parser::Transcode(bool value)
+{
+    transcode_ = value;
+}
 
 //Other
 bool Parser::Parse(const std::string& filename)
 {
-    std::ifstream stream;
-    stream.open(filename, std::ios::in | std::ios::binary);
-    if(!stream.good())
-    {
-        if(!silent_)
-            std::cerr << "Error opening file " << filename << std::endl;
-        return false;
-    }
-    bool ret = Parse(stream);
-    stream.close();
-    return ret;
+    if(!OpenFile(filename)) return false;
+    return Parse(file_.GetData(), file_.GetSize());
 }
 
 bool Parser::Parse(std::istream& stream)
 {
-    size_t lineCounter = 1;
-    size_t linesOut = 0;
-    bool closingTag, emptyTag;
-    std::string textBeforeTag;
-    std::stack<Element*> eStack;
-    Element root;
-    Element* A;
-    Element B;
-    root = ReadNextTag(stream, emptyTag, closingTag, textBeforeTag, linesOut);
-    lineCounter += linesOut;
-    if(root.Empty()) return !stream.fail();
-    else if(emptyTag || closingTag)
-    {
-        return UnexpectedTagError(root.GetName(), lineCounter);
-    }
-    document_.SetRoot(root);
-    A = document_.GetRootPtr();
-    while(true)
+    if(!ReadStream(stream)) return false;
+    return Parse(source_.data(), source_.size());
+}
+
+bool Parser::ParseString(std::string&& data)
+{
+    source_ = std::move(data);
+    return Parse(source_.data(), source_.size());
+}
+
+bool Parser::Parse(const char* data, size_t length)
+{
+    domBuilder_.SetRawTextMode(rawTextMode_);
+    domBuilder_.SetReuse(reuse_);
+    domBuilder_.SetUseArena(useArena_);
+    domBuilder_.Reset();
+    if(reuse_) document_.SetDoctype(std::string());
+    bool success = ParseEvents(data, length, domBuilder_);
+    domBuilder_.Finish();
+    return success;
+}
+
+bool Parser::Parse(const std::string& filename, FlatDocument& document)
+{
+    if(!OpenFile(filename)) return false;
+    return Parse(file_.GetData(), file_.GetSize(), document);
+}
+
+bool Parser::Parse(const char* data, size_t length, FlatDocument& document)
+{
+    FlatBuilder builder(document);
+    builder.SetRawTextMode(rawTextMode_);
+    builder.Reset();
+    return ParseEvents(data, length, builder);
+}
+
+bool Parser::ParseEvents(const std::string& filename, Handler& handler)
+{
+    if(!OpenFile(filename)) return false;
+    return ParseEvents(file_.GetData(), file_.GetSize(), handler);
+}
+
+bool Parser::ParseEvents(std::istream& stream, Handler& handler)
+{
+    if(!ReadStream(stream)) return false;
+    return ParseEvents(source_.data(), source_.size(), handler);
+}
+
+bool Parser::ParseEvents(const char* data, size_t length, Handler& handler)
+{
+    stopped_ = false;
+    stopOffset_ = 0;
+    exceededLimit_ = Limit::kNone;
+    encoding_ = Encoding::kUnknown;
+    const ParseLimits& limits = treeBuilder_.Limits();
+    if(limits.maxInputLength != 0 && length > limits.maxInputLength)
     {
-        B = ReadNextTag(stream, emptyTag, closingTag, textBeforeTag, linesOut);
-        lineCounter += linesOut;
-        if(!textBeforeTag.empty()) A->AddText(textBeforeTag);
-        if(B.Empty()) return !stream.fail();
-        else if(emptyTag)
-            A->AddChild(B);
-        else if(closingTag)
+        exceededLimit_ = Limit::kInputLength;
+        if(!limits.truncate)
         {
-            if(A->GetName() == B.GetName())
-            {
-                if(eStack.empty()) return true;
-                A = eStack.top();
-                eStack.pop();
-            }
-            else
-            {
-                if(!eStack.empty())
-                {
-                    if(omittClosingTagNMC(A->GetName(), eStack.top()->GetName())
-                        && trim(textBeforeTag).empty()
-                        && eStack.top()->GetName() == B.GetName())
-                    {
-                        eStack.pop();
-                        if(eStack.empty()) return true;
-                        A = eStack.top();
-                        eStack.pop();
-                        continue;
-                    }
-                }
-                if(skipUnnecessaryClosingTags_) continue;
-                return UnexpectedTagError(B.GetName(), lineCounter);
-            }
-        }
-        else if(omittClosingTag(A->GetName(), B.GetName())
-                && trim(textBeforeTag).empty())
-        {
-            eStack.top()->AddChild(B);
-            A = eStack.top()->GetLastChildPtr();
-        }
-        else
-        {
-            A->AddChild(B);
-            eStack.push(A);
-            A = A->GetLastChildPtr();
+            lines_.SetInput(data, length);
+            return LimitError(exceededLimit_, 0);
         }
+        //Don't cut a multibyte character in half
+        Encoding encoding = transcode_
+                            ? Charset::Detect(data, length, encodingHint_)
+                            : Encoding::kUtf8;
+        length = Charset::FindCharacterBoundary(data, limits.maxInputLength,
+                                                encoding);
     }
+    if(transcode_) Decode(data, length);
+    lines_.SetInput(data, length);
+    TreeBuilder& builder = treeBuilder_;
+    builder.Reset(handler);
+    builder.SkipUnnecessaryClosingTags(skipUnnecessaryClosingTags_);
+    Token token;
+    if(threads_ > 1 && length > chunkSize_)
+    {
+        if(!parallelTokenizer_ || parallelTokenizer_->GetThreads() != threads_)
+            parallelTokenizer_.reset(new ParallelTokenizer(threads_));
+        ParallelTokenizer& tokenizer = *parallelTokenizer_;
+        tokenizer.SetInput(data, length);
+        tokenizer.SetChunkSize(chunkSize_);
+        tokenizer.AllowMistypedCommentTags(allowMistypedCommentTags_);
+        while(tokenizer.Next(token))
+            if(!builder.Process(token)) break;
+        //Don't keep views of the input
+        tokenizer.SetInput(nullptr, 0);
+    }
+    else
+    {
+        Tokenizer tokenizer(data, length);
+        tokenizer.AllowMistypedCommentTags(allowMistypedCommentTags_);
+        while(tokenizer.Next(token))
+            if(!builder.Process(token)) break;
+    }
+    stopped_ = builder.Stopped();
+    stopOffset_ = builder.GetStopOffset();
+    if(builder.GetExceededLimit() != Limit::kNone)
+    {
+        exceededLimit_ = builder.GetExceededLimit();
+        if(builder.Failed())
+            return LimitError(exceededLimit_,
+                              lines_.GetLine(builder.GetOffset()));
+    }
+    if(builder.Failed())
+        return UnexpectedTagError(builder.GetErrorTag(),
+                                  lines_.GetLine(builder.GetOffset()));
+    builder.Finish();
+    return true;
 }
 
 bool Parser::WriteToFile(const std::string& filename)
@@ -170,19 +370,15 @@ bool Parser::WriteToFile(const std::string& filename)
 bool Parser::WriteToStream(std::ostream& stream)
 {
     if(document_.Empty()) return DocumentEmptyError();
-    //Create copy of the root so, we can use pointers during writing
-    //without caring if someone modifies it during our work,
-    //posibly invalidating our pointers.
-    Element root = document_.GetRoot();
-    Element* current = &root;
+    //Walk the document in place, writing reads the tree only
+    Element* root = document_.GetRootPtr();
+    Element* current = root;
 
     //Print doctype if exists
     if(!document_.GetDoctype().empty())
         stream << "<!DOCTYPE " << document_.GetDoctype() << ">\n";
-    if(root.Empty()) return true;
+    if(root->Empty()) return true;
 
-    std::stack<unsigned int> uiStack;
-    unsigned int curSiblingPos = 0;
     unsigned int indent = 0;
     bool running = true;
     while(running)
@@ -191,31 +387,28 @@ bool Parser::WriteToStream(std::ostream& stream)
 
         if(current->GetChildrenCount() > 0)
         {
-            uiStack.push(curSiblingPos);
             current = current->GetFirstChildPtr();
-            curSiblingPos = 0;
             indent++;
         }
         else
         {
             while(true)
             {
+                //The root is closed by the tag writing it or when climbing
+                //back to it
                 if(current->GetParent() == nullptr)
                 {
-                    WriteClosingTag(current, stream, indent);
                     running = false;
                     break;
                 }
-                else if(current->GetParent()->GetChildrenCount() > ++curSiblingPos)
+                else if(current->HasRightBrother())
                 {
-                    current = current->GetParent()->GetChildPtrAt(curSiblingPos);
+                    current = current->GetRightBrotherPtr();
                     break;
                 }
                 else
                 {
                     current = current->GetParent();
-                    curSiblingPos = uiStack.top();
-                    uiStack.pop();
                     indent--;
                     WriteClosingTag(current, stream, indent);
                 }
@@ -226,179 +419,56 @@ bool Parser::WriteToStream(std::ostream& stream)
 }
 
 //Protected member functions
-Element Parser::ReadNextTag(std::istream& stream, bool& emptyOut,
-                            bool& closeOut, std::string& textOut,
-                            size_t& linesOut)
-{
-    emptyOut = false;
-    closeOut = false;
-    textOut = std::string();
-    linesOut = 0;
-    std::string activeBuffer;
-    Element ret = Element();
-    std::stringbuf buffer;
-
-    while(stream.good())
+void Parser::Decode(const char*& data, size_t& length)
+{
+    size_t bomLength;
+    encoding_ = Charset::DetectBom(data, length, bomLength);
+    if(encoding_ == Encoding::kUnknown)
+        encoding_ = Charset::Detect(data, length, encodingHint_);
+    const char* end = data + length;
+    if(encoding_ != Encoding::kUtf16Le && encoding_ != Encoding::kUtf16Be)
     {
-        activeBuffer = "";
-        buffer.str("");
-        while(stream.peek() != '<')
-        {
-            stream.get(buffer, '<');
-        }
-        linesOut += countLines(buffer.str());
-        textOut += trim(buffer.str());
-        //Here in next char in stream is '<' (next tag ready to extract).
-        //Iin textOut we have any text (nicely trimmed) between
-        //the stream cursor at the moment this func was called
-        //and the next tag
-
-        buffer.str("");
-        while(stream.peek() != '>')
-        {
-            stream.get(buffer, '>');
-        }
-        linesOut += countLines(buffer.str());
-        buffer.sputc(stream.get());   //extract '>' into buffer
-        activeBuffer = buffer.str();
-
-        if(activeBuffer.substr(0,4) == "<!--"           //Comment tag
-           || (activeBuffer.substr(0,5) == "<! --"
-               && allowMistypedCommentTags_))           //Mistyped comment tag
-        {
-            //Ignore comments for now
-            //Just add new line to the text
-            textOut += '\n';
-            if(activeBuffer.substr(activeBuffer.length()-3,3) != "-->")
-            {
-                buffer.str("");
-                while(stream.good())
-                {
-                    stream.get(buffer, '>');
-                    buffer.sputc(stream.get());
-                    activeBuffer = buffer.str();
-                    if(activeBuffer.substr(activeBuffer.length()-3,3) == "-->")
-                        break;
-                }
-                linesOut += countLines(buffer.str());
-            }
-        }
-        else if(activeBuffer.substr(0,9) == "<!DOCTYPE")
+        //ASCII reads the same in every other supported encoding
+        const char* nonAscii = Charset::FindNonAscii(data + bomLength, end);
+        if(nonAscii == end
+           || ((encoding_ == Encoding::kUnknown || encoding_ == Encoding::kUtf8)
+               && Charset::FindInvalidUtf8(nonAscii, end) == end))
         {
-            //Extract anything between '<!DOCTYPE' and '>'
-            activeBuffer = activeBuffer.substr(9, activeBuffer.length()-9-1);
-            document_.SetDoctype(trim(activeBuffer));   //Set Doctype
-            textOut += '\n';
-        }
-        else if(activeBuffer.substr(0,7) == "<script")
-        {
-            //Extract anything between '<' and '>'
-            activeBuffer = activeBuffer.substr(1, activeBuffer.length()-1-1);
-            if(activeBuffer[activeBuffer.length()-1] == '/') //empty script tag
-            {
-                emptyOut = true;
-                activeBuffer = activeBuffer.substr(0,activeBuffer.length()-1);
-                return ParseTagForElement(activeBuffer);
-            }
-            //Since script tag can't have children, we extract text
-            //and return element as empty but with text included
-            ret = ParseTagForElement(activeBuffer);
-            activeBuffer = "";
-            buffer.str("");
-            while(stream.good())
-            {
-                if(stream.peek() != '<')
-                    stream.get(buffer, '<');
-                if(stream.peek() == '\n')
-                {
-                    linesOut++;
-                    buffer.sputc('\n');
-                    stream.get();
-                    continue;
-                }
-                std::string buf = " ";
-                for(int i = 1; i < 15 && buf[i-1] != '>' && stream.good(); i++)
-                    buf += static_cast<char>(stream.get());
-                if(trim(buf.substr(3,buf.length()-3-1)) == "script") break;
-                else buffer.sputn(buf.c_str(),buf.length());
-            }
-            linesOut += countLines(buffer.str());
-            ret.AddText(trim(buffer.str()));
-            emptyOut = true;
-            return ret;
-        }
-        else if(activeBuffer.substr(0,2) == "</")   //Closing tag
-        {
-            closeOut = true;
-            //Extract anything between '</' and '>'
-            activeBuffer = activeBuffer.substr(2, activeBuffer.length()-2-1);
-            ret.SetName(trim(activeBuffer));
-            return ret;
-        }
-        else if(activeBuffer.substr(activeBuffer.length()-2,2) == "/>") //empty tag
-        {
-            emptyOut = true;
-            //Extract anything between '<' and '/>'
-            activeBuffer = activeBuffer.substr(1, activeBuffer.length()-2-1);
-            //Parse active buffer for name and attributes
-            return ParseTagForElement(activeBuffer);
-        }
-        else    //Opening tag
-        {
-            //Extract anything between '<' and '>'
-            activeBuffer = activeBuffer.substr(1, activeBuffer.length()-1-1);
-            //Parse active buffer for name and attributes
-            ret = ParseTagForElement(activeBuffer);
-            if(strInVector(ret.GetName(), kSingletonTags))
-                emptyOut = true;
-            break;
+            if(encoding_ == Encoding::kUnknown) encoding_ = Encoding::kUtf8;
+            data += bomLength;
+            length -= bomLength;
+            return;
         }
+        if(encoding_ == Encoding::kUnknown) encoding_ = Encoding::kWindows1252;
     }
-    return ret;
+    Charset::ToUtf8(data, length, encoding_, transcoded_);
+    data = transcoded_.data();
+    length = transcoded_.size();
 }
 
-Element Parser::ParseTagForElement(const std::string& tag)
+bool Parser::OpenFile(const std::string& filename)
 {
-    std::stringstream sstream(tag);
-    std::string buffer;
-    try
-    {
-        sstream >> buffer;
-    }
-    catch(const std::ios_base::failure& e)
+    if(!file_.Open(filename))
     {
         if(!silent_)
-        {
-            std::cerr   << "ios_base::failure exception caught while parsing a tag.\n"
-                        << "Error code: " << e.code() << '\n';
-        }
-        return Element();
-    }
-    Element ret = Element(buffer);  //construct with name
-    while(sstream.good())
-    {
-        sstream >> buffer;
-        while(sstream.good() && buffer[buffer.length()-1] != '"')
-        {
-            //handle artibutes with spaces in value
-            std::string buffer2;
-            sstream >> buffer2;
-            buffer += ' ';
-            buffer += buffer2;
-        }
-        ret.AddAtrribute(ParseStringForAttribute(buffer));
+            std::cerr << "Error opening file " << filename << std::endl;
+        return false;
     }
-    return ret;
+    return true;
 }
 
-Attribute Parser::ParseStringForAttribute(const std::string& str)
+bool Parser::ReadStream(std::istream& stream)
 {
-    size_t eqPos = str.find('=');
-    if(eqPos == std::string::npos) return Attribute(str);
-    //Assuming format name="value"
-    std::string name = str.substr(0, eqPos);
-    std::string value = str.substr(eqPos+2,str.length()-eqPos-2-1);
-    return Attribute(name, value);
+    //Read whole stream into our own buffer, so it can be parsed from memory
+    source_.clear();
+    while(stream.good())
+    {
+        size_t size = source_.size();
+        source_.resize(size + kStreamChunkSize);
+        stream.read(&source_[size], kStreamChunkSize);
+        source_.resize(size + stream.gcount());
+    }
+    return !stream.bad();
 }
 
 void Parser::WriteOpeningTag(Element* element, std::ostream& stream,
@@ -406,29 +476,41 @@ void Parser::WriteOpeningTag(Element* element, std::ostream& stream,
 {
     if(element == nullptr) return;
 
-    stream << GetIndentation(indent) << '<' << element->GetName();
-
-    Vector_A attributes = element->GetAttributes();
+    stream << GetIndentation(indent) << '<';
+    WriteView(stream, element->GetNameView());
 
-    for(Vector_A_it it = attributes.begin(); it != attributes.end(); ++it)
-        stream << ' ' << it->GetName() << "=\"" << it->GetValue() << "\"";
-    if(element->GetChildrenCount() == 0 && element->GetText().empty()
-            && element->GetName() != "meta" && element->GetName() != "link"
-            && element->GetName() != "script")
+    for(AttributeIterator it = element->AttributesBegin();
+        it != element->AttributesEnd(); ++it)
+    {
+        stream << ' ';
+        WriteView(stream, it->GetNameView());
+        stream << "=\"";
+        WriteView(stream, it->GetValueView());
+        stream << '"';
+    }
+    StringView text = element->GetTextView();
+    if(element->GetChildrenCount() == 0 && text.Empty()
+            && element->GetAtom() != kAtomMeta && element->GetAtom() != kAtomLink
+            && element->GetAtom() != kAtomScript)
         stream << "/>\n";
-    else if(element->GetChildrenCount() == 0 && !element->GetText().empty())
+    else if(element->GetChildrenCount() == 0 && !text.Empty())
     {
-        stream << ">\n" << GetIndentation(indent+1);
-        std::string text = element->GetText();
-        for(size_t i = 0; i < text.length(); i++)
+        std::string indentation = GetIndentation(indent+1);
+        stream << ">\n" << indentation;
+        //Every line of the text is indented
+        const char* line = text.begin();
+        for(const char* it = text.begin(); it != text.end(); ++it)
         {
-            stream << text[i];
-            if(text[i] == '\n') stream << GetIndentation(indent+1);
+            if(*it != '\n') continue;
+            stream.write(line, it + 1 - line);
+            stream << indentation;
+            line = it + 1;
         }
+        stream.write(line, text.end() - line);
         stream << '\n';
         WriteClosingTag(element, stream, indent);
     }
-    else if(element->GetName() == "script")
+    else if(element->GetAtom() == kAtomScript)
     {
         stream << '>';
         WriteClosingTag(element, stream, 0);
@@ -442,9 +524,10 @@ void Parser::WriteClosingTag(Element* element, std::ostream& stream,
 {
     if(element == nullptr) return;
 
-    stream << GetIndentation(indent) << "</" << element->GetName() << ">\n";
+    stream << GetIndentation(indent) << "</";
+    WriteView(stream, element->GetNameView());
+    stream << ">\n";
 }
-
 std::string Parser::GetIndentation(unsigned int level) const
 {
     if(level == 0) return "";
@@ -465,6 +548,17 @@ bool Parser::UnexpectedTagError(const std::string& tagName, size_t line) const
     return false;
 }
 
+bool Parser::LimitError(Limit limit, size_t line) const
+{
+    if(!silent_)
+    {
+        std::cerr << "Error: Limit of " << getLimitName(limit) << " exceeded";
+        if(line != 0) std::cerr << " at line " << line;
+        std::cerr << std::endl;
+    }
+    return false;
+}
+
 bool Parser::DocumentEmptyError() const
 {
     if(!silent_)
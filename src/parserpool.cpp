@@ -0,0 +1,275 @@
+#include "parserpool.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "dombuilder.h"
+
+namespace idogaf
+{
+
+double BatchStats::GetMegabytesPerSecond() const
+{
+    if(seconds <= 0.0) return 0.0;
+    return bytes / (1024.0 * 1024.0) / seconds;
+}
+
+double BatchStats::GetDocumentsPerSecond() const
+{
+    if(seconds <= 0.0) return 0.0;
+    return documents / seconds;
+}
+
+ParserPool::ParserPool(size_t threads)
+{
+    silent_ = false;
+    skipUnnecessaryClosingTags_ = false;
+    allowMistypedCommentTags_ = false;
+    useArena_ = false;
+    if(threads == 0) threads = std::thread::hardware_concurrency();
+    if(threads == 0) threads = 1;
+    for(size_t i = 0; i < threads; i++)
+        workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+}
+
+//Getters
+size_t ParserPool::GetThreads() const
+{
+    return workers_.size();
+}
+BatchStats ParserPool::GetStats() const
+{
+    return stats_;
+}
+bool ParserPool::Silent() const
+{
+    return silent_;
+}
+bool ParserPool::SkipUnnecessaryClosingTags() const
+{
+    return skipUnnecessaryClosingTags_;
+}
+bool ParserPool::AllowMistypedCommentTags() const
+{
+    return allowMistypedCommentTags_;
+}
+const std::vector<SelectorRule>& ParserPool::GetPruneRules() const
+{
+    return pruneRules_;
+}
+const ParseLimits& ParserPool::Limits() const
+{
+    return limits_;
+}
+bool ParserPool::UseArena() const
+{
+    return useArena_;
+}
+
+//Setters
+void ParserPool::Silent(bool silent)
+{
+    silent_ = silent;
+}
+void ParserPool::SkipUnnecessaryClosingTags(bool value)
+{
+    skipUnnecessaryClosingTags_ = value;
+}
+void ParserPool::AllowMistypedCommentTags(bool value)
+{
+    allowMistypedCommentTags_ = value;
+}
+bool ParserPool::AddPruneRule(const std::string& selector)
+{
+    SelectorRule rule(selector);
+    if(!rule.Valid()) return false;
+    pruneRules_.push_back(rule);
+    return true;
+}
+void ParserPool::ClearPruneRules()
+{
+    pruneRules_.clear();
+}
+void ParserPool::Limits(const ParseLimits& limits)
+{
+    limits_ = limits;
+}
+void ParserPool::UseArena(bool value)
+{
+    useArena_ = value;
+}
+
+//Other
+std::vector<Document> ParserPool::ParseFiles(const std::vector<std::string>& filenames)
+{
+    std::vector<Document> results(filenames.size());
+    Run(filenames.size(), [&](Worker& worker, size_t i, Document& document)
+        { return ParseFile(worker, filenames[i], document); },
+        &results, Callback());
+    return results;
+}
+
+void ParserPool::ParseFiles(const std::vector<std::string>& filenames,
+                            const Callback& callback)
+{
+    Run(filenames.size(), [&](Worker& worker, size_t i, Document& document)
+        { return ParseFile(worker, filenames[i], document); },
+        nullptr, callback);
+}
+
+std::vector<Document> ParserPool::ParseBuffers(const std::vector<StringView>& buffers)
+{
+    std::vector<Document> results(buffers.size());
+    Run(buffers.size(), [&](Worker& worker, size_t i, Document& document)
+        { return ParseBuffer(worker, buffers[i], document); },
+        &results, Callback());
+    return results;
+}
+
+void ParserPool::ParseBuffers(const std::vector<StringView>& buffers,
+                              const Callback& callback)
+{
+    Run(buffers.size(), [&](Worker& worker, size_t i, Document& document)
+        { return ParseBuffer(worker, buffers[i], document); },
+        nullptr, callback);
+}
+
+//Protected member functions
+bool ParserPool::ParseFile(Worker& worker, const std::string& filename,
+                           Document& document)
+{
+    if(!worker.file.Open(filename))
+    {
+        if(!silent_)
+            std::cerr << "Error opening file " << filename << std::endl;
+        document = Document();
+        return false;
+    }
+    return ParseBuffer(worker, StringView(worker.file.GetData(),
+                                          worker.file.GetSize()), document);
+}
+
+bool ParserPool::ParseBuffer(Worker& worker, const StringView& buffer,
+                             Document& document)
+{
+    worker.stats.bytes += buffer.GetLength();
+    DomBuilder builder(document);
+    builder.SetReuse(true);
+    builder.SetUseArena(useArena_);
+    builder.Reset();
+    document.SetDoctype(std::string());
+    bool success = worker.parser.ParseEvents(buffer.GetData(),
+                                             buffer.GetLength(), builder);
+    builder.Finish();
+    return success;
+}
+
+void ParserPool::Run(size_t count, const Task& task,
+                     std::vector<Document>* results, const Callback& callback)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    //Every worker starts with a contiguous part of the batch
+    size_t threads = workers_.size();
+    for(size_t i = 0; i < threads; i++)
+    {
+        Worker& worker = *workers_[i];
+        worker.parser.Silent(silent_);
+        worker.parser.SkipUnnecessaryClosingTags(skipUnnecessaryClosingTags_);
+        worker.parser.AllowMistypedCommentTags(allowMistypedCommentTags_);
+        worker.parser.ClearPruneRules();
+        for(size_t j = 0; j < pruneRules_.size(); j++)
+            worker.parser.AddPruneRule(pruneRules_[j].GetSelector());
+        worker.parser.Limits(limits_);
+        worker.begin = count * i / threads;
+        worker.end = count * (i + 1) / threads;
+        worker.stats = BatchStats();
+    }
+    std::vector<std::thread> threadVec;
+    for(size_t i = 1; i < threads && i < count; i++)
+        threadVec.push_back(std::thread(&ParserPool::Work, this, i,
+                                        std::cref(task), results,
+                                        std::cref(callback)));
+    Work(0, task, results, callback);
+    for(size_t i = 0; i < threadVec.size(); i++)
+        threadVec[i].join();
+
+    stats_ = BatchStats();
+    for(size_t i = 0; i < threads; i++)
+    {
+        Worker& worker = *workers_[i];
+        worker.file.Close();
+        stats_.documents += worker.stats.documents;
+        stats_.failed += worker.stats.failed;
+        stats_.bytes += worker.stats.bytes;
+        stats_.steals += worker.stats.steals;
+    }
+    stats_.seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+}
+
+void ParserPool::Work(size_t index, const Task& task,
+                      std::vector<Document>* results, const Callback& callback)
+{
+    Worker& worker = *workers_[index];
+    size_t document;
+    while(TakeWork(index, document))
+    {
+        bool success;
+        if(results != nullptr)
+            success = task(worker, document, (*results)[document]);
+        else
+        {
+            success = task(worker, document, worker.document);
+            if(callback) callback(document, worker.document, success);
+        }
+        worker.stats.documents++;
+        if(!success) worker.stats.failed++;
+    }
+}
+
+bool ParserPool::TakeWork(size_t index, size_t& documentOut)
+{
+    Worker& worker = *workers_[index];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if(worker.begin < worker.end)
+        {
+            documentOut = worker.begin++;
+            return true;
+        }
+    }
+    //Steal from the worker with most documents left
+    while(true)
+    {
+        size_t victim = workers_.size();
+        size_t most = 0;
+        for(size_t i = 0; i < workers_.size(); i++)
+        {
+            if(i == index) continue;
+            std::lock_guard<std::mutex> lock(workers_[i]->mutex);
+            if(workers_[i]->end - workers_[i]->begin > most)
+            {
+                most = workers_[i]->end - workers_[i]->begin;
+                victim = i;
+            }
+        }
+        if(victim == workers_.size()) return false;
+        Worker& other = *workers_[victim];
+        size_t begin, end;
+        {
+            std::lock_guard<std::mutex> lock(other.mutex);
+            if(other.begin >= other.end) continue;  //Taken in the meantime
+            begin = other.begin + (other.end - other.begin) / 2;
+            end = other.end;
+            other.end = begin;
+        }
+        worker.stats.steals++;
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        documentOut = begin;
+        worker.begin = begin + 1;
+        worker.end = end;
+        return true;
+    }
+}
+}
@@ -0,0 +1,322 @@
+#include "pushparser.h"
+
+#include <iostream>
+
+namespace idogaf
+{
+
+PushParser::PushParser()
+    : domBuilder_(document_), treeBuilder_(domBuilder_)
+{
+    silent_ = false;
+    errorReported_ = false;
+    reuse_ = false;
+    handler_ = &domBuilder_;
+    retrySize_ = 0;
+    offset_ = 0;
+    received_ = 0;
+    inputExceeded_ = false;
+    encodingHint_ = Encoding::kUnknown;
+    transcode_ = true;
+    encoding_ = Encoding::kUnknown;
+}
+
+PushParser::PushParser(Handler& handler)
+    : domBuilder_(document_), treeBuilder_(handler)
+{
+    silent_ = false;
+    errorReported_ = false;
+    reuse_ = false;
+    handler_ = &handler;
+    retrySize_ = 0;
+    offset_ = 0;
+    received_ = 0;
+    inputExceeded_ = false;
+    encodingHint_ = Encoding::kUnknown;
+    transcode_ = true;
+    encoding_ = Encoding::kUnknown;
+}
+
+//Getters
+Document PushParser::GetDocument() const
+{
+    return document_;
+}
+Document* PushParser::GetDocumentPtr()
+{
+    return &document_;
+}
+void PushParser::TakeDocument(Document& documentOut)
+{
+    document_.Swap(documentOut);
+}
+Document PushParser::TakeDocument()
+{
+    Document document;
+    document.Swap(document_);
+    return document;
+}
+bool PushParser::Finished() const
+{
+    return treeBuilder_.Finished();
+}
+size_t PushParser::GetBufferedSize() const
+{
+    return buffer_.size() + sniffed_.size() + carry_.size();
+}
+bool PushParser::Silent() const
+{
+    return silent_;
+}
+bool PushParser::SkipUnnecessaryClosingTags() const
+{
+    return treeBuilder_.SkipUnnecessaryClosingTags();
+}
+bool PushParser::AllowMistypedCommentTags() const
+{
+    return tokenizer_.AllowMistypedCommentTags();
+}
+bool PushParser::Reuse() const
+{
+    return reuse_;
+}
+bool PushParser::UseArena() const
+{
+    return domBuilder_.GetUseArena();
+}
+const std::vector<SelectorRule>& PushParser::GetPruneRules() const
+{
+    return treeBuilder_.GetPruneRules();
+}
+const ParseLimits& PushParser::Limits() const
+{
+    return treeBuilder_.Limits();
+}
+Limit PushParser::GetExceededLimit() const
+{
+    if(inputExceeded_) return Limit::kInputLength;
+    return treeBuilder_.GetExceededLimit();
+}
+Encoding PushParser::EncodingHint() const
+{
+    return encodingHint_;
+}
+bool PushParser::Transcode() const
+{
+    return transcode_;
+}
+Encoding PushParser::GetEncoding() const
+{
+    return encoding_;
+}
+
+//Setters
+void PushParser::Silent(bool silent)
+{
+    silent_ = silent;
+}
+void PushParser::SkipUnnecessaryClosingTags(bool value)
+{
+    treeBuilder_.SkipUnnecessaryClosingTags(value);
+}
+void PushParser::AllowMistypedCommentTags(bool value)
+{
+    tokenizer_.AllowMistypedCommentTags(value);
+}
+void PushParser::Reuse(bool value)
+{
+    reuse_ = value;
+}
+void PushParser::UseArena(bool value)
+{
+    domBuilder_.SetUseArena(value);
+}
+bool PushParser::AddPruneRule(const std::string& selector)
+{
+    SelectorRule rule(selector);
+    if(!rule.Valid()) return false;
+    treeBuilder_.AddPruneRule(rule);
+    return true;
+}
+void PushParser::ClearPruneRules()
+{
+    treeBuilder_.ClearPruneRules();
+}
+void PushParser::Limits(const ParseLimits& limits)
+{
+    treeBuilder_.Limits(limits);
+}
+void PushParser::EncodingHint(Encoding encoding)
+{
+    encodingHint_ = encoding;
+}
+void PushParser::Transcode(bool value)
+{
+    transcode_ = value;
+}
+
+//Other
+void PushParser::Reset()
+{
+    errorReported_ = false;
+    buffer_.clear();
+    retrySize_ = 0;
+    offset_ = 0;
+    received_ = 0;
+    inputExceeded_ = false;
+    encoding_ = Encoding::kUnknown;
+    sniffed_.clear();
+    carry_.clear();
+    domBuilder_.SetReuse(reuse_);
+    if(reuse_) document_.SetDoctype(std::string());
+    else document_ = Document();
+    domBuilder_.Reset();
+    treeBuilder_.Reset(*handler_);
+}
+
+bool PushParser::Feed(const char* data, size_t length)
+{
+    if(treeBuilder_.Finished() || inputExceeded_) return CheckError();
+    const ParseLimits& limits = treeBuilder_.Limits();
+    if(limits.maxInputLength != 0
+       && length > limits.maxInputLength - received_)
+    {
+        inputExceeded_ = true;
+        if(!limits.truncate) return CheckError();
+        length = limits.maxInputLength - received_;
+    }
+    received_ += length;
+    if(!transcode_ || encoding_ == Encoding::kUtf8)
+        return Process(data, length);
+    if(encoding_ != Encoding::kUnknown)
+        return TranscodePart(data, length, true);
+    //Wait for enough data to find a <meta> declaration
+    sniffed_.append(data, length);
+    if(sniffed_.size() < Charset::kPrescanLength) return true;
+    return DetectEncoding();
+}
+
+bool PushParser::Finish()
+{
+    bool success = CheckError();
+    if(success && transcode_)
+    {
+        //Short documents are still waiting for their encoding
+        if(encoding_ == Encoding::kUnknown) success = DetectEncoding();
+        //Truncated input ends before an incomplete character
+        if(inputExceeded_) carry_.clear();
+        if(success && !carry_.empty()) success = TranscodePart(nullptr, 0, false);
+    }
+    if(success)
+    {
+        Run(buffer_.data(), buffer_.size(), false);
+        success = CheckError();
+    }
+    buffer_.clear();
+    sniffed_.clear();
+    carry_.clear();
+    retrySize_ = 0;
+    if(success) treeBuilder_.Finish();
+    domBuilder_.Finish();
+    return success;
+}
+
+//Protected member functions
+bool PushParser::Process(const char* data, size_t length)
+{
+    if(buffer_.empty())
+    {
+        //Parse straight from the given data, keep only the incomplete rest
+        const char* rest = Run(data, length, true);
+        buffer_.assign(rest, data + length);
+    }
+    else
+    {
+        buffer_.append(data, length);
+        //An incomplete token is retried only after the buffer doubles,
+        //so long tokens arriving in small parts are not rescanned
+        //over and over
+        if(buffer_.size() < retrySize_) return true;
+        const char* rest = Run(buffer_.data(), buffer_.size(), true);
+        buffer_.erase(0, rest - buffer_.data());
+    }
+    retrySize_ = 2 * buffer_.size();
+    if(treeBuilder_.Finished()) buffer_.clear();
+    return CheckError();
+}
+
+bool PushParser::DetectEncoding()
+{
+    const char* data = sniffed_.data();
+    size_t bomLength;
+    encoding_ = Charset::DetectBom(data, sniffed_.size(), bomLength);
+    if(encoding_ == Encoding::kUnknown)
+        encoding_ = Charset::Detect(data, sniffed_.size(), encodingHint_);
+    if(encoding_ == Encoding::kUnknown)
+    {
+        //Only the beginning is known, a character may be cut at its end
+        size_t length = Charset::FindCharacterBoundary(data, sniffed_.size(),
+                                                       Encoding::kUtf8);
+        encoding_ = Charset::FindInvalidUtf8(data, data + length) == data + length
+                    ? Encoding::kUtf8 : Encoding::kWindows1252;
+    }
+    bool success;
+    if(encoding_ == Encoding::kUtf8)
+        success = Process(data + bomLength, sniffed_.size() - bomLength);
+    else
+        success = TranscodePart(data + bomLength, sniffed_.size() - bomLength,
+                                true);
+    sniffed_.clear();
+    return success;
+}
+
+bool PushParser::TranscodePart(const char* data, size_t length, bool partial)
+{
+    if(!carry_.empty())
+    {
+        if(length > 0) carry_.append(data, length);
+        data = carry_.data();
+        length = carry_.size();
+    }
+    size_t complete = partial ? Charset::FindCharacterBoundary(data, length,
+                                                               encoding_)
+                              : length;
+    Charset::ToUtf8(data, complete, encoding_, transcoded_, false);
+    if(data == carry_.data()) carry_.erase(0, complete);
+    else carry_.assign(data + complete, length - complete);
+    return Process(transcoded_.data(), transcoded_.size());
+}
+
+const char* PushParser::Run(const char* data, size_t length, bool partial)
+{
+    tokenizer_.SetInput(data, length, partial);
+    tokenizer_.SetOffset(offset_);
+    Token token;
+    while(!treeBuilder_.Finished() && tokenizer_.Next(token))
+        treeBuilder_.Process(token);
+    offset_ = tokenizer_.GetOffset();
+    return tokenizer_.GetPosition();
+}
+
+bool PushParser::CheckError()
+{
+    bool inputFailed = inputExceeded_ && !treeBuilder_.Limits().truncate;
+    if(!treeBuilder_.Failed() && !inputFailed) return true;
+    if(!silent_ && !errorReported_ && GetExceededLimit() != Limit::kNone)
+    {
+        size_t offset = inputFailed ? treeBuilder_.Limits().maxInputLength
+                                    : treeBuilder_.GetOffset();
+        std::cerr << "Error: Limit of " << getLimitName(GetExceededLimit());
+        std::cerr << " exceeded at byte " << offset << std::endl;
+    }
+    else if(!silent_ && !errorReported_)
+    {
+        std::cerr << "Error: Unexpected tag " << treeBuilder_.GetErrorTag();
+        //Parsed data is gone, so only the offset can be reported
+        std::cerr << " at byte " << treeBuilder_.GetOffset() << std::endl;
+        std::cerr << "Document is probably ill formed.\n";
+    }
+    errorReported_ = true;
+    return false;
+}
+}
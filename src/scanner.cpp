@@ -0,0 +1,140 @@
+#include "scanner.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define IDOGAF_SCANNER_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define IDOGAF_SCANNER_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+namespace idogaf
+{
+
+typedef const char* (*ScanFunction)(const char* chars, size_t count,
+                                    const bool* table,
+                                    const char* begin, const char* end);
+
+static const char* ScanScalar(const char* chars, size_t count,
+                              const bool* table,
+                              const char* begin, const char* end)
+{
+    (void)chars;
+    (void)count;
+    for(; begin < end; ++begin)
+        if(table[static_cast<unsigned char>(*begin)]) return begin;
+    return end;
+}
+
+#ifdef IDOGAF_SCANNER_SSE2
+static inline int CountTrailingZeros(unsigned int mask)
+{
+#ifdef __GNUC__
+    return __builtin_ctz(mask);
+#else
+    int i = 0;
+    while(!(mask & 1u))
+    {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+static const char* ScanSSE2(const char* chars, size_t count,
+                            const bool* table,
+                            const char* begin, const char* end)
+{
+    __m128i needles[Scanner::kMaxChars];
+    for(size_t i = 0; i < count; i++)
+        needles[i] = _mm_set1_epi8(chars[i]);
+    while(end - begin >= 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        __m128i match = _mm_cmpeq_epi8(block, needles[0]);
+        for(size_t i = 1; i < count; i++)
+            match = _mm_or_si128(match, _mm_cmpeq_epi8(block, needles[i]));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(match));
+        if(mask != 0) return begin + CountTrailingZeros(mask);
+        begin += 16;
+    }
+    return ScanScalar(chars, count, table, begin, end);
+}
+#endif
+
+#ifdef IDOGAF_SCANNER_AVX2
+__attribute__((target("avx2")))
+static const char* ScanAVX2(const char* chars, size_t count,
+                            const bool* table,
+                            const char* begin, const char* end)
+{
+    __m256i needles[Scanner::kMaxChars];
+    for(size_t i = 0; i < count; i++)
+        needles[i] = _mm256_set1_epi8(chars[i]);
+    while(end - begin >= 32)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        __m256i match = _mm256_cmpeq_epi8(block, needles[0]);
+        for(size_t i = 1; i < count; i++)
+            match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, needles[i]));
+        unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(match));
+        if(mask != 0) return begin + CountTrailingZeros(mask);
+        begin += 32;
+    }
+    return ScanSSE2(chars, count, table, begin, end);
+}
+#endif
+
+/** Pick the best scan function for this CPU */
+static ScanFunction SelectScanFunction()
+{
+#ifdef IDOGAF_SCANNER_AVX2
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return ScanAVX2;
+#endif
+#ifdef IDOGAF_SCANNER_SSE2
+    return ScanSSE2;
+#else
+    return ScanScalar;
+#endif
+}
+
+static ScanFunction GetScanFunction()
+{
+    static const ScanFunction function = SelectScanFunction();
+    return function;
+}
+
+Scanner::Scanner(const char* chars)
+{
+    count_ = 0;
+    for(size_t i = 0; i < 256; i++)
+        table_[i] = false;
+    for(; count_ < kMaxChars && chars[count_] != '\0'; count_++)
+    {
+        chars_[count_] = chars[count_];
+        table_[static_cast<unsigned char>(chars[count_])] = true;
+    }
+}
+
+//Other
+const char* Scanner::Find(const char* begin, const char* end) const
+{
+    if(count_ == 0) return end;
+    return GetScanFunction()(chars_, count_, table_, begin, end);
+}
+
+const char* Scanner::GetInstructionSet()
+{
+    ScanFunction function = GetScanFunction();
+#ifdef IDOGAF_SCANNER_AVX2
+    if(function == ScanAVX2) return "avx2";
+#endif
+#ifdef IDOGAF_SCANNER_SSE2
+    if(function == ScanSSE2) return "sse2";
+#endif
+    return "scalar";
+}
+}
@@ -1,6 +1,6 @@
 #include "search.h"
 
-#include <sstream>
+#include <ctype.h>
 
 #include "attribute.h"
 #include "class.h"
@@ -9,96 +9,91 @@
 namespace idogaf
 {
 
-Vector_E Search::Find(Element root, const std::string& query)
+/** Check if a whitespace separated list contains a word */
+static bool containsWord(const StringView& list, const std::string& word)
 {
-    Vector_E result;
-    Set_P resultSet;
-    Set_P qResult;
-    std::string _query = trim(query);
-    //Count number of ',' in query
-    size_t cnt = 1, pos = 0;
-    while((pos = _query.find(',', pos)) != std::string::npos)
+    const char* cursor = list.begin();
+    const char* end = list.end();
+    while(cursor < end)
     {
-        cnt++;
-        pos++;
+        while(cursor < end && isspace(static_cast<unsigned char>(*cursor)))
+            cursor++;
+        const char* wordBegin = cursor;
+        while(cursor < end && !isspace(static_cast<unsigned char>(*cursor)))
+            cursor++;
+        if(cursor > wordBegin && StringView(wordBegin, cursor) == word)
+            return true;
     }
-    for(size_t i = 0, pos1 = 0; i < cnt; i++)
+    return false;
+}
+
+Vector_E Search::Find(const Element& root, const std::string& query)
+{
+    //The tree is only read, pointers are needed just to walk it
+    Vector_P found = FindPtr(const_cast<Element*>(&root), query);
+    Vector_E result;
+    result.reserve(found.size());
+    for(Vector_P_it it = found.begin(); it != found.end(); ++it)
+        result.push_back(**it);
+    return result;
+}
+
+Vector_P Search::FindPtr(Element* root, const std::string& query)
+{
+    Set_P result;
+    Set_P qResult;
+    std::vector<Complex> complexes;
+    ParseQuery(query, complexes);
+    for(size_t i = 0; i < complexes.size(); i++)
     {
-        size_t pos2 = _query.find(',', pos1);
-        std::string cmplx = trim(_query.substr(pos1, pos2-pos1));
-        //in cmplx we have one of the complex queries
-        //now process it
-        bool first = true;
+        const Complex& complex = complexes[i];
         qResult.clear();
-        qResult.insert(&root);
-        while(!cmplx.empty())
+        qResult.insert(root);
+        for(size_t j = 0; j < complex.size() && !qResult.empty(); j++)
         {
-            switch(cmplx[0])
-            {
-            case '.':
-            case '#':
-            {
-                if(cmplx.length() <= 1) break;
-                pos = FindSeparator(cmplx.substr(1));
-                if(pos != std::string::npos) pos++;
-                break;
-            }
-            case '[':
-            {
-                pos = cmplx.find(']');
-                if(pos != std::string::npos) pos++;
-                break;
-            }
-            default:
-                pos = FindSeparator(cmplx);
-            }
-            if(first)
-            {
-                qResult = RunQuery(qResult, trim(cmplx.substr(0, pos)));
-                first = false;
-            }
-            else
-                qResult = CheckElements(qResult, trim(cmplx.substr(0, pos)));
-            if(cmplx[pos] == ' ' || cmplx[pos] == '>' ||
-                    cmplx[pos] == '+' || cmplx[pos] == '~')
-            {
-                qResult = ProcessSeparator(qResult, cmplx[pos]);
-                pos++;
-            }
-            if(pos == std::string::npos)
-                cmplx.clear();
+            if(!complex[j].valid)
+                qResult.clear();
+            else if(j == 0)
+                qResult = RunQuery(qResult, complex[j].selector);
             else
-                cmplx = trim(cmplx.substr(pos));
+                qResult = CheckElements(qResult, complex[j].selector);
+            if(complex[j].separator != 0)
+                qResult = ProcessSeparator(qResult, complex[j].separator);
         }
-        resultSet.insert(qResult.begin(), qResult.end());
-        pos1 = pos2 + 1;
+        result.insert(qResult.begin(),qResult.end());
     }
-    for(Set_P_it it = resultSet.begin(); it != resultSet.end(); ++it)
-        result.push_back(**it);
-    return result;
+    //Sibling combinators applied to the root lead out of the tree
+    Vector_P found;
+    for(Set_P_it it = result.begin(); it != result.end(); ++it)
+        if(IsInTree(*it, root)) found.push_back(*it);
+    return found;
 }
 
-Vector_P Search::FindPtr(Element* root, const std::string& query)
+Vector_E Search::FindInVector(const Vector_E& vec, const std::string& query)
 {
-    Set_P result;
-    Set_P qResult;
-    std::string _query = trim(query);
-    //Count number of ',' in query
-    size_t cnt = 0, pos = 0;
-    while((pos = _query.find(',', pos)) != std::string::npos)
+    Vector_E result, partial;
+    for(Vector_E::const_iterator it = vec.begin(); it != vec.end(); ++it)
     {
-        cnt++;
-        pos++;
+        partial = Find(*it, query);
+        result.insert(result.end(), partial.begin(), partial.end());
     }
-    for(size_t i = 0, pos1 = 0; i < cnt; i++)
+    return result;
+}
+
+//Private member functions
+void Search::ParseQuery(const std::string& query,
+                        std::vector<Complex>& complexesOut)
+{
+    complexesOut.clear();
+    std::string _query = trim(query);
+    size_t pos1 = 0, pos2, pos = std::string::npos;
+    do
     {
-        size_t pos2 = _query.find(',', pos1);
+        pos2 = _query.find(',', pos1);
         std::string cmplx = trim(_query.substr(pos1, pos2-pos1));
         //in cmplx we have one of the complex queries
-        //now process it
-        bool first = true;
-        qResult.clear();
-        qResult.insert(root);
+        //now split it
+        complexesOut.push_back(Complex());
         while(!cmplx.empty())
         {
             switch(cmplx[0])
@@ -106,6 +101,7 @@ Vector_P Search::FindPtr(Element* root, const std::string& query)
             case '.':
             case '#':
             {
+                pos = std::string::npos;
                 if(cmplx.length() <= 1) break;
                 pos = FindSeparator(cmplx.substr(1, std::string::npos));
                 if(pos != std::string::npos) pos++;
@@ -120,139 +116,155 @@ Vector_P Search::FindPtr(Element* root, const std::string& query)
             default:
                 pos = FindSeparator(cmplx);
             }
-            if(first)
+            Step step;
+            step.valid = ParseSelector(trim(cmplx.substr(0, pos)), step.selector);
+            step.separator = 0;
+            if(pos != std::string::npos &&
+                    (cmplx[pos] == ' ' || cmplx[pos] == '>' ||
+                     cmplx[pos] == '+' || cmplx[pos] == '~'))
             {
-                qResult = RunQuery(qResult, trim(cmplx.substr(0, pos)));
-                first = false;
-            }
-            else
-                qResult = CheckElements(qResult, trim(cmplx.substr(0, pos)));
-            if(cmplx[pos] == ' ' || cmplx[pos] == '>' ||
-                    cmplx[pos] == '+' || cmplx[pos] == '~')
-            {
-                qResult = ProcessSeparator(qResult, cmplx[pos]);
+                step.separator = cmplx[pos];
                 pos++;
             }
-            cmplx = trim(cmplx.substr(pos, std::string::npos));
+            complexesOut.back().push_back(step);
+            if(pos == std::string::npos)
+                cmplx.clear();
+            else
+                cmplx = trim(cmplx.substr(pos));
         }
-        result.insert(qResult.begin(),qResult.end());
         pos1 = pos2 + 1;
     }
-    return Vector_P(result.begin(), result.end());
-}
-
-Vector_E Search::FindInVector(Vector_E vec, const std::string& query)
-{
-    Vector_E result, partial;
-    for(Vector_E_it it = vec.begin(); it != vec.end(); ++it)
-    {
-        partial = Find(*it, query);
-        result.insert(result.end(), partial.begin(), partial.end());
-    }
-    return result;
+    while(pos2 != std::string::npos);
 }
 
-//Private member functions
-Set_P Search::RunQuery(Set_P elements, const std::string& query)
+Set_P Search::RunQuery(Set_P elements, const Selector& selector)
 {
     Set_P result;
     for(Set_P_it it = elements.begin(); it != elements.end(); ++it)
     {
         Element* a = *it;
-        bool running = true;
-        while(running)
+        while(true)
         {
-            if(CheckElement(a, query))
+            if(CheckElement(a, selector))
                 result.insert(a);
             if(a->GetChildrenCount() > 0)
                 a = a->GetFirstChildPtr();
-            else if(a->GetParent() == nullptr) break;
             else
             {
-                while(true)
-                {
-                    if(a->GetParent() == nullptr)
-                    {
-                        running = false;
-                        break;
-                    }
-                    else if(a->HasRightBrother())
-                    {
-                        a = a->GetRightBrotherPtr();
-                        break;
-                    }
-                    else a = a->GetParent();
-                }
+                //Climb to the closest ancestor with a right brother,
+                //without leaving the subtree
+                while(a != *it && !a->HasRightBrother())
+                    a = a->GetParent();
+                if(a == *it) break;
+                a = a->GetRightBrotherPtr();
             }
         }
     }
     return result;
 }
 
-bool Search::CheckElement(Element* element, const std::string& query)
+bool Search::ParseSelector(const std::string& query, Selector& selectorOut)
 {
-    std::string _query = query;
-    if(_query.empty()) return false;
-    if(element == nullptr) return false;
+    selectorOut.type = 0;
+    selectorOut.op = 0;
+    selectorOut.name.clear();
+    selectorOut.value.clear();
+    if(query.empty()) return false;
 
-    switch(_query.front())
+    switch(query.front())
     {
     case '.':
-        return _ofClass(element, _query.substr(1));
     case '#':
-        return _hasId(element, _query.substr(1));
+        selectorOut.type = query.front();
+        selectorOut.name = query.substr(1);
+        return true;
     case '[':
     {
-        if(_query.back() != ']') return false;
-        _query = _query.substr(1, _query.length()-2);
+        if(query.back() != ']') return false;
+        selectorOut.type = '[';
+        std::string _query = query.substr(1, query.length()-2);
         size_t pos = _query.find('=');
         if(pos == std::string::npos)
-            return _hasAttribute(element, trim(_query));
+            selectorOut.name = trim(_query);
         else
         {
             if(pos == 0 || pos == _query.length()-1) return false;
-            switch(_query[pos-1])
-            {
-            case '~':
-                return _hasWord(element, trim(_query.substr(0,pos-1)),
-                                trim(_query.substr(pos+1)));
-            case '|':
-                return _startingWith(element, trim(_query.substr(0,pos-1)),
-                                     trim(_query.substr(pos+1)));
-            case '^':
-                return _beginingWith(element, trim(_query.substr(0,pos-1)),
-                                     trim(_query.substr(pos+1)));
-            case '$':
-                return _endingWith(element, trim(_query.substr(0,pos-1)),
-                                   trim(_query.substr(pos+1)));
-            case '*':
+            selectorOut.op = _query[pos-1];
+            selectorOut.name = trim(_query.substr(0,pos-1));
+            if(selectorOut.op != '~' && selectorOut.op != '|'
+               && selectorOut.op != '^' && selectorOut.op != '$'
+               && (selectorOut.op != '*' || selectorOut.name.empty()))
             {
-                if(!trim(_query.substr(0,pos-1)).empty())
-                    return _hasSubstr(element, trim(_query.substr(0,pos-1)),
-                                      trim(_query.substr(pos+1)));
-            }
-            default:
-                return _hasValue(element, trim(_query.substr(0,pos)),
-                                 trim(_query.substr(pos+1)));
+                selectorOut.op = '=';
+                selectorOut.name = trim(_query.substr(0,pos));
             }
+            selectorOut.value = trim(_query.substr(pos+1));
+            if(selectorOut.value.empty()) return false;
+            //Any value only requires the attribute to be present
+            if(selectorOut.value == "*") selectorOut.op = 0;
+            else if(selectorOut.value.front() == '"'
+                    && selectorOut.value.back() == '"'
+                    && selectorOut.value.length() > 1)
+                selectorOut.value = selectorOut.value.substr(
+                                        1, selectorOut.value.length()-2);
+        }
+        selectorOut.atom = AtomTable::Find(selectorOut.name);
+        return true;
+    }
+    default:
+        selectorOut.name = query;
+        selectorOut.atom = AtomTable::Find(query);
+        return true;
+    }
+}
+
+bool Search::CheckElement(Element* element, const Selector& selector)
+{
+    if(element == nullptr) return false;
+
+    switch(selector.type)
+    {
+    case '.':
+        return _ofClass(element->GetClass().GetValueView(), selector.name);
+    case '#':
+        return _hasId(element->GetId().GetValueView(), selector.name);
+    case '[':
+    {
+        if(selector.name != "*")
+        {
+            const Attribute* attribute =
+                element->GetAttributePtrByName(selector.atom, selector.name);
+            return attribute != nullptr
+                   && CheckValue(selector, attribute->GetValueView());
         }
+        for(AttributeIterator it = element->AttributesBegin();
+            it != element->AttributesEnd(); ++it)
+            if(CheckValue(selector, it->GetValueView())) return true;
+        return false;
     }
     default:
-        return element->GetName() == _query;
+        return element->HasName(selector.atom, selector.name);
     }
 }
 
-Set_P Search::CheckElements(Set_P elements, const std::string& query)
+Set_P Search::CheckElements(Set_P elements, const Selector& selector)
 {
     Set_P result;
     for(Set_P_it it = elements.begin(); it != elements.end(); ++it)
     {
-        if(CheckElement(*it, query))
+        if(CheckElement(*it, selector))
             result.insert(*it);
     }
     return result;
 }
 
+bool Search::IsInTree(Element* element, Element* root)
+{
+    for(; element != nullptr; element = element->GetParent())
+        if(element == root) return true;
+    return false;
+}
+
 Set_P Search::ProcessSeparator(Set_P elements, char separator)
 {
     switch(separator)
@@ -298,12 +310,11 @@ Set_P Search::_inside(Set_P elements)
                 e = e->GetFirstChildPtr();
             else
             {
-                while(!e->HasRightBrother())
-                {
-                    if(e->GetParent() == nullptr || e->GetParent() == *it) break;
+                //Climb to the closest ancestor with a right brother,
+                //without leaving the subtree
+                while(e != *it && !e->HasRightBrother())
                     e = e->GetParent();
-                }
-                if(e->GetParent() == nullptr || e->GetParent() == *it) break;
+                if(e == *it) break;
                 e = e->GetRightBrotherPtr();
             }
         }
@@ -349,173 +360,40 @@ Set_P Search::_preceded(Set_P elements)
 }
 
 //Single selectors
-bool Search::_ofClass(Element* e, const std::string& name)
+bool Search::_ofClass(const StringView& classes, const std::string& name)
 {
-    if(name == "*") return !e->GetClass().GetValue().empty();
-    return e->GetClass().Matches(name);
+    if(name == "*") return !classes.Empty();
+    return containsWord(classes, name);
 }
-bool Search::_hasId(Element* e, const std::string& name)
+bool Search::_hasId(const StringView& id, const std::string& name)
 {
-    if(name == "*") return !e->GetId().GetValue().empty();
-    return e->GetId().GetValue() == name;
+    if(name == "*") return !id.Empty();
+    return id == name;
 }
-bool Search::_hasAttribute(Element* e, const std::string& name)
+bool Search::CheckValue(const Selector& selector, const StringView& value)
 {
-    if(name == "*") return !e->GetAttributes().empty();
-    return !e->GetAttributeByName(name).GetName().empty();
-}
-bool Search::_hasValue(Element* e, const std::string& name,
-                       const std::string& value)
-{
-    std::string _value = value;
-    if(_value.empty()) return false;
-    if(name == "*" && value == "*") !e->GetAttributes().empty();
-    if(_value == "*") return !e->GetAttributeByName(name).GetName().empty();
-    if(_value.front() == '"' && _value.back() == '"' && _value.length() > 1)
-        _value = value.substr(1,value.length()-2);
-    if(name == "*")
+    const std::string& phrase = selector.value;
+    switch(selector.op)
     {
-        Vector_A attributes = e->GetAttributes();
-        for(Vector_A::iterator it = attributes.begin(); it != attributes.end(); ++it)
-        {
-            if(it->GetValue() == _value) return true;
-        }
-        return false;
-    }
-    return e->GetAttributeByName(name).GetValue() == _value;
-}
-bool Search::_hasWord(Element* e, const std::string& name,
-                      const std::string& word)
-{
-    std::string _word = word;
-    if(_word.empty()) return false;
-    if(name == "*" && word == "*") !e->GetAttributes().empty();
-    if(_word == "*") return !e->GetAttributeByName(name).GetName().empty();
-    if(_word.front() == '"' && _word.back() == '"' && _word.length() > 1)
-        _word = _word.substr(1,_word.length()-2);
-    Vector_A attributes;
-    if(name == "*")
-        attributes = e->GetAttributes();
-    else
-    {
-        Attribute a = e->GetAttributeByName(name);
-        if(a.GetName().empty()) return false;
-        attributes.push_back(a);
-    }
-    std::string buffer;
-    for(Vector_A_it it = attributes.begin(); it != attributes.end(); ++it)
-    {
-        std::stringstream ss(it->GetValue());
-        while(ss.good())
-        {
-            ss >> buffer;
-            if(buffer == _word) return true;
-        }
-    }
-    return false;
-}
-bool Search::_startingWith(Element* e, const std::string& name,
-                           const std::string& phrase)
-{
-    std::string _phrase = phrase;
-    if(_phrase.empty()) return false;
-    if(name == "*" && _phrase == "*") !e->GetAttributes().empty();
-    if(_phrase == "*") return !e->GetAttributeByName(name).GetName().empty();
-    if(_phrase.front() == '"' && _phrase.back() == '"' && _phrase.length() > 1)
-        _phrase = _phrase.substr(1,_phrase.length()-2);
-    Vector_A attributes;
-    if(name == "*")
-        attributes = e->GetAttributes();
-    else
-    {
-        Attribute a = e->GetAttributeByName(name);
-        if(a.GetName().empty()) return false;
-        attributes.push_back(a);
-    }
-    for(Vector_A_it it = attributes.begin(); it != attributes.end(); ++it)
-    {
-        std::string value = it->GetValue();
-        if(value.length() < _phrase.length()) continue;
-        if(value == _phrase) return true;
-        if(value.substr(0,_phrase.length()+1) == _phrase+' ' ||
-                value.substr(0,_phrase.length()+1) == _phrase+'-') return true;
-    }
-    return false;
-}
-bool Search::_beginingWith(Element* e, const std::string& name,
-                           const std::string& phrase)
-{
-    std::string _phrase = phrase;
-    if(_phrase.empty()) return false;
-    if(name == "*" && _phrase == "*") !e->GetAttributes().empty();
-    if(_phrase == "*") return !e->GetAttributeByName(name).GetName().empty();
-    if(_phrase.front() == '"' && _phrase.back() == '"' && _phrase.length() > 1)
-        _phrase = _phrase.substr(1,_phrase.length()-2);
-    Vector_A attributes;
-    if(name == "*")
-        attributes = e->GetAttributes();
-    else
-    {
-        Attribute a = e->GetAttributeByName(name);
-        if(a.GetName().empty()) return false;
-        attributes.push_back(a);
-    }
-    for(Vector_A_it it = attributes.begin(); it != attributes.end(); ++it)
-    {
-        std::string value = it->GetValue();
-        if(value.length() < _phrase.length()) continue;
-        if(value.substr(0,_phrase.length()) == _phrase) return true;
-    }
-    return false;
-}
-bool Search::_endingWith(Element* e, const std::string& name,
-                         const std::string& phrase)
-{
-    std::string _phrase = phrase;
-    if(_phrase.empty()) return false;
-    if(name == "*" && _phrase == "*") !e->GetAttributes().empty();
-    if(_phrase == "*") return !e->GetAttributeByName(name).GetName().empty();
-    if(_phrase.front() == '"' && _phrase.back() == '"' && _phrase.length() > 1)
-        _phrase = _phrase.substr(1,_phrase.length()-2);
-    Vector_A attributes;
-    if(name == "*")
-        attributes = e->GetAttributes();
-    else
-    {
-        Attribute a = e->GetAttributeByName(name);
-        if(a.GetName().empty()) return false;
-        attributes.push_back(a);
-    }
-    for(Vector_A_it it = attributes.begin(); it != attributes.end(); ++it)
-    {
-        std::string value = it->GetValue();
-        if(value.length() < _phrase.length()) continue;
-        if(value.substr(value.length()-_phrase.length(),
-                        std::string::npos) == _phrase) return true;
-    }
-    return false;
-}
-bool Search::_hasSubstr(Element* e, const std::string& name,
-                        const std::string& substring)
-{
-    std::string _substring = substring;
-    if(_substring.empty()) return false;
-    if(name == "*" && _substring == "*") !e->GetAttributes().empty();
-    if(_substring == "*") return !e->GetAttributeByName(name).GetName().empty();
-    if(_substring.front() == '"' && _substring.back() == '"'
-       && _substring.length() > 1)
-        _substring = _substring.substr(1,_substring.length()-2);
-    Vector_A attributes;
-    if(name == "*")
-        attributes = e->GetAttributes();
-    else
-    {
-        Attribute a = e->GetAttributeByName(name);
-        if(a.GetName().empty()) return false;
-        attributes.push_back(a);
+    case '=':
+        return value == phrase;
+    case '~':
+        return containsWord(value, phrase);
+    case '|':
+        return value == phrase
+               || (value.GetLength() > phrase.length()
+                   && startsWith(value.begin(), value.end(), phrase.c_str())
+                   && (value[phrase.length()] == ' '
+                       || value[phrase.length()] == '-'));
+    case '^':
+        return startsWith(value.begin(), value.end(), phrase.c_str());
+    case '$':
+        return endsWith(value.begin(), value.end(), phrase.c_str());
+    case '*':
+        return phrase.empty()
+               || findStr(value.begin(), value.end(), phrase.c_str()) != nullptr;
     }
-    for(Vector_A_it it = attributes.begin(); it != attributes.end(); ++it)
-        if(it->GetValue().find(_substring) != std::string::npos) return true;
-    return false;
+    //Presence of the attribute is enough
+    return true;
 }
 }
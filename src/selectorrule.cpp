@@ -0,0 +1,202 @@
+#include "selectorrule.h"
+
+#include <ctype.h>
+
+#include "misc.h"
+#include "taglexer.h"
+
+namespace idogaf
+{
+
+/** Check if a character can be a part of a name in a selector */
+static bool isNameChar(char c)
+{
+    return isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_';
+}
+
+/** Check if a space separated list contains a word */
+static bool containsWord(const StringView& list, const std::string& word)
+{
+    const char* cursor = list.begin();
+    while(cursor < list.end())
+    {
+        while(cursor < list.end() && isspace(static_cast<unsigned char>(*cursor)))
+            cursor++;
+        const char* wordBegin = cursor;
+        while(cursor < list.end() && !isspace(static_cast<unsigned char>(*cursor)))
+            cursor++;
+        if(StringView(wordBegin, cursor) == word) return true;
+    }
+    return false;
+}
+
+SelectorRule::SelectorRule()
+{
+    valid_ = false;
+    atom_ = kNoAtom;
+}
+
+SelectorRule::SelectorRule(const std::string& selector)
+{
+    selector_ = trim(selector);
+    atom_ = kNoAtom;
+    valid_ = Parse();
+}
+
+//Getters
+bool SelectorRule::Valid() const
+{
+    return valid_;
+}
+const std::string& SelectorRule::GetSelector() const
+{
+    return selector_;
+}
+
+//Other
+bool SelectorRule::Matches(const Token& token) const
+{
+    if(!valid_) return false;
+    if(!name_.empty()
+       && !AtomTable::Equal(atom_, StringView(name_), token.atom, token.name))
+        return false;
+    for(size_t i = 0; i < conditions_.size(); i++)
+        if(!Check(conditions_[i], token)) return false;
+    return true;
+}
+
+bool SelectorRule::Matches(Atom atom, const StringView& name,
+                           const StringView* attributeNames,
+                           const StringView* attributeValues,
+                           size_t count) const
+{
+    if(!valid_) return false;
+    if(!name_.empty() && !AtomTable::Equal(atom_, StringView(name_), atom, name))
+        return false;
+    for(size_t i = 0; i < conditions_.size(); i++)
+    {
+        size_t j = 0;
+        while(j < count && !CheckAttribute(conditions_[i], attributeNames[j],
+                                           attributeValues[j]))
+            j++;
+        if(j == count) return false;
+    }
+    return true;
+}
+
+//Protected member functions
+bool SelectorRule::Parse()
+{
+    const std::string& s = selector_;
+    size_t pos = 0;
+    while(pos < s.length() && isNameChar(s[pos]))
+        pos++;
+    if(pos > 0)
+    {
+        name_ = s.substr(0, pos);
+        atom_ = AtomTable::Find(StringView(name_));
+    }
+    else if(pos < s.length() && s[pos] == '*')
+        pos++;
+    while(pos < s.length())
+    {
+        Condition condition;
+        char kind = s[pos++];
+        if(kind == '.' || kind == '#')
+        {
+            size_t begin = pos;
+            while(pos < s.length() && isNameChar(s[pos]))
+                pos++;
+            if(pos == begin) return false;
+            condition.type = kind == '.' ? ConditionType::kClass
+                                         : ConditionType::kId;
+            condition.value = s.substr(begin, pos - begin);
+        }
+        else if(kind == '[')
+        {
+            size_t end = s.find(']', pos);
+            if(end == std::string::npos) return false;
+            std::string inner = s.substr(pos, end - pos);
+            pos = end + 1;
+            size_t equals = inner.find('=');
+            size_t nameEnd = equals;
+            condition.type = ConditionType::kValue;
+            if(equals != std::string::npos && equals > 0)
+            {
+                nameEnd = equals - 1;
+                switch(inner[equals - 1])
+                {
+                case '~': condition.type = ConditionType::kWord; break;
+                case '|': condition.type = ConditionType::kDashPrefix; break;
+                case '^': condition.type = ConditionType::kPrefix; break;
+                case '$': condition.type = ConditionType::kSuffix; break;
+                case '*': condition.type = ConditionType::kSubstring; break;
+                default: nameEnd = equals;
+                }
+            }
+            condition.name = trim(inner.substr(0, nameEnd));
+            if(condition.name.empty()) return false;
+            if(equals == std::string::npos)
+                condition.type = ConditionType::kAttribute;
+            else
+            {
+                condition.value = trim(inner.substr(equals + 1));
+                size_t length = condition.value.length();
+                if(length >= 2 && (condition.value[0] == '"'
+                                   || condition.value[0] == '\'')
+                   && condition.value[length-1] == condition.value[0])
+                    condition.value = condition.value.substr(1, length - 2);
+            }
+        }
+        else return false;  //Combinators and pseudo-classes
+        conditions_.push_back(condition);
+    }
+    return !name_.empty() || !conditions_.empty();
+}
+
+bool SelectorRule::Check(const Condition& condition, const Token& token) const
+{
+    TagLexer lexer(token.name, token.attributes);
+    StringView name, value;
+    while(lexer.NextAttribute(name, value))
+        if(CheckAttribute(condition, name, value)) return true;
+    return false;
+}
+
+bool SelectorRule::CheckAttribute(const Condition& condition,
+                                  const StringView& name,
+                                  const StringView& value)
+{
+    size_t length = condition.value.length();
+    switch(condition.type)
+    {
+    case ConditionType::kClass:
+        return name == "class" && containsWord(value, condition.value);
+    case ConditionType::kId:
+        return name == "id" && value == condition.value;
+    case ConditionType::kAttribute:
+        return name == condition.name;
+    case ConditionType::kValue:
+        return name == condition.name && value == condition.value;
+    case ConditionType::kWord:
+        return name == condition.name && containsWord(value, condition.value);
+    case ConditionType::kDashPrefix:
+        return name == condition.name
+               && (value == condition.value
+                   || (value.GetLength() > length && value.begin()[length] == '-'
+                       && startsWith(value.begin(), value.end(),
+                                     condition.value.c_str())));
+    case ConditionType::kPrefix:
+        return name == condition.name && length > 0
+               && startsWith(value.begin(), value.end(), condition.value.c_str());
+    case ConditionType::kSuffix:
+        return name == condition.name && length > 0
+               && endsWith(value.begin(), value.end(), condition.value.c_str());
+    case ConditionType::kSubstring:
+        return name == condition.name && length > 0
+               && findStr(value.begin(), value.end(), condition.value.c_str())
+                  != nullptr;
+    }
+    return false;
+}
+}
@@ -1,26 +1,31 @@
 #include "style.h"
 
+#include <utility>
+
 namespace idogaf
 {
 Style::Style() : Attribute()
 {
-    name_ = Style::GetStaticName();
+    atom_ = kAtomStyle;
     styles_ = std::vector<DStringPair>();
 }
 
 Style::Style(const Style& other)
 {
-    name_ = Style::GetStaticName();
+    atom_ = kAtomStyle;
     value_ = other.value_;
+    references_ = other.references_;
     styles_ = other.styles_;
 }
 
 Style::Style(const Attribute& attribute)
 {
-    name_ = Style::GetStaticName();
-    value_ = attribute.GetValue();
+    atom_ = kAtomStyle;
     styles_ = std::vector<DStringPair>();
     ParseStringForStyles(attribute.GetValue());
+    //Keep the value as it was written, parsing only adds complete styles
+    value_ = attribute.GetValue();
+    references_ = attribute.HasReferences();
 
 }
 
@@ -28,12 +33,28 @@ Style& Style::operator=(const Style& rhs)
 {
     if (this == &rhs) return *this; // handle self assignment
     //assignment operator
-    name_ = Style::GetStaticName();
+    atom_ = kAtomStyle;
     value_ = rhs.value_;
+    references_ = rhs.references_;
     styles_ = rhs.styles_;
     return *this;
 }
 
+Style::Style(Style&& other) noexcept
+    : Attribute(std::move(other)), styles_(std::move(other.styles_))
+{
+    atom_ = kAtomStyle;
+}
+
+Style& Style::operator=(Style&& rhs) noexcept
+{
+    if (this == &rhs) return *this; // handle self assignment
+    Attribute::operator=(std::move(rhs));
+    atom_ = kAtomStyle;
+    styles_ = std::move(rhs.styles_);
+    return *this;
+}
+
 //Getters
 std::string Style::GetStaticName()
 {
@@ -0,0 +1,96 @@
+#include "taglexer.h"
+
+#include <ctype.h>
+
+namespace idogaf
+{
+
+static inline bool IsSpace(char c)
+{
+    return isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+TagLexer::TagLexer(const char* begin, const char* end)
+{
+    cursor_ = begin;
+    end_ = end;
+    SkipSpaces();
+    const char* nameBegin = cursor_;
+    while(cursor_ < end_ && !IsSpace(*cursor_))
+        cursor_++;
+    name_ = StringView(nameBegin, cursor_);
+}
+
+TagLexer::TagLexer(const StringView& name, const StringView& attributes)
+{
+    cursor_ = attributes.begin();
+    end_ = attributes.end();
+    name_ = name;
+}
+
+//Getters
+StringView TagLexer::GetName() const
+{
+    return name_;
+}
+
+//Other
+bool TagLexer::NextAttribute(StringView& nameOut, StringView& valueOut)
+{
+    bool references;
+    return NextAttribute(nameOut, valueOut, references);
+}
+
+bool TagLexer::NextAttribute(StringView& nameOut, StringView& valueOut,
+                             bool& referencesOut)
+{
+    referencesOut = false;
+    //Skip whitespaces and stray slashes between attributes
+    while(cursor_ < end_ && (IsSpace(*cursor_) || *cursor_ == '/'))
+        cursor_++;
+    if(cursor_ == end_) return false;
+
+    const char* nameBegin = cursor_;
+    while(cursor_ < end_ && !IsSpace(*cursor_) && *cursor_ != '=')
+        cursor_++;
+    nameOut = StringView(nameBegin, cursor_);
+    valueOut = StringView();
+
+    SkipSpaces();
+    if(cursor_ == end_ || *cursor_ != '=') return true;    //No value
+    cursor_++;  //Skip '='
+    SkipSpaces();
+    if(cursor_ == end_) return true;
+
+    if(*cursor_ == '"' || *cursor_ == '\'')
+    {
+        char quote = *cursor_++;
+        const char* valueBegin = cursor_;
+        while(cursor_ < end_ && *cursor_ != quote)
+        {
+            if(*cursor_ == '&') referencesOut = true;
+            cursor_++;
+        }
+        valueOut = StringView(valueBegin, cursor_);
+        if(cursor_ < end_) cursor_++;   //Skip closing quote
+    }
+    else
+    {
+        const char* valueBegin = cursor_;
+        while(cursor_ < end_ && !IsSpace(*cursor_))
+        {
+            if(*cursor_ == '&') referencesOut = true;
+            cursor_++;
+        }
+        valueOut = StringView(valueBegin, cursor_);
+    }
+    return true;
+}
+
+//Protected member functions
+void TagLexer::SkipSpaces()
+{
+    while(cursor_ < end_ && IsSpace(*cursor_))
+        cursor_++;
+}
+}
@@ -0,0 +1,285 @@
+#include "tokenizer.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "misc.h"
+#include "scanner.h"
+#include "taglexer.h"
+
+namespace idogaf
+{
+
+/** Structural characters of text runs, '&' starts character references */
+static const Scanner kTextScanner("<&");
+/** Structural characters of text runs after the first '&' */
+static const Scanner kTagBeginScanner("<");
+/** Structural characters of tag bodies */
+static const Scanner kTagScanner(">\"'");
+/** Structural characters of comments */
+static const Scanner kCommentScanner(">");
+/** Structural characters of raw text element bodies */
+static const Scanner kRawTextScanner("<&");
+
+Tokenizer::Tokenizer()
+{
+    begin_ = nullptr;
+    cursor_ = nullptr;
+    end_ = nullptr;
+    limit_ = nullptr;
+    offset_ = 0;
+    partial_ = false;
+    allowMistypedCommentTags_ = false;
+}
+
+Tokenizer::Tokenizer(const char* data, size_t length)
+{
+    begin_ = data;
+    cursor_ = data;
+    end_ = data + length;
+    limit_ = end_;
+    offset_ = 0;
+    partial_ = false;
+    allowMistypedCommentTags_ = false;
+}
+
+//Getters
+const char* Tokenizer::GetPosition() const
+{
+    return cursor_;
+}
+bool Tokenizer::AtEnd() const
+{
+    return cursor_ >= end_;
+}
+size_t Tokenizer::GetOffset() const
+{
+    return offset_ + (cursor_ - begin_);
+}
+bool Tokenizer::AllowMistypedCommentTags() const
+{
+    return allowMistypedCommentTags_;
+}
+
+//Setters
+void Tokenizer::SetInput(const char* data, size_t length, bool partial)
+{
+    begin_ = data;
+    cursor_ = data;
+    end_ = data + length;
+    limit_ = end_;
+    offset_ = 0;
+    partial_ = partial;
+}
+void Tokenizer::SetLimit(const char* limit)
+{
+    limit_ = limit;
+}
+void Tokenizer::SetOffset(size_t offset)
+{
+    offset_ = offset;
+}
+void Tokenizer::AllowMistypedCommentTags(bool value)
+{
+    allowMistypedCommentTags_ = value;
+}
+
+//Other
+bool Tokenizer::Next(Token& tokenOut)
+{
+    while(cursor_ < limit_)
+    {
+        const char* tokenBegin = cursor_;
+        if(*cursor_ != '<')
+        {
+            const char* textBegin = cursor_;
+            bool references;
+            cursor_ = FindTagBegin(cursor_, references);
+            //Text may continue in the next part of the input
+            if(cursor_ == end_ && partial_)
+                return Incomplete(tokenBegin);
+            const char* textEnd = cursor_;
+            trim(textBegin, textEnd);
+            if(textBegin == textEnd) continue;  //Whitespaces only
+            tokenOut = Token();
+            tokenOut.type = TokenType::kText;
+            tokenOut.text = StringView(textBegin, textEnd);
+            tokenOut.references = references;
+            tokenOut.source = StringView(tokenBegin, cursor_);
+            tokenOut.offset = offset_ + (tokenBegin - begin_);
+            return true;
+        }
+        //Here cursor points at '<' (next tag ready to extract).
+        const char* tagBegin = cursor_;
+        tokenOut = Token();
+        //Not enough characters to tell if it's a comment
+        if(end_ - tagBegin < 5 && partial_)
+            return Incomplete(tokenBegin);
+
+        bool mistyped = allowMistypedCommentTags_
+                        && startsWith(tagBegin, end_, "<! --");
+        if(mistyped || startsWith(tagBegin, end_, "<!--"))   //Comment tag
+        {
+            const char* commentEnd = FindCommentEnd(tagBegin + (mistyped ? 3 : 2));
+            if(commentEnd == end_ && partial_)
+                return Incomplete(tokenBegin);
+            const char* bodyBegin = tagBegin + (mistyped ? 5 : 4);
+            const char* bodyEnd = commentEnd == end_ ? end_ : commentEnd - 2;
+            if(bodyEnd < bodyBegin) bodyEnd = bodyBegin;
+            cursor_ = commentEnd == end_ ? end_ : commentEnd + 1;
+            tokenOut.type = TokenType::kComment;
+            tokenOut.text = StringView(bodyBegin, bodyEnd);
+            tokenOut.source = StringView(tokenBegin, cursor_);
+            tokenOut.offset = offset_ + (tokenBegin - begin_);
+            return true;
+        }
+
+        const char* tagEnd = FindTagEnd(tagBegin);
+        if(tagEnd == end_ && partial_)
+            return Incomplete(tokenBegin);
+        if(tagEnd == end_)  //Unterminated tag, drop it
+        {
+            cursor_ = end_;
+            return false;
+        }
+        cursor_ = tagEnd + 1;
+
+        if(startsWith(tagBegin, tagEnd, "<!DOCTYPE"))
+        {
+            //Extract anything between '<!DOCTYPE' and '>'
+            const char* doctypeBegin = tagBegin + 9;
+            const char* doctypeEnd = tagEnd;
+            trim(doctypeBegin, doctypeEnd);
+            tokenOut.type = TokenType::kDoctype;
+            tokenOut.text = StringView(doctypeBegin, doctypeEnd);
+        }
+        else if(tagBegin[1] == '/')  //Closing tag
+        {
+            //Extract anything between '</' and '>'
+            const char* nameBegin = tagBegin + 2;
+            const char* nameEnd = tagEnd;
+            trim(nameBegin, nameEnd);
+            tokenOut.type = TokenType::kEndTag;
+            tokenOut.name = StringView(nameBegin, nameEnd);
+            tokenOut.atom = AtomTable::Find(tokenOut.name);
+        }
+        else    //Opening or empty tag
+        {
+            tokenOut.type = TokenType::kStartTag;
+            tokenOut.selfClosing = tagEnd - tagBegin > 1 && tagEnd[-1] == '/';
+            const char* innerEnd = tokenOut.selfClosing ? tagEnd - 1 : tagEnd;
+            TagLexer lexer(tagBegin + 1, innerEnd);
+            tokenOut.name = lexer.GetName();
+            tokenOut.atom = AtomTable::Find(tokenOut.name);
+            tokenOut.attributes = StringView(tokenOut.name.end(), innerEnd);
+            if(!tokenOut.selfClosing
+               && (AtomTable::GetProperties(tokenOut.atom) & kTagRawText))
+            {
+                //Since raw text elements can't have children, we extract
+                //text and return it together with the tag
+                const char* bodyBegin = cursor_;
+                const char* bodyEnd = FindRawTextEnd(tokenOut.atom, bodyBegin,
+                                                     cursor_,
+                                                     tokenOut.references);
+                if(bodyEnd == end_ && partial_)
+                    return Incomplete(tokenBegin);
+                trim(bodyBegin, bodyEnd);
+                tokenOut.rawText = true;
+                tokenOut.text = StringView(bodyBegin, bodyEnd);
+            }
+        }
+        tokenOut.source = StringView(tokenBegin, cursor_);
+        tokenOut.offset = offset_ + (tokenBegin - begin_);
+        return true;
+    }
+    return false;
+}
+
+//Protected member functions
+bool Tokenizer::Incomplete(const char* tokenBegin)
+{
+    cursor_ = tokenBegin;
+    return false;
+}
+
+const char* Tokenizer::FindTagBegin(const char* cursor,
+                                    bool& referencesOut) const
+{
+    cursor = kTextScanner.Find(cursor, end_);
+    referencesOut = cursor != end_ && *cursor == '&';
+    //One '&' is enough, look just for the tag from there
+    if(referencesOut) cursor = kTagBeginScanner.Find(cursor + 1, end_);
+    return cursor;
+}
+
+const char* Tokenizer::FindTagEnd(const char* tagBegin) const
+{
+    const char* cursor = tagBegin + 1;
+    while(true)
+    {
+        cursor = kTagScanner.Find(cursor, end_);
+        if(cursor == end_ || *cursor == '>') return cursor;
+        //Quote, skip the value only if it follows '='
+        const char* prev = cursor - 1;
+        while(prev > tagBegin && isspace(static_cast<unsigned char>(*prev)))
+            prev--;
+        char quote = *cursor++;
+        if(*prev != '=') continue;
+        const char* valueEnd = static_cast<const char*>(
+                    memchr(cursor, quote, end_ - cursor));
+        if(valueEnd == nullptr) return end_;
+        cursor = valueEnd + 1;
+    }
+}
+
+const char* Tokenizer::FindCommentEnd(const char* begin) const
+{
+    const char* cursor = begin;
+    while(true)
+    {
+        cursor = kCommentScanner.Find(cursor, end_);
+        if(cursor == end_) return end_;
+        if(cursor - begin >= 2 && cursor[-1] == '-' && cursor[-2] == '-')
+            return cursor;
+        cursor++;
+    }
+}
+
+const char* Tokenizer::FindRawTextEnd(Atom atom, const char* begin,
+                                      const char*& cursorOut,
+                                      bool& referencesOut) const
+{
+    StringView name = AtomTable::GetName(atom);
+    const char* cursor = begin;
+    referencesOut = false;
+    while(true)
+    {
+        cursor = kRawTextScanner.Find(cursor, end_);
+        if(cursor == end_) break;
+        if(*cursor == '&')
+        {
+            referencesOut = true;
+            cursor++;
+            continue;
+        }
+        if(end_ - cursor < 2 || cursor[1] != '/'
+           || !startsWithIgnoreCase(cursor + 2, end_, name.GetData(),
+                                    name.GetLength()))
+        {
+            cursor++;
+            continue;
+        }
+        const char* closeEnd = cursor + 2 + name.GetLength();
+        while(closeEnd < end_ && isspace(static_cast<unsigned char>(*closeEnd)))
+            closeEnd++;
+        if(closeEnd < end_ && *closeEnd == '>')
+        {
+            cursorOut = closeEnd + 1;
+            return cursor;
+        }
+        cursor = closeEnd;
+    }
+    cursorOut = end_;
+    return end_;
+}
+}
@@ -0,0 +1,99 @@
+#include "tokenreader.h"
+
+#include "misc.h"
+
+namespace idogaf
+{
+
+TokenReader::TokenReader(const char* data, size_t length)
+    : tokenizer_(data, length)
+{
+    token_ = Token();
+}
+
+//Getters
+const Token& TokenReader::GetToken() const
+{
+    return token_;
+}
+TokenType TokenReader::GetType() const
+{
+    return token_.type;
+}
+StringView TokenReader::GetName() const
+{
+    return token_.name;
+}
+StringView TokenReader::GetText() const
+{
+    return token_.text;
+}
+TagLexer TokenReader::GetAttributes() const
+{
+    return TagLexer(token_.name, token_.attributes);
+}
+bool TokenReader::GetAttribute(const StringView& name,
+                               StringView& valueOut) const
+{
+    if(token_.type != TokenType::kStartTag) return false;
+    TagLexer lexer = GetAttributes();
+    StringView attributeName, value;
+    while(lexer.NextAttribute(attributeName, value))
+    {
+        if(attributeName == name)
+        {
+            valueOut = value;
+            return true;
+        }
+    }
+    return false;
+}
+bool TokenReader::IsEmptyElement() const
+{
+    if(token_.type != TokenType::kStartTag) return false;
+    return token_.selfClosing || token_.rawText
+           || isSingletonTag(token_.atom);
+}
+const char* TokenReader::GetPosition() const
+{
+    return tokenizer_.GetPosition();
+}
+bool TokenReader::AllowMistypedCommentTags() const
+{
+    return tokenizer_.AllowMistypedCommentTags();
+}
+
+//Setters
+void TokenReader::AllowMistypedCommentTags(bool value)
+{
+    tokenizer_.AllowMistypedCommentTags(value);
+}
+
+//Other
+bool TokenReader::Next()
+{
+    if(tokenizer_.Next(token_)) return true;
+    token_ = Token();
+    return false;
+}
+
+bool TokenReader::SkipSubtree()
+{
+    if(token_.type != TokenType::kStartTag || IsEmptyElement()) return true;
+    //Name stays valid, it points into the document
+    StringView name = token_.name;
+    Atom atom = token_.atom;
+    size_t depth = 1;
+    while(Next())
+    {
+        //Same comparison as the TreeBuilder uses to close elements
+        if(!AtomTable::Equal(token_.atom, token_.name, atom, name))
+            continue;
+        if(token_.type == TokenType::kStartTag && !token_.selfClosing)
+            depth++;
+        else if(token_.type == TokenType::kEndTag && --depth == 0)
+            return true;
+    }
+    return false;
+}
+}
@@ -0,0 +1,437 @@
+#include "treebuilder.h"
+
+#include <ctype.h>
+
+#include "misc.h"
+
+namespace idogaf
+{
+
+TreeBuilder::TreeBuilder(Handler& handler)
+{
+    handler_ = &handler;
+    depth_ = 0;
+    atom_ = kNoAtom;
+    offset_ = 0;
+    endOffset_ = 0;
+    textSinceTag_ = false;
+    finished_ = false;
+    failed_ = false;
+    skipUnnecessaryClosingTags_ = false;
+    pruneDepth_ = 0;
+    pruneAtom_ = kNoAtom;
+    stopped_ = false;
+    stopOffset_ = 0;
+    exceededLimit_ = Limit::kNone;
+    nodes_ = 0;
+    textLength_ = 0;
+}
+
+//Getters
+bool TreeBuilder::Failed() const
+{
+    return failed_;
+}
+bool TreeBuilder::Finished() const
+{
+    return finished_;
+}
+const std::string& TreeBuilder::GetErrorTag() const
+{
+    return errorTag_;
+}
+size_t TreeBuilder::GetOffset() const
+{
+    return offset_;
+}
+size_t TreeBuilder::GetDepth() const
+{
+    return depth_;
+}
+bool TreeBuilder::SkipUnnecessaryClosingTags() const
+{
+    return skipUnnecessaryClosingTags_;
+}
+const std::vector<SelectorRule>& TreeBuilder::GetPruneRules() const
+{
+    return pruneRules_;
+}
+bool TreeBuilder::Stopped() const
+{
+    return stopped_;
+}
+size_t TreeBuilder::GetStopOffset() const
+{
+    return stopOffset_;
+}
+const ParseLimits& TreeBuilder::Limits() const
+{
+    return limits_;
+}
+Limit TreeBuilder::GetExceededLimit() const
+{
+    return exceededLimit_;
+}
+
+//Setters
+void TreeBuilder::SkipUnnecessaryClosingTags(bool value)
+{
+    skipUnnecessaryClosingTags_ = value;
+}
+void TreeBuilder::AddPruneRule(const SelectorRule& rule)
+{
+    if(rule.Valid()) pruneRules_.push_back(rule);
+}
+void TreeBuilder::ClearPruneRules()
+{
+    pruneRules_.clear();
+}
+bool TreeBuilder::AddStopCondition(const SelectorRule& rule, size_t count)
+{
+    if(!rule.Valid() || count == 0
+       || stopConditions_.size() == kMaxStopConditions) return false;
+    StopCondition condition;
+    condition.rule = rule;
+    condition.count = count;
+    condition.found = 0;
+    stopConditions_.push_back(condition);
+    return true;
+}
+void TreeBuilder::ClearStopConditions()
+{
+    stopConditions_.clear();
+}
+void TreeBuilder::Limits(const ParseLimits& limits)
+{
+    limits_ = limits;
+}
+
+//Other
+void TreeBuilder::Reset(Handler& handler)
+{
+    handler_ = &handler;
+    depth_ = 0;
+    atom_ = kNoAtom;
+    offset_ = 0;
+    endOffset_ = 0;
+    textSinceTag_ = false;
+    finished_ = false;
+    failed_ = false;
+    errorTag_.clear();
+    pruneDepth_ = 0;
+    for(size_t i = 0; i < stopConditions_.size(); i++)
+        stopConditions_[i].found = 0;
+    stopped_ = false;
+    stopOffset_ = 0;
+    exceededLimit_ = Limit::kNone;
+    nodes_ = 0;
+    textLength_ = 0;
+}
+
+bool TreeBuilder::Process(const Token& token)
+{
+    if(finished_) return false;
+    offset_ = token.offset;
+    endOffset_ = token.offset + token.source.GetLength();
+    if(pruneDepth_ > 0 && Prune(token)) return true;
+    switch(token.type)
+    {
+    case TokenType::kText:
+        //Text outside of the root element is dropped
+        if(depth_ == 0) return true;
+        if(!CheckText(token.text.GetLength())) return false;
+        textSinceTag_ = true;
+        handler_->SetSource(OffsetOf(token, token.text.begin()),
+                            OffsetOf(token, token.text.end()));
+        handler_->SetReferences(token.references);
+        return handler_->OnText(token.text) || Stop();
+    case TokenType::kComment:
+        if(depth_ == 0) return true;
+        if(!CheckText(token.text.GetLength())) return false;
+        handler_->SetSource(offset_, endOffset_);
+        return handler_->OnComment(token.text) || Stop();
+    case TokenType::kDoctype:
+        handler_->SetSource(offset_, endOffset_);
+        return handler_->OnDoctype(token.text) || Stop();
+    case TokenType::kStartTag:
+        return ProcessStartTag(token);
+    case TokenType::kEndTag:
+        return ProcessEndTag(token);
+    }
+    return true;
+}
+
+void TreeBuilder::Finish()
+{
+    pruneDepth_ = 0;
+    while(!finished_ && depth_ > 0)
+        if(!EndElement(endOffset_, endOffset_)) Stop();
+    finished_ = true;
+}
+
+//Protected member functions
+bool TreeBuilder::ProcessStartTag(const Token& token)
+{
+    if(token.name.Empty()) return true;
+    atom_ = token.atom;
+    if(atom_ == kNoAtom) name_.assign(token.name.begin(), token.name.end());
+    bool empty = token.selfClosing || token.rawText || isSingletonTag(atom_);
+    bool text = textSinceTag_;
+    textSinceTag_ = false;
+    if(depth_ == 0)  //Root element
+    {
+        if(empty) return Fail(token.name);
+        if(!CheckLimits(token)) return false;
+        Push();
+        return StartElement(token);
+    }
+    if(empty)
+    {
+        if(IsPruned(token)) return true;
+        if(!CheckLimits(token)) return false;
+        Push();
+        if(!StartElement(token)) return false;
+        if(!token.rawText) return EndElement(endOffset_, endOffset_);
+        if(!token.text.Empty())
+        {
+            handler_->SetSource(OffsetOf(token, token.text.begin()),
+                                OffsetOf(token, token.text.end()));
+            handler_->SetReferences(token.references);
+            if(!handler_->OnRawText(token.text)) return Stop();
+        }
+        //Closing tag follows the body after optional whitespaces
+        const char* closeBegin = token.text.end();
+        while(closeBegin < token.source.end()
+              && isspace(static_cast<unsigned char>(*closeBegin)))
+            closeBegin++;
+        return EndElement(OffsetOf(token, closeBegin), endOffset_);
+    }
+    if(depth_ > 1 && !text && omittClosingTag(atoms_[depth_-1], atom_))
+    {
+        //Closing tag of the current element was omitted
+        if(!EndElement(offset_, offset_)) return false;
+    }
+    if(IsPruned(token))
+    {
+        pruneDepth_ = 1;
+        pruneAtom_ = atom_;
+        if(atom_ == kNoAtom) pruneName_ = name_;
+        return true;
+    }
+    if(!CheckLimits(token)) return false;
+    Push();
+    return StartElement(token);
+}
+
+bool TreeBuilder::ProcessEndTag(const Token& token)
+{
+    if(token.name.Empty()) return true;
+    bool text = textSinceTag_;
+    textSinceTag_ = false;
+    if(depth_ == 0) return Fail(token.name);
+    if(HasName(depth_-1, token.atom, token.name))
+    {
+        if(!EndElement(offset_, endOffset_)) return false;
+    }
+    else if(depth_ > 1 && !text
+            && HasName(depth_-2, token.atom, token.name)
+            && omittClosingTagNMC(atoms_[depth_-1], atoms_[depth_-2]))
+    {
+        //Closing tag of the current element was omitted, because
+        //it's parent has no more content
+        if(!EndElement(offset_, offset_)
+           || !EndElement(offset_, endOffset_)) return false;
+    }
+    else if(skipUnnecessaryClosingTags_) return true;
+    else return Fail(token.name);
+
+    if(depth_ == 0) finished_ = true;   //Root element closed
+    return !finished_;
+}
+
+bool TreeBuilder::IsPruned(const Token& token) const
+{
+    for(size_t i = 0; i < pruneRules_.size(); i++)
+        if(pruneRules_[i].Matches(token)) return true;
+    return false;
+}
+
+bool TreeBuilder::Prune(const Token& token)
+{
+    if(token.type == TokenType::kStartTag)
+    {
+        if(!token.selfClosing && !token.rawText && !isSingletonTag(token.atom)
+           && AtomTable::Equal(pruneAtom_, StringView(pruneName_),
+                               token.atom, token.name))
+            pruneDepth_++;
+    }
+    else if(token.type == TokenType::kEndTag)
+    {
+        if(AtomTable::Equal(pruneAtom_, StringView(pruneName_),
+                            token.atom, token.name))
+            pruneDepth_--;
+        else
+        {
+            //Closing tag of an open element ends the pruned one too,
+            //in case its closing tag was omitted
+            for(size_t level = 0; level < depth_; level++)
+            {
+                if(HasName(level, token.atom, token.name))
+                {
+                    pruneDepth_ = 0;
+                    textSinceTag_ = false;
+                    return false;
+                }
+            }
+        }
+        if(pruneDepth_ == 0) textSinceTag_ = false;
+    }
+    return true;
+}
+
+bool TreeBuilder::CheckLimits(const Token& token)
+{
+    if(limits_.maxDepth != 0 && depth_ >= limits_.maxDepth)
+        return Exceed(Limit::kDepth);
+    if(limits_.maxNodes != 0 && nodes_ >= limits_.maxNodes)
+        return Exceed(Limit::kNodes);
+    if(limits_.maxAttributes != 0 || limits_.maxAttributeLength != 0)
+    {
+        TagLexer lexer(token.name, token.attributes);
+        StringView name, value;
+        size_t count = 0;
+        while(lexer.NextAttribute(name, value))
+        {
+            if(limits_.maxAttributes != 0 && ++count > limits_.maxAttributes)
+                return Exceed(Limit::kAttributes);
+            if(limits_.maxAttributeLength != 0
+               && value.GetLength() > limits_.maxAttributeLength)
+                return Exceed(Limit::kAttributeLength);
+        }
+    }
+    if(token.rawText && !CheckText(token.text.GetLength())) return false;
+    nodes_++;
+    return true;
+}
+
+bool TreeBuilder::CheckText(size_t length)
+{
+    textLength_ += length;
+    if(limits_.maxTextLength != 0 && textLength_ > limits_.maxTextLength)
+        return Exceed(Limit::kTextLength);
+    return true;
+}
+
+bool TreeBuilder::StartElement(const Token& token)
+{
+    for(size_t i = 0; i < stopConditions_.size(); i++)
+        if(stopConditions_[i].rule.Matches(token))
+            stopMarks_[depth_-1] |= 1u << i;
+    //Body and closing tag of a raw text element are not a part of it
+    size_t end = token.rawText ? OffsetOf(token, token.attributes.end()) + 1
+                               : endOffset_;
+    handler_->SetSource(offset_, end);
+    TagLexer attributes(token.name, token.attributes);
+    return handler_->OnStartTag(token.name, token.atom, attributes) || Stop();
+}
+
+bool TreeBuilder::EndElement(size_t begin, size_t end)
+{
+    depth_--;
+    handler_->SetSource(begin, end);
+    if(!handler_->OnEndTag(GetName(depth_))) return Stop();
+    if(stopMarks_[depth_] != 0 && CountMatch(stopMarks_[depth_]))
+        return StopAt(end);
+    return true;
+}
+
+bool TreeBuilder::CountMatch(unsigned int marks)
+{
+    bool met = true;
+    for(size_t i = 0; i < stopConditions_.size(); i++)
+    {
+        StopCondition& condition = stopConditions_[i];
+        if(marks & (1u << i)) condition.found++;
+        if(condition.found < condition.count) met = false;
+    }
+    return met;
+}
+
+bool TreeBuilder::StopAt(size_t offset)
+{
+    CloseAll(offset);
+    stopped_ = true;
+    stopOffset_ = offset;
+    finished_ = true;
+    return false;
+}
+
+bool TreeBuilder::Exceed(Limit limit)
+{
+    exceededLimit_ = limit;
+    if(!limits_.truncate)
+    {
+        failed_ = true;
+        finished_ = true;
+        return false;
+    }
+    CloseAll(offset_);
+    finished_ = true;
+    return false;
+}
+
+void TreeBuilder::CloseAll(size_t offset)
+{
+    //Close every open element, so handlers get a complete tree
+    while(depth_ > 0)
+    {
+        depth_--;
+        handler_->SetSource(offset, offset);
+        if(!handler_->OnEndTag(GetName(depth_))) break;
+    }
+}
+
+size_t TreeBuilder::OffsetOf(const Token& token, const char* position)
+{
+    return token.offset + (position - token.source.begin());
+}
+
+void TreeBuilder::Push()
+{
+    if(depth_ == stack_.size())
+    {
+        stack_.push_back(std::string());
+        atoms_.push_back(kNoAtom);
+        stopMarks_.push_back(0);
+    }
+    atoms_[depth_] = atom_;
+    stopMarks_[depth_] = 0;
+    if(atom_ == kNoAtom) stack_[depth_] = name_;
+    depth_++;
+}
+
+StringView TreeBuilder::GetName(size_t level) const
+{
+    if(atoms_[level] != kNoAtom) return AtomTable::GetName(atoms_[level]);
+    return StringView(stack_[level]);
+}
+
+bool TreeBuilder::HasName(size_t level, Atom atom, const StringView& name) const
+{
+    return AtomTable::Equal(atoms_[level], StringView(stack_[level]), atom, name);
+}
+
+bool TreeBuilder::Fail(const StringView& tagName)
+{
+    errorTag_ = tagName.ToString();
+    failed_ = true;
+    finished_ = true;
+    return false;
+}
+
+bool TreeBuilder::Stop()
+{
+    finished_ = true;
+    return false;
+}
+}
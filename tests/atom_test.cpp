@@ -0,0 +1,73 @@
+#include "atom.h"
+
+#include <string>
+
+#include "test.h"
+
+using namespace idogaf;
+
+static void TestFindReturnsEveryAtom()
+{
+    for(Atom atom = kNoAtom + 1; atom < kAtomCount; atom++)
+    {
+        StringView name = AtomTable::GetName(atom);
+        CHECK(!name.Empty());
+        if(AtomTable::Find(name) != atom)
+            std::cerr << "\"" << name.ToString() << "\" " << atom << std::endl;
+        CHECK(AtomTable::Find(name) == atom);
+    }
+    CHECK(AtomTable::GetName(kNoAtom).Empty());
+    CHECK(AtomTable::GetName(kAtomCount).Empty());
+    CHECK(AtomTable::Find(StringView()) == kNoAtom);
+}
+
+static void TestAtomsAreSorted()
+{
+    //The enum, the names table and the switch in Find() follow this order
+    for(Atom atom = kNoAtom + 2; atom < kAtomCount; atom++)
+    {
+        std::string previous = AtomTable::GetName(atom - 1).ToString();
+        std::string name = AtomTable::GetName(atom).ToString();
+        if(!(previous < name))
+            std::cerr << "\"" << previous << "\" before \"" << name << "\""
+                      << std::endl;
+        CHECK(previous < name);
+    }
+}
+
+static void TestFindRejectsOtherNames()
+{
+    const char suffixes[] = { 'a', 'z', '-', '1' };
+    for(Atom atom = kNoAtom + 1; atom < kAtomCount; atom++)
+    {
+        std::string name = AtomTable::GetName(atom).ToString();
+        std::string variants[7] = { name.substr(0, name.length() - 1),
+                                    name.substr(1), name, name, name };
+        variants[2][0] = static_cast<char>(name[0] - 'a' + 'A');
+        variants[3][name.length() - 1] = '_';
+        for(size_t i = 0; i < sizeof(suffixes); i++)
+        {
+            variants[4] = name + suffixes[i];
+            variants[5] = suffixes[i] + name;
+            variants[6] = name + name;
+            for(size_t j = 0; j < 7; j++)
+            {
+                Atom found = AtomTable::Find(variants[j]);
+                //Some variants are other standard names, i.e. "th" of "tho"
+                CHECK(found == kNoAtom
+                      || AtomTable::GetName(found) == variants[j]);
+            }
+        }
+    }
+    //Names are case sensitive
+    CHECK(AtomTable::Find(StringView("DIV", 3)) == kNoAtom);
+    CHECK(AtomTable::Find(StringView("Div", 3)) == kNoAtom);
+}
+
+int main()
+{
+    TestFindReturnsEveryAtom();
+    TestAtomsAreSorted();
+    TestFindRejectsOtherNames();
+    return TEST_RESULT();
+}
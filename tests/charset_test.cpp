@@ -0,0 +1,92 @@
+#include "charset.h"
+
+#include <string>
+
+#include "test.h"
+
+using namespace idogaf;
+
+static std::string ToUtf8(const std::string& data, Encoding encoding)
+{
+    std::string out;
+    Charset::ToUtf8(data.data(), data.size(), encoding, out);
+    return out;
+}
+
+static void TestSingleByteTables()
+{
+    //Windows-1252 differs from iso-8859-1 in 0x80-0x9F
+    CHECK(ToUtf8("a\x80\x9F\xE9", Encoding::kWindows1252)
+          == "a\xE2\x82\xAC\xC5\xB8\xC3\xA9");
+    CHECK(ToUtf8("\x81", Encoding::kWindows1252) == "\xC2\x81");
+    CHECK(ToUtf8("\xA1\xFF", Encoding::kIso8859_2) == "\xC4\x84\xCB\x99");
+    CHECK(ToUtf8("\xB0\xF0", Encoding::kIso8859_5) == "\xD0\x90\xE2\x84\x96");
+    CHECK(ToUtf8("\xC7", Encoding::kIso8859_6) == "\xD8\xA7");
+    CHECK(ToUtf8("\xA4\xC1", Encoding::kIso8859_7) == "\xE2\x82\xAC\xCE\x91");
+    CHECK(ToUtf8("\xE0", Encoding::kIso8859_8) == "\xD7\x90");
+    CHECK(ToUtf8("\xA4\xBC", Encoding::kIso8859_15) == "\xE2\x82\xAC\xC5\x92");
+    //Bytes without a character in the table
+    CHECK(ToUtf8("\xA1", Encoding::kIso8859_6) == "\xEF\xBF\xBD");
+    //ASCII is copied as it is, in long runs too
+    std::string ascii(100, 'x');
+    CHECK(ToUtf8(ascii + "\xE9" + ascii, Encoding::kWindows1252)
+          == ascii + "\xC3\xA9" + ascii);
+}
+
+static void TestShiftJis()
+{
+    CHECK(ToUtf8("\x93\xFA\x96\x7B", Encoding::kShiftJis)
+          == "\xE6\x97\xA5\xE6\x9C\xAC");
+    CHECK(ToUtf8("\x82\xA0\x81\x40", Encoding::kShiftJis)
+          == "\xE3\x81\x82\xE3\x80\x80");
+    //Half-width katakana are single bytes
+    CHECK(ToUtf8("\xB1<", Encoding::kShiftJis) == "\xEF\xBD\xB1<");
+    //An ASCII trail byte is not swallowed by a broken pair
+    CHECK(ToUtf8("\x81<p>", Encoding::kShiftJis) == "\xEF\xBF\xBD<p>");
+    //Lead byte cut off at the end
+    CHECK(ToUtf8("a\x93", Encoding::kShiftJis) == "a\xEF\xBF\xBD");
+    CHECK(Charset::FromLabel("sjis") == Encoding::kShiftJis);
+    CHECK(Charset::FromLabel(" Shift_JIS ") == Encoding::kShiftJis);
+    //Never cut between a lead and a trail byte
+    CHECK(Charset::FindCharacterBoundary("a\x93\xFA", 2, Encoding::kShiftJis)
+          == 1);
+    CHECK(Charset::FindCharacterBoundary("a\x93\xFA", 3, Encoding::kShiftJis)
+          == 3);
+}
+
+static void TestUtf16SurrogatePairs()
+{
+    //U+1F600 is D83D DE00
+    std::string le("A\0\x3D\xD8\x00\xDE", 6);
+    std::string be("\0A\xD8\x3D\xDE\x00", 6);
+    CHECK(ToUtf8(le, Encoding::kUtf16Le) == "A\xF0\x9F\x98\x80");
+    CHECK(ToUtf8(be, Encoding::kUtf16Be) == "A\xF0\x9F\x98\x80");
+    //Byte order marks pick the byte order and are dropped
+    size_t bomLength;
+    CHECK(Charset::DetectBom("\xFF\xFE" "A", 3, bomLength) == Encoding::kUtf16Le);
+    CHECK(bomLength == 2);
+    CHECK(ToUtf8(std::string("\xFE\xFF", 2) + be, Encoding::kUtf16Be)
+          == "A\xF0\x9F\x98\x80");
+    //Unpaired surrogates are replaced, the next unit is kept
+    CHECK(ToUtf8(std::string("\x3D\xD8" "A\0", 4), Encoding::kUtf16Le)
+          == "\xEF\xBF\xBD" "A");
+    CHECK(ToUtf8(std::string("\x00\xDE" "A\0", 4), Encoding::kUtf16Le)
+          == "\xEF\xBF\xBD" "A");
+    CHECK(ToUtf8(std::string("A\0\x3D\xD8", 4), Encoding::kUtf16Le)
+          == "A\xEF\xBF\xBD");
+    //Never cut between the two halves of a pair
+    CHECK(Charset::FindCharacterBoundary(le.data(), 4, Encoding::kUtf16Le)
+          == 2);
+    CHECK(Charset::FindCharacterBoundary(le.data(), 5, Encoding::kUtf16Le)
+          == 2);
+    CHECK(Charset::FindCharacterBoundary(le.data(), 6, Encoding::kUtf16Le)
+          == 6);
+}
+
+int main()
+{
+    TestSingleByteTables();
+    TestShiftJis();
+    TestUtf16SurrogatePairs();
+    return TEST_RESULT();
+}
@@ -0,0 +1,109 @@
+#include "decompressor.h"
+
+#include <algorithm>
+#include <string>
+
+#include "test.h"
+
+using namespace idogaf;
+
+//gzip members of "<html><body><p>one</p>" and "<p>two</p></body></html>"
+static const std::string kGzipFirst(
+    "\x1F\x8B\x08\x00\x00\x00\x00\x00\x02\x03\xB3\xC9\x28\xC9\xCD\xB1\xB3"
+    "\x49\xCA\x4F\xA9\xB4\xB3\x29\xB0\xCB\xCF\x4B\xB5\xD1\x2F\xB0\x03\x00"
+    "\x8B\xBF\x21\x74\x16\x00\x00\x00", 42);
+static const std::string kGzipSecond(
+    "\x1F\x8B\x08\x00\x00\x00\x00\x00\x02\x03\xB3\x29\xB0\x2B\x29\xCF\xB7"
+    "\xD1\x2F\xB0\xB3\xD1\x4F\xCA\x4F\xA9\x04\x52\x19\x25\xB9\x39\x76\x00"
+    "\xFD\x9E\xFD\xAA\x18\x00\x00\x00", 42);
+//zstd frame of both parts
+static const std::string kZstd(
+    "\x28\xB5\x2F\xFD\x20\x2E\x4D\x01\x00\xF8\x3C\x68\x74\x6D\x6C\x3E\x3C"
+    "\x62\x6F\x64\x79\x3E\x3C\x70\x3E\x6F\x6E\x65\x3C\x2F\x70\x74\x77\x6F"
+    "\x2F\x2F\x68\x74\x6D\x6C\x3E\x03\x00\x3E\x47\x80\x1B\x6B\x15\x26", 50);
+
+static size_t CountParagraphs(PushParser& parser)
+{
+    return parser.GetDocumentPtr()->GetRoot().Find("p").size();
+}
+
+static void TestConcatenatedGzipMembers()
+{
+    if(!Decompressor::Supported(Compression::kGzip)) return;
+    const std::string data = kGzipFirst + kGzipSecond;
+    Decompressor decompressor;
+    PushParser parser;
+    CHECK(decompressor.Parse(data.data(), data.size(), parser));
+    CHECK(decompressor.GetCompression() == Compression::kGzip);
+    CHECK(decompressor.GetDecompressedSize() == 46);
+    CHECK(CountParagraphs(parser) == 2);
+
+    //Member boundary inside a part, magic bytes split between parts
+    for(size_t part = 1; part <= 5; part++)
+    {
+        PushParser byParts;
+        decompressor.Reset();
+        for(size_t i = 0; i < data.size(); i += part)
+            CHECK(decompressor.Feed(data.data() + i,
+                                    std::min(part, data.size() - i), byParts));
+        CHECK(decompressor.Finish(byParts));
+        CHECK(CountParagraphs(byParts) == 2);
+    }
+}
+
+static void TestTruncatedGzip()
+{
+    if(!Decompressor::Supported(Compression::kGzip)) return;
+    Decompressor decompressor;
+    decompressor.Silent(true);
+    //Cut inside the second member, in its data and in its trailer
+    const size_t cuts[] = { 12, 30, 36 };
+    for(size_t i = 0; i < sizeof(cuts) / sizeof(cuts[0]); i++)
+    {
+        std::string data = kGzipFirst + kGzipSecond.substr(0, cuts[i]);
+        PushParser parser;
+        parser.Silent(true);
+        CHECK(!decompressor.Parse(data.data(), data.size(), parser));
+    }
+    //A complete member is a complete input, the parser implies end tags
+    PushParser parser;
+    CHECK(decompressor.Parse(kGzipFirst.data(), kGzipFirst.size(), parser));
+    CHECK(CountParagraphs(parser) == 1);
+    //Corrupted data
+    std::string corrupted = kGzipFirst;
+    corrupted[12] = '\xFF';
+    PushParser corruptedParser;
+    corruptedParser.Silent(true);
+    CHECK(!decompressor.Parse(corrupted.data(), corrupted.size(),
+                              corruptedParser));
+}
+
+static void TestZstd()
+{
+    Decompressor decompressor;
+    decompressor.Silent(true);
+    PushParser parser;
+    parser.Silent(true);
+    if(!Decompressor::Supported(Compression::kZstd))
+    {
+        CHECK(!decompressor.Parse(kZstd.data(), kZstd.size(), parser));
+        CHECK(decompressor.GetCompression() == Compression::kZstd);
+        return;
+    }
+    CHECK(decompressor.Parse(kZstd.data(), kZstd.size(), parser));
+    CHECK(CountParagraphs(parser) == 2);
+    for(size_t cut = 4; cut < kZstd.size(); cut += 9)
+    {
+        PushParser truncated;
+        truncated.Silent(true);
+        CHECK(!decompressor.Parse(kZstd.data(), cut, truncated));
+    }
+}
+
+int main()
+{
+    TestConcatenatedGzipMembers();
+    TestTruncatedGzip();
+    TestZstd();
+    return TEST_RESULT();
+}
@@ -0,0 +1,155 @@
+#include "element.h"
+
+#include <string.h>
+#include <utility>
+
+#include "parser.h"
+#include "test.h"
+
+using namespace idogaf;
+
+/** Check parent pointers and positions in a whole subtree */
+static bool IsAdopted(Element* element)
+{
+    for(size_t i = 0; i < element->GetChildrenCount(); i++)
+    {
+        Element* child = element->GetChildPtrAt(i);
+        if(child->GetParent() != element || child->GetPosition() != i
+           || child->HasRightBrother() != (i + 1 < element->GetChildrenCount())
+           || !IsAdopted(child))
+            return false;
+    }
+    return true;
+}
+
+static Element MakeList(size_t items)
+{
+    Element list("ul");
+    for(size_t i = 0; i < items; i++)
+    {
+        Element item("li");
+        item.AddChild(Element("a"));
+        list.AddChild(std::move(item));
+    }
+    return list;
+}
+
+static void TestMovedElementHasNoParent()
+{
+    Element list = MakeList(3);
+    Element moved(std::move(*list.GetChildPtrAt(1)));
+    CHECK(moved.GetParent() == nullptr);
+    CHECK(moved.GetPosition() == 0);
+    CHECK(!moved.HasRightBrother());
+    CHECK(IsAdopted(&moved));
+}
+
+static void TestAddChildKeepsParents()
+{
+    //Every reallocation moves the children to a new buffer
+    Element root("div");
+    for(size_t i = 0; i < 100; i++)
+    {
+        root.AddChild(MakeList(2));
+        CHECK(IsAdopted(&root));
+    }
+    const Element copy = MakeList(2);
+    for(size_t i = 0; i < 100; i++)
+    {
+        root.AddChild(copy);
+        root.AddChildAt(MakeList(1), static_cast<unsigned int>(i));
+        root.AddChildAt(copy, 0);
+    }
+    CHECK(IsAdopted(&root));
+    Vector_E children(40, MakeList(1));
+    root.AddChildren(children);
+    root.AddChildren(std::move(children));
+    CHECK(root.GetChildrenCount() == 480);
+    CHECK(IsAdopted(&root));
+}
+
+static void TestCopiesOutliveArena()
+{
+    const char* html = "<html><body><p class=\"a b\" id=\"x\" data-n=\"v\">"
+                       "text</p><script>var a;</script></body></html>";
+    Element kept;
+    Document document;
+    {
+        Parser parser;
+        parser.Silent(true);
+        parser.UseArena(true);
+        parser.RawText(RawTextMode::kSpan);
+        CHECK(parser.Parse(html, strlen(html)));
+        kept = parser.GetDocumentPtr()->GetRoot();
+        document = parser.GetDocument();
+        //Overwrite the arena before the parser is gone
+        CHECK(parser.Parse("<html></html>", 13));
+    }
+    const Element* documentRoot = document.GetRootPtr();
+    const Element* roots[] = { &kept, documentRoot };
+    for(size_t i = 0; i < 2; i++)
+    {
+        Element body = roots[i]->GetChildren()[0];
+        Element p = body.GetChildren()[0];
+        CHECK(p.GetText() == "text");
+        CHECK(p.GetClass().GetValue() == "a b");
+        CHECK(p.GetId().GetValue() == "x");
+        CHECK(p.GetAttributeByName("data-n").GetValue() == "v");
+        CHECK(body.GetChildren()[1].GetText() == "var a;");
+    }
+}
+
+static void TestDecodedTextWithoutReferences()
+{
+    const char* html = "<html><body><p title=\"a&amp;b\">x &lt; y</p>"
+                       "<div title=\"plain\">plain text</div>"
+                       "<b>one<!--c-->two &amp; three</b>"
+                       "<script>if(a && b) f();</script></body></html>";
+    for(int arena = 0; arena < 2; arena++)
+    {
+        Parser parser;
+        parser.Silent(true);
+        parser.UseArena(arena == 1);
+        CHECK(parser.Parse(html, strlen(html)));
+        Element* body = parser.GetDocumentPtr()->GetRootPtr()->GetChildPtrAt(0);
+        std::string buffer;
+
+        Element* p = body->GetChildPtrAt(0);
+        CHECK(p->HasReferences());
+        CHECK(p->GetDecodedText() == "x < y");
+        CHECK(p->GetDecodedText(buffer) == "x < y");
+        Attribute title = p->GetAttributeByName("title");
+        CHECK(title.HasReferences());
+        CHECK(title.GetDecodedValue(buffer) == "a&b");
+
+        //Without references the raw text is returned as it is
+        Element* div = body->GetChildPtrAt(1);
+        buffer.clear();
+        CHECK(!div->HasReferences());
+        CHECK(div->GetDecodedText(buffer).begin() == div->GetTextView().begin());
+        CHECK(div->GetDecodedText() == "plain text");
+        CHECK(buffer.empty());
+        Attribute plain = div->GetAttributeByName("title");
+        CHECK(!plain.HasReferences());
+        CHECK(plain.GetDecodedValue(buffer).begin()
+              == plain.GetValueView().begin());
+
+        CHECK(body->GetChildPtrAt(2)->HasReferences());
+        CHECK(body->GetChildPtrAt(2)->GetDecodedText() == "one\ntwo & three");
+        CHECK(body->GetChildPtrAt(3)->HasReferences());
+
+        Element copy = *p;
+        CHECK(copy.HasReferences());
+        copy.SetText("no references");
+        CHECK(!copy.HasReferences());
+    }
+}
+
+int main()
+{
+    TestMovedElementHasNoParent();
+    TestAddChildKeepsParents();
+    TestCopiesOutliveArena();
+    TestDecodedTextWithoutReferences();
+    return TEST_RESULT();
+}
@@ -0,0 +1,140 @@
+#include "flatdocument.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "parser.h"
+#include "test.h"
+
+using namespace idogaf;
+
+static const char* kHtml =
+    "<html lang=\"en-US\"><head><title>t</title></head>"
+    "<body id=\"main\" class=\"\">"
+    "<h1 class=\"a b\">h</h1><p class=\"a\">one</p><p id=\"x\">two</p>"
+    "<div class=\"b\" data-x=\"1\"><p>three</p><span title=\"hello world\">s"
+    "</span><p class=\"c\">four</p></div>"
+    "<ul><li>1</li><li class=\"a\">2</li><li id=\"y\">3</li></ul>"
+    "<a href=\"http://e.com\" rel=\"nofollow\">l</a><br style=\"\">"
+    "</body></html>";
+
+static const char* kQueries[] =
+{
+    "p", "div p", "body > p", "div > *", "*", "", "p,", "div, .a",
+    "h1 + p", "p + p", "li + li", "p ~ div", "li ~ li", "p ~ p",
+    "li ~ li + li", ".a", ".b", ".a.b", "h1.a", ".*", "#x", "#*", "#main li",
+    "[class]", "[style]", "[id=*]", "[*=1]", "[*]", "[data-x]",
+    "[title~=world]", "[lang|=en]", "[href^=http]", "[href$=com]",
+    "[rel*=follow]", "[class=\"a b\"]", "ul li:first-child", "[title",
+    "div >", "body p ~ p", "p ~ h1 + p", "html", "HTML"
+};
+
+typedef std::map<Element*, unsigned int> IndexMap;
+
+static void IndexElements(Element* element, IndexMap& indices)
+{
+    unsigned int index = static_cast<unsigned int>(indices.size());
+    indices[element] = index;
+    for(size_t i = 0; i < element->GetChildrenCount(); i++)
+        IndexElements(element->GetChildPtrAt(i), indices);
+}
+
+static void TestFindMatchesSearch()
+{
+    Parser parser;
+    parser.Silent(true);
+    CHECK(parser.Parse(kHtml, strlen(kHtml)));
+    FlatDocument flat;
+    CHECK(parser.Parse(kHtml, strlen(kHtml), flat));
+    Element* root = parser.GetDocumentPtr()->GetRootPtr();
+    IndexMap indices;
+    IndexElements(root, indices);
+    CHECK(indices.size() == flat.GetSize());
+
+    //Search from every element, not just from the root
+    for(IndexMap::iterator scope = indices.begin(); scope != indices.end();
+        ++scope)
+    {
+        Element* element = scope->first;
+        FlatElement flatElement = flat.GetElement(scope->second);
+        CHECK(element->GetName() == flatElement.GetName());
+        for(size_t i = 0; i < sizeof(kQueries) / sizeof(kQueries[0]); i++)
+        {
+            std::vector<unsigned int> expected, found;
+            Vector_P elements = element->FindPtr(kQueries[i]);
+            for(size_t j = 0; j < elements.size(); j++)
+                expected.push_back(indices[elements[j]]);
+            std::sort(expected.begin(), expected.end());
+            Vector_F flatElements = flatElement.Find(kQueries[i]);
+            for(size_t j = 0; j < flatElements.size(); j++)
+                found.push_back(flatElements[j].GetIndex());
+            if(found != expected)
+                std::cerr << "\"" << kQueries[i] << "\" from "
+                          << scope->second << std::endl;
+            CHECK(found == expected);
+        }
+    }
+}
+
+static void TestWriteMatchesParser()
+{
+    const char* documents[] =
+    {
+        kHtml,
+        "<!DOCTYPE html><html><head><meta charset=\"utf-8\">"
+        "<link rel=\"stylesheet\" href=\"a.css\"><script></script>"
+        "<script>var a = 1;\nvar b = 2;</script></head>"
+        "<body class=\"x\" title=\"a\" id=\"b\" title=\"c\" class=\"\">"
+        "text<div>\n  lines\n  of text\n</div><p>before<b>bold</b>after</p>"
+        "<img src=\"i.png\" alt=\"\"><div style=\"color: red; margin:0\">"
+        "</div></body></html>",
+        "<p>only text</p>"
+    };
+    for(size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); i++)
+    {
+        Parser parser;
+        parser.Silent(true);
+        CHECK(parser.Parse(documents[i], strlen(documents[i])));
+        FlatDocument flat;
+        CHECK(parser.Parse(documents[i], strlen(documents[i]), flat));
+        std::ostringstream expected, written;
+        CHECK(parser.WriteToStream(expected));
+        CHECK(flat.WriteToStream(written));
+        if(written.str() != expected.str())
+            std::cerr << expected.str() << "\nvs\n" << written.str() << std::endl;
+        CHECK(written.str() == expected.str());
+    }
+}
+
+static void TestDecodedTextWithoutReferences()
+{
+    const char* html = "<html><body><p>x &lt; y</p><div>plain text</div>"
+                       "<b>one<!--c-->two &amp; three</b></body></html>";
+    Parser parser;
+    FlatDocument flat;
+    CHECK(parser.Parse(html, strlen(html), flat));
+    std::string buffer;
+    FlatElement p = flat.GetElement(2);
+    CHECK(p.HasReferences());
+    CHECK(p.GetDecodedText() == "x < y");
+    CHECK(p.GetDecodedText(buffer) == "x < y");
+    FlatElement div = flat.GetElement(3);
+    buffer.clear();
+    CHECK(!div.HasReferences());
+    CHECK(div.GetDecodedText(buffer).begin() == div.GetTextSpan().begin());
+    CHECK(buffer.empty());
+    CHECK(flat.GetElement(4).HasReferences());
+    CHECK(flat.GetElement(4).GetDecodedText() == "one\ntwo & three");
+}
+
+int main()
+{
+    TestFindMatchesSearch();
+    TestWriteMatchesParser();
+    TestDecodedTextWithoutReferences();
+    return TEST_RESULT();
+}
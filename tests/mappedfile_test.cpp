@@ -0,0 +1,68 @@
+#include "mappedfile.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#if defined(__unix__) || defined(__APPLE__)
+#define IDOGAF_HAVE_PIPE
+#include <unistd.h>
+#endif
+
+#include "test.h"
+
+using namespace idogaf;
+
+static const char* kHtml = "<html><body><p>text</p></body></html>";
+
+static bool WriteFile(const std::string& filename, const std::string& contents)
+{
+    FILE* file = fopen(filename.c_str(), "wb");
+    if(file == nullptr) return false;
+    bool written = fwrite(contents.data(), 1, contents.size(), file)
+                   == contents.size();
+    return fclose(file) == 0 && written;
+}
+
+static void TestRegularFile()
+{
+    const std::string filename = "mappedfile_test.html";
+    CHECK(WriteFile(filename, kHtml));
+    MappedFile file;
+    CHECK(file.Open(filename));
+    CHECK(file.IsOpen());
+    CHECK(std::string(file.GetData(), file.GetSize()) == kHtml);
+    CHECK(WriteFile(filename, ""));
+    CHECK(file.Open(filename));
+    CHECK(file.GetSize() == 0 && file.GetData() == nullptr);
+    remove(filename.c_str());
+    CHECK(!file.Open(filename));
+    CHECK(!file.IsOpen());
+}
+
+#ifdef IDOGAF_HAVE_PIPE
+static void TestPipe()
+{
+    //A pipe can't be mapped, its contents are read instead
+    int fds[2];
+    CHECK(pipe(fds) == 0);
+    CHECK(write(fds[1], kHtml, strlen(kHtml))
+          == static_cast<ssize_t>(strlen(kHtml)));
+    close(fds[1]);
+    MappedFile file;
+    CHECK(file.Open("/dev/fd/" + std::to_string(fds[0])));
+    close(fds[0]);
+    CHECK(file.IsOpen());
+    CHECK(std::string(file.GetData(), file.GetSize()) == kHtml);
+    file.Close();
+    CHECK(!file.IsOpen() && file.GetSize() == 0);
+}
+#endif
+
+int main()
+{
+    TestRegularFile();
+#ifdef IDOGAF_HAVE_PIPE
+    TestPipe();
+#endif
+    return TEST_RESULT();
+}
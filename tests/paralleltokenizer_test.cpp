@@ -0,0 +1,78 @@
+#include "paralleltokenizer.h"
+
+#include <string>
+#include <vector>
+
+#include "test.h"
+
+using namespace idogaf;
+
+static std::string MakeDocument(size_t rows)
+{
+    std::string html = "<!DOCTYPE html><html><body><table>";
+    for(size_t i = 0; i < rows; i++)
+    {
+        html += "<tr class=\"row\"><td title=\"a > b\">" + std::to_string(i);
+        html += "</td><!-- <td> --><td><script>if(a < b) x();</script></td></tr>\n";
+    }
+    return html + "</table></body></html>";
+}
+
+static std::vector<Token> Tokenize(const std::string& html)
+{
+    std::vector<Token> tokens;
+    Tokenizer tokenizer(html.data(), html.size());
+    Token token;
+    while(tokenizer.Next(token))
+        tokens.push_back(token);
+    return tokens;
+}
+
+static bool SameTokens(ParallelTokenizer& tokenizer,
+                       const std::vector<Token>& expected)
+{
+    Token token;
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+        if(!tokenizer.Next(token)) return false;
+        if(token.type != expected[i].type || token.source != expected[i].source
+           || token.offset != expected[i].offset)
+            return false;
+    }
+    return !tokenizer.Next(token);
+}
+
+static void TestSameTokensAsTokenizer()
+{
+    std::string html = MakeDocument(2000);
+    ParallelTokenizer tokenizer(html.data(), html.size(), 4);
+    tokenizer.SetChunkSize(1000);
+    CHECK(SameTokens(tokenizer, Tokenize(html)));
+}
+
+static void TestThreadsKeptBetweenInputs()
+{
+    std::string first = MakeDocument(1500), second = MakeDocument(700);
+    std::vector<Token> firstTokens = Tokenize(first);
+    ParallelTokenizer tokenizer(3);
+    tokenizer.SetChunkSize(777);
+    for(int i = 0; i < 3; i++)
+    {
+        tokenizer.SetInput(first.data(), first.size());
+        CHECK(SameTokens(tokenizer, firstTokens));
+        //Leave an input in the middle
+        tokenizer.SetInput(second.data(), second.size());
+        Token token;
+        for(int j = 0; j < 100; j++)
+            CHECK(tokenizer.Next(token));
+    }
+    tokenizer.SetInput(second.data(), second.size());
+    CHECK(SameTokens(tokenizer, Tokenize(second)));
+}
+
+int main()
+{
+    TestSameTokensAsTokenizer();
+    TestThreadsKeptBetweenInputs();
+    return TEST_RESULT();
+}
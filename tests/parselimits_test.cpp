@@ -0,0 +1,56 @@
+#include "parselimits.h"
+
+#include <string.h>
+#include <string>
+
+#include "charset.h"
+#include "parser.h"
+#include "test.h"
+
+using namespace idogaf;
+
+static void TestTruncateKeepsUtf8Characters()
+{
+    const std::string html = "<p>za\xC5\xBC\xC3\xB3\xC5\x82\xC4\x87 g\xC4\x99\xC5\x9Bl"
+                              "\xC4\x85 ja\xC5\xBA\xC5\x84 \xF0\x9F\x98\x80</p>";
+    for(size_t limit = 4; limit < html.size(); limit++)
+    {
+        Parser parser;
+        parser.Silent(true);
+        ParseLimits limits;
+        limits.maxInputLength = limit;
+        limits.truncate = true;
+        parser.Limits(limits);
+        CHECK(parser.Parse(html.data(), html.size()));
+        CHECK(parser.GetEncoding() == Encoding::kUtf8);
+        CHECK(parser.GetExceededLimit() == Limit::kInputLength);
+        std::string text = parser.GetDocumentPtr()->GetRootPtr()->GetText();
+        CHECK(html.compare(3, text.size(), text) == 0);
+        CHECK(Charset::FindInvalidUtf8(text.data(), text.data() + text.size())
+              == text.data() + text.size());
+    }
+}
+
+static void TestCharacterBoundary()
+{
+    //"a" and U+1F600 as a surrogate pair
+    const char utf16[] = "a\0\x3D\xD8\x00\xDE";
+    CHECK(Charset::FindCharacterBoundary(utf16, 6, Encoding::kUtf16Le) == 6);
+    CHECK(Charset::FindCharacterBoundary(utf16, 5, Encoding::kUtf16Le) == 2);
+    CHECK(Charset::FindCharacterBoundary(utf16, 4, Encoding::kUtf16Le) == 2);
+    //Second byte of the first character looks like a lead byte
+    const char shiftJis[] = "\x82\x9F\x82\xA0";
+    CHECK(Charset::FindCharacterBoundary(shiftJis, 4, Encoding::kShiftJis) == 4);
+    CHECK(Charset::FindCharacterBoundary(shiftJis, 3, Encoding::kShiftJis) == 2);
+    CHECK(Charset::FindCharacterBoundary(shiftJis, 2, Encoding::kShiftJis) == 2);
+    const char windows1252[] = "caf\xE9";
+    CHECK(Charset::FindCharacterBoundary(windows1252, 4, Encoding::kWindows1252)
+          == 4);
+}
+
+int main()
+{
+    TestTruncateKeepsUtf8Characters();
+    TestCharacterBoundary();
+    return TEST_RESULT();
+}
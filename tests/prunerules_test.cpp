@@ -0,0 +1,111 @@
+#include "selectorrule.h"
+
+#include <algorithm>
+#include <string.h>
+#include <string>
+
+#include "parser.h"
+#include "pushparser.h"
+#include "test.h"
+
+using namespace idogaf;
+
+static size_t Count(Parser& parser, const std::string& query)
+{
+    return parser.GetDocumentPtr()->GetRoot().Find(query).size();
+}
+
+static bool Parse(Parser& parser, const char* html)
+{
+    return parser.Parse(html, strlen(html));
+}
+
+static void TestPrunedSubtreesAreLeftOut()
+{
+    Parser parser;
+    parser.Silent(true);
+    CHECK(parser.AddPruneRule("svg"));
+    CHECK(parser.AddPruneRule(".ad"));
+    CHECK(parser.AddPruneRule("[aria-hidden=true]"));
+    CHECK(Parse(parser, "<html><body><p>a<svg><g><text>x</text></g></svg>b</p>"
+                        "<div class=\"x ad\"><div><p>y</p></div><div></div>"
+                        "</div><p aria-hidden=\"true\">z</p>"
+                        "<p aria-hidden=\"false\">c</p></body></html>"));
+    CHECK(Count(parser, "svg") == 0 && Count(parser, "text") == 0);
+    CHECK(Count(parser, "div") == 0);
+    CHECK(Count(parser, "p") == 2);
+    CHECK(parser.GetDocumentPtr()->GetRoot().Find("p")[0].GetText() == "ab");
+    CHECK(Count(parser, "[aria-hidden=false]") == 1);
+    //Rules stay for the next parse
+    CHECK(Parse(parser, "<html><body><svg></svg><p>d</p></body></html>"));
+    CHECK(Count(parser, "svg") == 0 && Count(parser, "p") == 1);
+    parser.ClearPruneRules();
+    CHECK(Parse(parser, "<html><body><svg></svg><p>d</p></body></html>"));
+    CHECK(Count(parser, "svg") == 1);
+}
+
+static void TestPrunedSubtreeEnds()
+{
+    Parser parser;
+    parser.Silent(true);
+    CHECK(parser.AddPruneRule("svg"));
+    CHECK(parser.AddPruneRule("img"));
+    CHECK(parser.AddPruneRule("script"));
+    //Empty and void elements end right away
+    CHECK(Parse(parser, "<html><body><svg/><img src=\"a\"><p>a</p>"
+                        "</body></html>"));
+    CHECK(Count(parser, "p") == 1);
+    //Raw text of a pruned element is not looked into
+    CHECK(Parse(parser, "<html><body><script>\"</body>\"</script><p>a</p>"
+                        "</body></html>"));
+    CHECK(Count(parser, "p") == 1);
+    //A closing tag of an open element ends the pruned one too
+    CHECK(Parse(parser, "<html><body><div><svg><g></div><p>a</p>"
+                        "</body></html>"));
+    CHECK(Count(parser, "body > p") == 1);
+    CHECK(Count(parser, "svg") == 0);
+    //The root element is never pruned
+    Parser rootParser;
+    CHECK(rootParser.AddPruneRule("html"));
+    CHECK(Parse(rootParser, "<html><body><p>a</p></body></html>"));
+    CHECK(Count(rootParser, "p") == 1);
+}
+
+static void TestUnsupportedSelectors()
+{
+    Parser parser;
+    CHECK(!parser.AddPruneRule(""));
+    CHECK(!parser.AddPruneRule("div p"));
+    CHECK(!parser.AddPruneRule("div > p"));
+    CHECK(!parser.AddPruneRule("[title"));
+    CHECK(parser.GetPruneRules().empty());
+    CHECK(parser.AddPruneRule("div#banner.ad[data-x^=a]"));
+    CHECK(parser.GetPruneRules().size() == 1);
+}
+
+static void TestPruneInPushParser()
+{
+    const std::string html = "<html><body><div class=\"ad\"><p>x</p><div>"
+                             "</div></div><p>a</p></body></html>";
+    for(size_t part = 1; part < 8; part++)
+    {
+        PushParser parser;
+        CHECK(parser.AddPruneRule(".ad"));
+        for(size_t i = 0; i < html.size(); i += part)
+            CHECK(parser.Feed(html.data() + i,
+                              std::min(part, html.size() - i)));
+        CHECK(parser.Finish());
+        Vector_E found = parser.GetDocumentPtr()->GetRoot().Find("p");
+        CHECK(found.size() == 1 && found[0].GetText() == "a");
+        CHECK(parser.GetDocumentPtr()->GetRoot().Find("div").empty());
+    }
+}
+
+int main()
+{
+    TestPrunedSubtreesAreLeftOut();
+    TestPrunedSubtreeEnds();
+    TestUnsupportedSelectors();
+    TestPruneInPushParser();
+    return TEST_RESULT();
+}
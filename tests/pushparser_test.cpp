@@ -0,0 +1,152 @@
+#include "pushparser.h"
+
+#include <string>
+
+#include "decompressor.h"
+#include "parser.h"
+#include "test.h"
+
+using namespace idogaf;
+
+static std::string CollectText(Element& element)
+{
+    std::string text = element.GetText();
+    for(size_t i = 0; i < element.GetChildrenCount(); i++)
+        text += CollectText(*element.GetChildPtrAt(i));
+    return text;
+}
+
+static std::string ParseWhole(const std::string& html, Encoding& encodingOut)
+{
+    Parser parser;
+    parser.Silent(true);
+    if(!parser.Parse(html.data(), html.size())) return "(failed)";
+    encodingOut = parser.GetEncoding();
+    return CollectText(*parser.GetDocumentPtr()->GetRootPtr());
+}
+
+static std::string ParsePushed(const std::string& html, size_t partSize,
+                               Encoding& encodingOut)
+{
+    PushParser parser;
+    parser.Silent(true);
+    for(size_t i = 0; i < html.size(); i += partSize)
+        if(!parser.Feed(html.data() + i, html.size() - i < partSize
+                                         ? html.size() - i : partSize))
+            return "(failed)";
+    if(!parser.Finish()) return "(failed)";
+    encodingOut = parser.GetEncoding();
+    return CollectText(*parser.GetDocumentPtr()->GetRootPtr());
+}
+
+static void CheckSameAsParser(const std::string& html, Encoding expected)
+{
+    Encoding encoding = Encoding::kUnknown;
+    std::string text = ParseWhole(html, encoding);
+    CHECK(encoding == expected);
+    CHECK(!text.empty() && text != "(failed)");
+    for(size_t partSize = 1; partSize <= 2048; partSize = 2 * partSize + 1)
+    {
+        Encoding pushedEncoding = Encoding::kUnknown;
+        CHECK(ParsePushed(html, partSize, pushedEncoding) == text);
+        CHECK(pushedEncoding == expected);
+    }
+}
+
+static std::string Padding()
+{
+    //Moves the interesting part past the sniffed beginning
+    return "<!--" + std::string(1500, '-') + "-->";
+}
+
+static void TestWindows1252()
+{
+    //No declaration, not valid UTF-8
+    CheckSameAsParser("<p>caf\xE9 \x80 na\xEFve</p>", Encoding::kWindows1252);
+    CheckSameAsParser("<p>caf\xE9" + Padding() + " na\xEFve</p>",
+                      Encoding::kWindows1252);
+}
+
+static void TestShiftJis()
+{
+    std::string html = "<html><head><meta charset=\"shift_jis\"></head><body>"
+                       "\x93\xFA\x96\x7B\x8C\xEA" + Padding()
+                       + "\x82\xA0\x82\xA2\x82\xA4</body></html>";
+    CheckSameAsParser(html, Encoding::kShiftJis);
+}
+
+static void TestUtf16()
+{
+    std::string ascii = "<p>a\xC4\x85" + Padding() + "b</p>";
+    std::string html("\xFF\xFE", 2);
+    for(size_t i = 0; i < ascii.size(); i++)
+    {
+        if(ascii[i] == '\xC4')   //U+0105, then U+1F600 as a surrogate pair
+        {
+            html.append("\x05\x01\x3D\xD8\x00\xDE", 6);
+            i++;
+            continue;
+        }
+        html += ascii[i];
+        html += '\0';
+    }
+    CheckSameAsParser(html, Encoding::kUtf16Le);
+}
+
+static void TestUtf8()
+{
+    CheckSameAsParser("\xEF\xBB\xBF<p>za\xC5\xBC\xC3\xB3\xC5\x82\xC4\x87" + Padding()
+                      + "\xF0\x9F\x98\x80</p>", Encoding::kUtf8);
+}
+
+static void TestDecompressorTranscodes()
+{
+    std::string html = "<p>caf\xE9" + Padding() + " na\xEFve</p>";
+    Encoding encoding = Encoding::kUnknown;
+    std::string text = ParseWhole(html, encoding);
+    PushParser parser;
+    Decompressor decompressor;
+    CHECK(decompressor.Parse(html.data(), html.size(), parser));
+    CHECK(parser.GetEncoding() == Encoding::kWindows1252);
+    CHECK(CollectText(*parser.GetDocumentPtr()->GetRootPtr()) == text);
+}
+
+static void TestRawTextEndSplitAcrossParts()
+{
+    const std::string html = "<html><head><script>if(a<b && c</d) f(\"</scrip"
+                             "\");</script><style>p{}</STYLE></head><body>"
+                             "<p>after</p></body></html>";
+    const std::string script = "if(a<b && c</d) f(\"</scrip\");";
+    size_t end = html.find("</script>");
+    //Cut anywhere around the closing tags, twice
+    for(size_t first = end - 8; first < html.find("<body>"); first++)
+    {
+        for(size_t second = first; second <= first + 10; second++)
+        {
+            PushParser parser;
+            parser.Silent(true);
+            CHECK(parser.Feed(html.data(), first));
+            CHECK(parser.Feed(html.data() + first, second - first));
+            CHECK(parser.Feed(html.data() + second, html.size() - second));
+            CHECK(parser.Finish());
+            Element& root = *parser.GetDocumentPtr()->GetRootPtr();
+            Vector_E scripts = root.Find("script");
+            CHECK(scripts.size() == 1 && scripts[0].GetText() == script);
+            Vector_E styles = root.Find("style");
+            CHECK(styles.size() == 1 && styles[0].GetText() == "p{}");
+            Vector_E paragraphs = root.Find("body p");
+            CHECK(paragraphs.size() == 1 && paragraphs[0].GetText() == "after");
+        }
+    }
+}
+
+int main()
+{
+    TestWindows1252();
+    TestShiftJis();
+    TestUtf16();
+    TestUtf8();
+    TestDecompressorTranscodes();
+    TestRawTextEndSplitAcrossParts();
+    return TEST_RESULT();
+}
@@ -0,0 +1,100 @@
+#include "treebuilder.h"
+
+#include <string.h>
+#include <string>
+
+#include "parser.h"
+#include "test.h"
+
+using namespace idogaf;
+
+static size_t Count(Parser& parser, const std::string& query)
+{
+    return parser.GetDocumentPtr()->GetRoot().Find(query).size();
+}
+
+static bool Parse(Parser& parser, const std::string& html)
+{
+    return parser.Parse(html.data(), html.size());
+}
+
+static void TestStopAfterCount()
+{
+    const std::string html = "<html><body><a href=\"1\">1</a><a>x</a>"
+                             "<a href=\"2\">2</a><p>after</p>"
+                             "<a href=\"3\">3</a></body></html>";
+    Parser parser;
+    CHECK(parser.StopAfter("a[href]", 2));
+    CHECK(Parse(parser, html));
+    CHECK(parser.Stopped());
+    CHECK(parser.GetStopOffset() == html.find("<p>after"));
+    CHECK(Count(parser, "a") == 3);
+    CHECK(Count(parser, "p") == 0);
+    //Open elements are closed at the stop offset
+    CHECK(Count(parser, "body") == 1);
+    CHECK(parser.GetDocumentPtr()->GetRoot().GetSourceEnd()
+          == parser.GetStopOffset());
+
+    //Not enough matches, the whole document is parsed
+    parser.ClearStopConditions();
+    CHECK(parser.StopAfter("a[href]", 4));
+    CHECK(Parse(parser, html));
+    CHECK(!parser.Stopped());
+    CHECK(parser.GetStopOffset() == 0);
+    CHECK(Count(parser, "a") == 4 && Count(parser, "p") == 1);
+}
+
+static void TestStopAfterHead()
+{
+    const std::string html = "<!DOCTYPE html><html><head><title>t</title>"
+                             "<meta charset=\"utf-8\"></head><body><p>a</p>"
+                             "</body></html>";
+    Parser parser;
+    CHECK(parser.StopAfter("head"));
+    CHECK(Parse(parser, html));
+    CHECK(parser.Stopped());
+    CHECK(parser.GetStopOffset() == html.find("<body>"));
+    CHECK(Count(parser, "title") == 1 && Count(parser, "body") == 0);
+    //Void elements are done at their start tags
+    parser.ClearStopConditions();
+    CHECK(parser.StopAfter("meta"));
+    CHECK(Parse(parser, html));
+    CHECK(parser.GetStopOffset() == html.find("</head>"));
+}
+
+static void TestAllConditionsHaveToBeMet()
+{
+    const std::string html = "<html><body><p>1</p><h1>t</h1><p>2</p><p>3</p>"
+                             "<div></div></body></html>";
+    Parser parser;
+    CHECK(parser.StopAfter("p", 2));
+    CHECK(parser.StopAfter("h1"));
+    CHECK(Parse(parser, html));
+    CHECK(parser.GetStopOffset() == html.find("<p>3"));
+    CHECK(parser.StopAfter("div"));
+    CHECK(Parse(parser, html));
+    CHECK(parser.GetStopOffset() == html.find("</body>"));
+    CHECK(Count(parser, "p") == 3);
+}
+
+static void TestRejectedConditions()
+{
+    Parser parser;
+    CHECK(!parser.StopAfter("p", 0));
+    CHECK(!parser.StopAfter("div p"));
+    CHECK(!parser.StopAfter(""));
+    for(size_t i = 0; i < TreeBuilder::kMaxStopConditions; i++)
+        CHECK(parser.StopAfter("p"));
+    CHECK(!parser.StopAfter("p"));
+    parser.ClearStopConditions();
+    CHECK(parser.StopAfter("p"));
+}
+
+int main()
+{
+    TestStopAfterCount();
+    TestStopAfterHead();
+    TestAllConditionsHaveToBeMet();
+    TestRejectedConditions();
+    return TEST_RESULT();
+}
@@ -0,0 +1,29 @@
+/** Copyright (c) 2020 Tomasz Rusinowicz
+*/
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <iostream>
+
+/** Minimal checks for the test programs
+
+    Every test is a program returning non-zero if any CHECK failed.
+*/
+static int testFailures = 0;
+
+#define CHECK(condition)                                                  \
+    do                                                                    \
+    {                                                                     \
+        if(!(condition))                                                  \
+        {                                                                 \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK("        \
+                      << #condition << ") failed" << std::endl;           \
+            ++testFailures;                                               \
+        }                                                                 \
+    }                                                                     \
+    while(0)
+
+#define TEST_RESULT() (testFailures == 0 ? 0 : 1)
+
+#endif // TEST_H
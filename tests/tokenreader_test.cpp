@@ -0,0 +1,62 @@
+#include "tokenreader.h"
+
+#include <string.h>
+
+#include "test.h"
+
+using namespace idogaf;
+
+static bool NextStartTag(TokenReader& reader, const char* name)
+{
+    while(reader.Next())
+        if(reader.GetType() == TokenType::kStartTag
+           && reader.GetName() == StringView(name, strlen(name)))
+            return true;
+    return false;
+}
+
+static void TestSkipSubtreeMatchesCase()
+{
+    //Only </DIV> closes <DIV>, like in the tree builder
+    const char* html = "<DIV><div>x</div></Div><p>a</p></DIV><p>after</p>";
+    TokenReader reader(html, strlen(html));
+    CHECK(NextStartTag(reader, "DIV"));
+    CHECK(reader.SkipSubtree());
+    CHECK(reader.GetType() == TokenType::kEndTag);
+    CHECK(reader.GetName() == StringView("DIV", 3));
+    CHECK(NextStartTag(reader, "p"));
+    CHECK(reader.Next());
+    CHECK(reader.GetText() == StringView("after", 5));
+
+    const char* lower = "<div><DIV></DIV><div></div></div><b>after</b>";
+    TokenReader lowerReader(lower, strlen(lower));
+    CHECK(NextStartTag(lowerReader, "div"));
+    CHECK(lowerReader.SkipSubtree());
+    CHECK(lowerReader.GetToken().offset == strlen(lower) - 18);
+}
+
+static void TestSkipSubtreeBalancesNested()
+{
+    const char* html = "<ul><li><ul><li>a</li></ul></li></ul><b>after</b>";
+    TokenReader reader(html, strlen(html));
+    CHECK(NextStartTag(reader, "ul"));
+    CHECK(reader.SkipSubtree());
+    CHECK(reader.Next());
+    CHECK(reader.GetName() == StringView("b", 1));
+}
+
+static void TestSkipSubtreeWithoutEndTag()
+{
+    const char* html = "<ul><li>a<li>b</ul>";
+    TokenReader reader(html, strlen(html));
+    CHECK(NextStartTag(reader, "li"));
+    CHECK(!reader.SkipSubtree());
+}
+
+int main()
+{
+    TestSkipSubtreeMatchesCase();
+    TestSkipSubtreeBalancesNested();
+    TestSkipSubtreeWithoutEndTag();
+    return TEST_RESULT();
+}